@@ -35,17 +35,21 @@
 #include "apl/component/textmeasurement.h"
 #include "apl/content/configurationchange.h"
 #include "apl/content/content.h"
+#include "apl/content/contentstream.h"
 #include "apl/content/importref.h"
 #include "apl/content/importrequest.h"
 #include "apl/content/jsondata.h"
 #include "apl/content/metrics.h"
 #include "apl/content/package.h"
+#include "apl/content/packagecache.h"
 #include "apl/content/packagemanager.h"
+#include "apl/content/packedjson.h"
 #include "apl/content/rootconfig.h"
 #include "apl/content/sharedjsondata.h"
 #include "apl/datasource/datasourceconnection.h"
 #include "apl/datasource/datasourceprovider.h"
 #include "apl/document/documentcontext.h"
+#include "apl/document/visualcontextdelta.h"
 #include "apl/embed/documentmanager.h"
 #include "apl/embed/embedrequest.h"
 #include "apl/engine/event.h"
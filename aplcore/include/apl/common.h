@@ -96,6 +96,7 @@ class MediaObject;
 class MediaPlayer;
 class MediaPlayerFactory;
 class Package;
+class PackageCache;
 class PackageManager;
 class PackageResolver;
 class PendingImportPackage;
@@ -154,6 +155,7 @@ using MediaObjectPtr = std::shared_ptr<MediaObject>;
 using MediaPlayerFactoryPtr = std::shared_ptr<MediaPlayerFactory>;
 using MediaPlayerPtr = std::shared_ptr<MediaPlayer>;
 using PackagePtr = std::shared_ptr<Package>;
+using PackageCachePtr = std::shared_ptr<PackageCache>;
 using PackageManagerPtr = std::shared_ptr<PackageManager>;
 using PackageResolverPtr = std::shared_ptr<PackageResolver>;
 using PendingImportPackagePtr = std::shared_ptr<PendingImportPackage>;
@@ -660,6 +660,8 @@ enum PropertyKey {
     kPropertyPreserve,
     /// TextComponent range for karaoke target
     kPropertyRangeKaraokeTarget,
+    /// SequenceComponent, GridSequenceComponent and PagerComponent reuse of children removed from a LiveArray
+    kPropertyRecycleItems,
     /// The unique identifier of the resource associated with extension component
     kPropertyResourceId,
     // ExtensionComponent handler on error
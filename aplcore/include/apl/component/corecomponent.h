@@ -16,7 +16,9 @@
 #ifndef _APL_CORE_COMPONENT_H
 #define _APL_CORE_COMPONENT_H
 
+#include <bitset>
 #include <climits>
+#include <set>
 #include <stack>
 
 #include "apl/apl_config.h"
@@ -31,6 +33,7 @@
 #include "apl/primitives/size.h"
 #include "apl/primitives/transform2d.h"
 #include "apl/utils/flags.h"
+#include "apl/utils/spatialindex.h"
 #include "apl/yoga/yoganode.h"
 
 #ifdef SCENEGRAPH
@@ -48,6 +51,32 @@ class StickyChildrenTree;
 
 using ConstComponentPropIterator = std::map<PropertyKey, ComponentPropDef>::const_iterator;
 
+// Number of PropertyKey values.  kPropertyWrap must remain the last entry in PropertyKey.
+const size_t kPropertyKeyCount = kPropertyWrap + 1;
+
+/**
+ * The set of property keys that have been assigned on a component.  Built-in keys are held in a
+ * bitset.  Extension components register property keys beyond the end of PropertyKey; those are
+ * rare and are held in a separate set.
+ */
+class AssignedPropertySet {
+public:
+    bool test(PropertyKey key) const {
+        return static_cast<size_t>(key) < kPropertyKeyCount ? mBuiltIn.test(key) : mExtended.count(key) != 0;
+    }
+
+    void set(PropertyKey key) {
+        if (static_cast<size_t>(key) < kPropertyKeyCount)
+            mBuiltIn.set(key);
+        else
+            mExtended.emplace(key);
+    }
+
+private:
+    std::bitset<kPropertyKeyCount> mBuiltIn;
+    std::set<PropertyKey> mExtended;
+};
+
 extern const std::string VISUAL_CONTEXT_TYPE_MIXED;
 extern const std::string VISUAL_CONTEXT_TYPE_GRAPHIC;
 extern const std::string VISUAL_CONTEXT_TYPE_TEXT;
@@ -200,6 +229,12 @@ public:
      */
     bool isDisplayedChild(const CoreComponent& child) const;
 
+    /**
+     * Mark the bounding boxes of the children as stale.  Layout changes call this automatically;
+     * call it when the bounds or transform of a child are changed outside of the layout pass.
+     */
+    void markChildIndexStale() { if (mChildIndex) mChildIndex->boxesStale = true; }
+
     /// Component overrides
     size_t getDisplayedChildCount() const override;
     ComponentPtr getDisplayedChildAt(size_t drawIndex) const override;
@@ -246,7 +281,7 @@ public:
      * @param key The property key to inspect.
      * @return True if this property key has an assigned value.
      */
-    bool hasProperty(PropertyKey key) const { return mAssigned.count(key) != 0; }
+    bool hasProperty(PropertyKey key) const { return mAssigned.test(key); }
 
     /**
      * Return the value and writeable state of a component property.  This is the opposite of the
@@ -480,6 +515,16 @@ public:
      */
      bool isVisualContextDirty();
 
+    /**
+     * Internal method.  Retrieve the visual context of the document that this component is the top
+     * of.  When RootConfig::kExperimentalFeatureVisualContextCache is enabled the subtrees that have
+     * not changed since the previous call are copied from a cache instead of being rebuilt.  The
+     * caller is responsible for clearing the dirty visual context of the document.
+     * @param allocator RapidJSON memory allocator
+     * @return The visual context.
+     */
+    rapidjson::Value serializeDocumentVisualContext(rapidjson::Document::AllocatorType& allocator);
+
     /**
      * Serialize the event portion of this component
      */
@@ -595,14 +640,17 @@ public:
     virtual void preLayoutProcessing(bool useDirtyFlag);
 
     /**
-     * Walk the hierarchy updating child boundaries.
+     * Walk the hierarchy updating child boundaries.  Attached children whose Yoga node was not
+     * visited by the layout pass are skipped; their cached layout, and hence their bounds, did
+     * not change.
      * @param useDirtyFlag true to notify runtime about changes with dirty properties
      * @param first if this is the first layout for current template, false otherwise
      */
     virtual void processLayoutChanges(bool useDirtyFlag, bool first);
 
     /**
-     * After a layout has been completed, call this to execute any actions that may occur after a layout
+     * After a layout has been completed, call this to execute any actions that may occur after a layout.
+     * Only descends into children that Yoga visited during the layout and clears their "new layout" flag.
      * @param first if this is the first layout for current template, false otherwise
      */
     virtual void postProcessLayoutChanges(bool first);
@@ -727,6 +775,13 @@ public:
      */
     virtual bool shouldBeFullyInflated(int index) const { return true; }
 
+    /**
+     * @return True if this component releases the inflated subtrees of children that are far out of
+     *         view.  Children of such a component keep their item definition so that they can be
+     *         inflated again.
+     */
+    virtual bool virtualizesChildren() const { return false; }
+
     /**
      * Checks to see if this Component inherits state from another Component. State
      * is inherited if compare Component is an ancestor, and inheritParentState = true for this Component
@@ -1097,6 +1152,18 @@ protected:
      */
     virtual void ensureDisplayedChildren();
 
+    /**
+     * Look up the children that may contain the search point of a visitor.  The index is only
+     * available when RootConfig::kExperimentalFeatureSpatialIndex is enabled and this component
+     * has enough children to make it worthwhile.
+     * @param visitor The visitor.
+     * @param point Set to the search point in the child coordinate space of this component (the
+     *              local coordinate space offset by the scroll position).
+     * @return The index of the child bounding boxes, or nullptr if the visitor has no search point
+     *         or there is no index.
+     */
+    const SpatialIndex *getChildIndexAt(const Visitor<CoreComponent>& visitor, Point& point) const;
+
     /**
      * @return True if layout change calculations should be propagated to component's children. Usually the case
      * when component itself is part of the layout tree.
@@ -1253,9 +1320,30 @@ private:
 
     virtual const ComponentPropDefSet* layoutPropDefSet() const { return nullptr; };
 
-    void serializeVisualContextInternal(
+    rapidjson::Value serializeVisualContextFromTop(rapidjson::Document::AllocatorType& allocator, bool useCache);
+
+    /**
+     * Append the visual context entries of this component to an array.  When useCache is set,
+     * reuse or refresh the cached entries.
+     * @return True if the entries of this component may be cached.
+     */
+    bool serializeVisualContextInternal(
         rapidjson::Value& outArray, rapidjson::Document::AllocatorType& allocator, float realOpacity,
-        float visibility, const Rect& visibleRect, int visualLayer);
+        float visibility, const Rect& visibleRect, int visualLayer, bool useCache);
+
+    bool serializeVisualContextEntries(
+        rapidjson::Value& outArray, rapidjson::Document::AllocatorType& allocator, float realOpacity,
+        float visibility, const Rect& visibleRect, int visualLayer, bool useCache);
+
+    /**
+     * Mark the cached visual context of this component and its ancestors as stale.
+     */
+    void markVisualContextStale();
+
+    /**
+     * Clear the stale flag of this component and its stale descendants.
+     */
+    void clearVisualContextStale();
 
     void attachRebuilder(const std::shared_ptr<LayoutRebuilder>& rebuilder) { mRebuilder = rebuilder; }
 
@@ -1303,7 +1391,7 @@ protected:
     /**
      * Various flags used by component.
      */
-    enum CoreComponentFlags : uint8_t {
+    enum CoreComponentFlags : uint16_t {
         kCoreComponentFlagInheritParentState = 1u << 0,
         kCoreComponentFlagDisplayedChildrenStale = 1u << 1,
         kCoreComponentFlagIsDisallowed = 1u << 2,
@@ -1311,12 +1399,14 @@ protected:
         kCoreComponentFlagTextMeasurementHashStale = 1u << 4,
         kCoreComponentFlagVisualHashStale = 1u << 5,
         kCoreComponentFlagAccessibilityDirty = 1u << 6,
+        kCoreComponentFlagLayoutPending = 1u << 7,  // Queued in the LayoutManager pending list
+        kCoreComponentFlagVisualContextStale = 1u << 8,  // This subtree changed since the visual context was cached
     };
 
     State                            mState;       // Operating state (pressed, checked, etc)
     std::string                      mStyle;       // Name of the current STYLE
     Properties                       mProperties;  // Assigned properties from JSON
-    std::set<PropertyKey>            mAssigned;    // Properties that have been assigned from JSON or SetValue
+    AssignedPropertySet              mAssigned;    // Properties that have been assigned from JSON or SetValue
     std::vector<CoreComponentPtr>    mChildren;    // Children of this component
     std::vector<CoreComponentPtr>    mDisplayedChildren; // ordered list of children to be drawn
     CoreComponentPtr                 mParent;
@@ -1330,6 +1420,28 @@ protected:
 #endif // SCENEGRAPH
 
 private:
+    struct ChildIndex {
+        SpatialIndex boxes;                           // Child bounding boxes in the child coordinate space
+        std::vector<const CoreComponent *> displayed; // Displayed children, sorted by address
+        std::vector<size_t> found;                    // Query results
+        bool boxesStale = true;
+        bool displayedStale = true;
+    };
+
+    ChildIndex *ensureChildIndex() const;
+
+    struct VisualContextCache {
+        // The inputs from the parent and the global position the entries were built for
+        float realOpacity;
+        float visibility;
+        Rect visibleRect;
+        int visualLayer;
+        Transform2D globalToLocal;
+        Rect bounds;
+        // The entries this component appended to the visual context of its parent
+        rapidjson::GenericValue<rapidjson::UTF8<>, rapidjson::CrtAllocator> entries;
+    };
+
     // The members below are used to store cached values for performance reasons, and not part of
     // the state of this component.
     struct ChildChange {
@@ -1347,6 +1459,8 @@ private:
     /// Permanent caches
     std::unique_ptr<WeakPtrSet<CoreComponent>> mAffectedByVisibilityChange;
     std::unique_ptr<std::map<int, ContextPtr>> mStashedRebuildCtxs;
+    std::unique_ptr<ChildIndex> mChildIndex;
+    std::unique_ptr<VisualContextCache> mVisualContextCache;
 
     /// Temporary caches
     std::unique_ptr<std::vector<ChildChange>>  mChildrenChanges;
@@ -44,6 +44,7 @@ protected:
                                bool useDirtyFlag,
                                bool first) override;
     void ensureChildAttached(const CoreComponentPtr& child, int targetIdx) override;
+    void refreshChildNode(const CoreComponentPtr& child, size_t index) override;
     const EventPropertyMap & eventPropertyMap() const override;
 
     void handlePropertyChange(const ComponentPropDef& def, const Object& value) override;
@@ -127,6 +127,7 @@ protected:
     float maxScroll() const override;
     bool shouldAttachChildYogaNode(int index) const override { return false; }
     bool shouldBeFullyInflated(int index) const override;
+    bool virtualizesChildren() const override;
     const EventPropertyMap & eventPropertyMap() const override;
     void handlePropertyChange(const ComponentPropDef& def, const Object& value) override;
     void onScrollPositionUpdated() override;
@@ -137,6 +138,14 @@ protected:
 
     virtual void ensureChildAttached(const CoreComponentPtr& child, int targetIdx);
 
+    /**
+     * Reapply the layout properties of an attached child, for example after it has been inflated again
+     * by the virtualization window.
+     * @param child The child.
+     * @param index The index of the child.
+     */
+    virtual void refreshChildNode(const CoreComponentPtr& child, size_t index);
+
 private:
     /**
      * Ensure that current state of visibility parameters properly calculated.
@@ -181,6 +190,12 @@ private:
     Point getPaddedScrollPosition(LayoutDirection layoutDirection) const;
     void processLayoutChangesInternal(bool useDirtyFlag, bool first, bool delayed, bool needsFullReProcess);
     void scheduleDelayedLayout();
+
+    /**
+     * Release the subtrees of children outside of the virtualization window around the viewport and
+     * inflate deflated children that have moved back inside it.
+     */
+    void virtualizeChildren(bool useDirtyFlag);
     double clampScrollPositionToValidValue(double scrollPosition, LayoutDirection layoutDirection, bool isHorizontal);
 
 private:
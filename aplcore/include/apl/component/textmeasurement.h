@@ -17,6 +17,7 @@
 #define _APL_TEXT_MEASUREMENT_H
 
 #include <memory>
+#include <vector>
 
 #include "apl/apl_config.h"
 #include "apl/common.h"
@@ -73,6 +74,16 @@ private:
     MeasureMode mHeightMode = Undefined;
 };
 
+/**
+ * A single text layout in a batch.  See TextMeasurement::layoutBatch.
+ */
+struct TextLayoutBatchEntry {
+    sg::TextChunkPtr chunk;
+    sg::TextPropertiesPtr textProperties;
+    MeasureRequest request;
+    sg::TextLayoutPtr layout;  // Filled in by TextMeasurement::layoutBatch
+};
+
 /**
  * Abstract class for measuring text.  Override this in your platform-specific
  * runtime and install your custom class.
@@ -115,6 +126,23 @@ public:
         return layout(chunk, textProperties, width, widthMode, height, heightMode);
     };
 
+    /**
+     * Lay out a batch of independent text requests, filling in the "layout" field of each entry.
+     * Used by the text measurement pre-pass (see RootConfig::kExperimentalFeatureTextMeasurePrePass).
+     * The entries may be processed in any order or concurrently; an implementation that spreads the
+     * work across threads must not call back into APL core while doing so.  The default implementation
+     * lays out each entry in turn on the calling thread.
+     * @param batch The entries to lay out
+     */
+    virtual void layoutBatch(std::vector<TextLayoutBatchEntry>& batch) {
+        for (auto& entry : batch) {
+            const auto& request = entry.request;
+            entry.layout = layout(entry.chunk, entry.textProperties,
+                                  request.width(), request.widthMode(),
+                                  request.height(), request.heightMode());
+        }
+    }
+
     // Viewhost to implement one of these two definitions. The method with a component pointer
     // is a temporary definition to support usage of the new TextMeasurement API before
     // implementation is fully migrated to scenegraph.
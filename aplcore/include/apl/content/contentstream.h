@@ -0,0 +1,145 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_CONTENT_STREAM_H
+#define _APL_CONTENT_STREAM_H
+
+#include <memory>
+#include <string>
+
+#include "apl/common.h"
+#include "apl/content/metrics.h"
+#include "apl/content/rootconfig.h"
+
+namespace apl {
+
+class ContentStream;
+using ContentStreamPtr = std::shared_ptr<ContentStream>;
+
+/**
+ * Incremental construction of a Content object from an APL document that arrives in pieces.
+ *
+ * The viewhost appends document bytes as they are received.  The stream tracks the top-level
+ * structure of the document as it goes and, as soon as the "import" array is complete, requests
+ * the listed packages from the PackageManager in the RootConfig.  Packages that arrive while the
+ * rest of the document is still downloading have their own imports requested in turn.  The main
+ * template, layouts and the remainder of the document are only parsed when the stream is
+ * finished.  An approximate use is (without error-checking):
+ *
+ *      auto stream = ContentStream::create(session, metrics, config);
+ *      while (auto chunk = network.read())
+ *          stream->append(chunk.data(), chunk.size());
+ *
+ *      auto content = stream->finish();
+ *      content->load(std::move(handleSuccess), std::move(handleFailure));
+ *
+ * When the Content resolves its imports, requests that were already issued by the stream are
+ * answered from the stream instead of being sent to the PackageManager a second time.
+ *
+ * Only unconditional imports of type "package" are requested early; conditional imports and
+ * "oneOf"/"allOf" groups need the document evaluation context and are resolved by the Content
+ * as usual.  If the RootConfig does not have a PackageManager the stream simply buffers the
+ * document.
+ */
+class ContentStream {
+public:
+    /**
+     * Create a stream for a root document.
+     * @param session A logging session
+     * @param metrics Viewport metrics.
+     * @param config Document config.
+     * @return The stream
+     */
+    static ContentStreamPtr create(const SessionPtr& session, const Metrics& metrics, const RootConfig& config);
+
+    /**
+     * Internal constructor. Do not call this directly.
+     */
+    ContentStream(const SessionPtr& session, const Metrics& metrics, const RootConfig& config);
+
+    /**
+     * Append the next chunk of the document.
+     * @param data Pointer to the document bytes.
+     * @param length Number of bytes.
+     * @return False if the document is already known to be malformed or the stream was finished.
+     */
+    bool append(const char *data, size_t length);
+
+    /**
+     * Append the next chunk of the document.
+     * @param data The document bytes.
+     * @return False if the document is already known to be malformed or the stream was finished.
+     */
+    bool append(const std::string& data) { return append(data.data(), data.size()); }
+
+    /**
+     * Parse the buffered document and construct the Content.  The stream may not be appended to
+     * after this call.
+     * @return A pointer to the content or nullptr if the document is invalid.
+     */
+    ContentPtr finish();
+
+    /**
+     * @return True if the top-level structure of the document seen so far is malformed.
+     */
+    bool isError() const { return mState == State::ERROR; }
+
+    /**
+     * @return True once the closing brace of the document has been received.
+     */
+    bool isComplete() const { return mState == State::COMPLETE; }
+
+    /**
+     * @return The number of package requests sent to the PackageManager before the
+     *         document was finished.
+     */
+    size_t getEarlyRequestCount() const;
+
+private:
+    class PrefetchPackageManager;
+
+    enum class State {
+        SCANNING,
+        COMPLETE,
+        FINISHED,
+        ERROR
+    };
+
+    void scan(size_t from);
+    void memberComplete(size_t end);
+
+private:
+    SessionPtr mSession;
+    Metrics mMetrics;
+    RootConfig mConfig;
+    std::shared_ptr<PrefetchPackageManager> mPrefetch;
+
+    std::string mBuffer;
+    State mState = State::SCANNING;
+    size_t mEarlyRequestCount = 0;
+
+    // Top-level scanner state
+    int mDepth = 0;
+    bool mInString = false;
+    bool mEscape = false;
+    bool mExpectKey = false;
+    size_t mKeyStart = 0;
+    size_t mValueStart = 0;
+    std::string mCurrentKey;
+};
+
+} // namespace apl
+
+#endif // _APL_CONTENT_STREAM_H
@@ -0,0 +1,158 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_PACKAGE_CACHE_H
+#define _APL_PACKAGE_CACHE_H
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "apl/common.h"
+#include "apl/content/importref.h"
+
+namespace apl {
+
+/**
+ * A size-bounded cache of resolved packages that may be shared between documents.
+ *
+ * Without a cache every Content (including the Content of each embedded document) asks the
+ * PackageManager for its imports and builds a new Package from the returned JSON.  When the
+ * same PackageCache is set on the RootConfig of several documents, a package that has been
+ * loaded once is handed directly to later documents that import the same name, version,
+ * source and domain.  The PackageManager is not called for those packages.
+ *
+ * Packages are immutable once created, so a single Package may be used by any number of
+ * documents at the same time.  The cache is safe to use from multiple threads.  When the
+ * estimated size of the cached packages exceeds the budget, the least recently used
+ * packages are dropped from the cache; documents that still hold them are not affected.
+ *
+ *     auto cache = PackageCache::create(8 * 1024 * 1024);
+ *     rootConfig.packageManager(packageManager).packageCache(cache);
+ */
+class PackageCache {
+public:
+    /// Default size budget in bytes
+    static const size_t DEFAULT_MAX_BYTES = 16 * 1024 * 1024;
+
+    /**
+     * Cache usage counters
+     */
+    struct Stats {
+        /// Number of lookups that returned a package
+        size_t hits = 0;
+        /// Number of lookups that did not find a package
+        size_t misses = 0;
+        /// Number of packages added to the cache
+        size_t insertions = 0;
+        /// Number of packages dropped to stay within the size budget
+        size_t evictions = 0;
+        /// Number of packages currently held
+        size_t count = 0;
+        /// Estimated size of the packages currently held, in bytes
+        size_t bytes = 0;
+
+        /**
+         * @return The fraction of lookups that returned a package, or 0 if there were no lookups.
+         */
+        double hitRate() const {
+            return hits + misses > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0;
+        }
+    };
+
+    /**
+     * Create a package cache.
+     * @param maxBytes The size budget in bytes.
+     * @return The package cache.
+     */
+    static PackageCachePtr create(size_t maxBytes = DEFAULT_MAX_BYTES) {
+        return std::make_shared<PackageCache>(maxBytes);
+    }
+
+    /**
+     * Do not call this directly. Use create(size_t) instead.
+     * @param maxBytes The size budget in bytes.
+     */
+    explicit PackageCache(size_t maxBytes) : mMaxBytes(maxBytes) {}
+
+    /**
+     * Look up a package.  A successful lookup marks the package as recently used.
+     * @param ref The import reference.
+     * @return The cached package or nullptr if it is not in the cache.
+     */
+    PackagePtr find(const ImportRef& ref);
+
+    /**
+     * Add a package, replacing any package already cached for the same reference.  Packages
+     * larger than the size budget are not cached.
+     * @param ref The import reference the package was loaded for.
+     * @param package The package.
+     */
+    void insert(const ImportRef& ref, const PackagePtr& package);
+
+    /**
+     * Remove a single package from the cache.
+     * @param ref The import reference.
+     * @return True if the package was in the cache.
+     */
+    bool remove(const ImportRef& ref);
+
+    /**
+     * Remove all packages from the cache.  The usage counters are not reset.
+     */
+    void clear();
+
+    /**
+     * @return A snapshot of the usage counters.
+     */
+    Stats getStats() const;
+
+    /**
+     * @return The size budget in bytes.
+     */
+    size_t getMaxBytes() const { return mMaxBytes; }
+
+    /**
+     * Estimate the memory held by a package.
+     * @param package The package.
+     * @return The approximate number of bytes.
+     */
+    static size_t estimateSize(const Package& package);
+
+private:
+    struct Entry {
+        std::string key;
+        PackagePtr package;
+        size_t bytes;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    static std::string makeKey(const ImportRef& ref);
+    void evict(size_t maxBytes);
+
+private:
+    const size_t mMaxBytes;
+    mutable std::mutex mMutex;
+    EntryList mEntries;  // Most recently used first
+    std::map<std::string, EntryList::iterator> mIndex;
+    Stats mStats;
+};
+
+} // namespace apl
+
+#endif // _APL_PACKAGE_CACHE_H
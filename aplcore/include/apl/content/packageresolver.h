@@ -44,20 +44,26 @@ public:
      * Creates a PackageResolver for resolving all the imports from a root Package.
      * @param packageManager the package manager for retrieving requested imports.
      * @param session  the session for error logging.
+     * @param packageCache optional cache consulted before the package manager.
      * @return a pointer to a PackageResolver
      */
     static PackageResolverPtr create(const PackageManagerPtr& packageManager,
-                                     const SessionPtr& session)
+                                     const SessionPtr& session,
+                                     const PackageCachePtr& packageCache = nullptr)
     {
-        return std::make_shared<PackageResolver>(packageManager, session);
+        return std::make_shared<PackageResolver>(packageManager, session, packageCache);
     }
 
     /**
      * Do not call this directly. Instead use create(const PackageManagerPtr& packageManager, const SessionPtr& session).
      * @param packageManager the package manager for retrieving requested imports.
      * @param session  the session for error logging.
+     * @param packageCache optional cache consulted before the package manager.
      */
-    PackageResolver(const PackageManagerPtr& packageManager, const SessionPtr& session) : mPackageManager(packageManager), mSession(session) {}
+    PackageResolver(const PackageManagerPtr& packageManager,
+                    const SessionPtr& session,
+                    const PackageCachePtr& packageCache = nullptr)
+        : mPackageManager(packageManager), mSession(session), mPackageCache(packageCache) {}
 
     /**
      * Loads the packages that are requested from a pending import package.
@@ -102,6 +108,7 @@ private:
     };
 
     void setPackageManager(const PackageManagerPtr& packageManager) { mPackageManager = packageManager; }
+    void setPackageCache(const PackageCachePtr& packageCache) { mPackageCache = packageCache; }
     void onPackageFailure(const ImportRequest& request, const std::string& errorMessage, int errorCode);
     void onPackageLoaded(const ImportRequest& request, const SharedJsonData& jsonData) {
         onPackageLoaded(request, JsonData(jsonData));
@@ -118,6 +125,7 @@ private:
 private:
     PackageManagerPtr mPackageManager;
     SessionPtr mSession;
+    PackageCachePtr mPackageCache;
     PendingLoad mPending;
 };
 
@@ -0,0 +1,102 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_PACKED_JSON_H
+#define _APL_PACKED_JSON_H
+
+#include <memory>
+#include <string>
+
+#include "rapidjson/document.h"
+
+#include "apl/content/sharedjsondata.h"
+
+namespace apl {
+
+/**
+ * Pre-compiled binary form of an APL package.
+ *
+ * Large shared packages are normally downloaded as JSON text and parsed again for every document
+ * that imports them.  A packed package holds the same document in a compact binary layout that
+ * can be converted ahead of time (see the packPackage program) and cached or memory-mapped by
+ * the viewhost.  Unpacking skips text parsing, number conversion and escape processing, and it
+ * does not copy strings: the unpacked DOM points directly into the packed bytes, which are kept
+ * alive for as long as the returned SharedJsonData is in use.
+ *
+ * A PackageManager hands a packed package back exactly like a JSON one:
+ *
+ *     void loadPackage(const PackageRequestPtr& packageRequest) override {
+ *         auto bytes = mCache.get(packageRequest->request());
+ *         if (PackedJson::isPacked(bytes->data(), bytes->size()))
+ *             packageRequest->succeed(PackedJson::unpack(bytes->data(), bytes->size(), bytes));
+ *         else
+ *             packageRequest->succeed(SharedJsonData(*bytes));
+ *     }
+ *
+ * Layout (version 1, all integers are unsigned LEB128 unless noted):
+ *
+ *     "APLP" version:u8 reserved:u8[3]
+ *     string-count { length bytes NUL }*       Every distinct key and string value, stored once
+ *     value                                    The document
+ *
+ *     value := tag:u8 payload
+ *         null, false, true                    No payload
+ *         int                                  Zig-zag encoded signed integer
+ *         uint                                 Unsigned integer
+ *         double                               IEEE 754, 8 bytes little-endian
+ *         string                               Index into the string table
+ *         array                                count value*
+ *         object                               count { key-index value }*
+ */
+class PackedJson {
+public:
+    /// Current version of the binary layout
+    static const int VERSION = 1;
+
+    /**
+     * @param data Candidate bytes.
+     * @param length Number of bytes.
+     * @return True if the bytes start with the packed package header.
+     */
+    static bool isPacked(const char *data, size_t length);
+
+    /**
+     * Convert a JSON value to the packed binary layout.
+     * @param value The JSON document.
+     * @return The packed bytes.
+     */
+    static std::string pack(const rapidjson::Value& value);
+
+    /**
+     * Rebuild the JSON document from packed bytes without copying strings.
+     * @param data Packed bytes.  They must stay valid until the owner is released.
+     * @param length Number of bytes.
+     * @param owner Keeps the bytes alive (for example, the object that unmaps a mapped file).  It is
+     *              released when the last copy of the returned SharedJsonData is destroyed.
+     * @return The document.  Converts to false if the bytes are not a valid packed package.
+     */
+    static SharedJsonData unpack(const char *data, size_t length, const std::shared_ptr<const void>& owner);
+
+    /**
+     * Rebuild the JSON document from packed bytes held in a string.
+     * @param data Packed bytes.  The string is moved into the returned SharedJsonData.
+     * @return The document.  Converts to false if the bytes are not a valid packed package.
+     */
+    static SharedJsonData unpack(std::string&& data);
+};
+
+} // namespace apl
+
+#endif // _APL_PACKED_JSON_H
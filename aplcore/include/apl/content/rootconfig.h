@@ -100,7 +100,22 @@ public:
         /// AVG should use layers for parameterized elements
         kExperimentalFeatureGraphicLayers,
         /// Accessibility actions reported on component may depend on component state
-        kExperimentalFeatureDynamicAccessibilityActions
+        kExperimentalFeatureDynamicAccessibilityActions,
+        /// Collect the text measurements of a subtree in a layout pre-pass and hand them to
+        /// TextMeasurement::layoutBatch before the real layout runs
+        kExperimentalFeatureTextMeasurePrePass,
+        /// Allocate the contexts and dependants created while inflating a document from a
+        /// per-document object pool instead of the global heap
+        kExperimentalFeaturePooledAllocation,
+        /// Allocate the scene graph layers, nodes, paths and paints from an object pool owned by
+        /// the scene graph.  The view host must release them on the thread calling getSceneGraph()
+        kExperimentalFeatureSceneGraphPool,
+        /// Index the bounds of the children of large containers so that hit testing, hover and
+        /// the focus finder only visit the children near the point or viewport of interest
+        kExperimentalFeatureSpatialIndex,
+        /// Cache the visual context of each component and only rebuild the subtrees that changed
+        /// since the previous call to serializeVisualContext
+        kExperimentalFeatureVisualContextCache
     };
 
     /**
@@ -182,6 +197,18 @@ public:
         return *this;
     }
 
+    /**
+     * Specify a cache of loaded packages.  Documents created with this configuration look up
+     * imported packages in the cache before asking the package manager, and add the packages they
+     * load to it.  The same cache may be shared by any number of configurations.
+     * @param packageCache The package cache.  May be null to disable caching.
+     * @return This object for chaining.
+     */
+    RootConfig& packageCache(const PackageCachePtr& packageCache) {
+        mPackageCache = packageCache;
+        return *this;
+    }
+
     /**
      * Specify the media player factory used for creating media players for video
      * @param mediaPlayerFactory The media player factory object.
@@ -951,6 +978,11 @@ public:
      */
     PackageManagerPtr getPackageManager() const { return mPackageManager; }
 
+    /**
+     * @return The configured package cache.  May be null.
+     */
+    PackageCachePtr getPackageCache() const { return mPackageCache; }
+
     /**
      * @return The configured media player factory
      */
@@ -1508,6 +1540,7 @@ private:
     DocumentManagerPtr mDocumentManager;
     MediaManagerPtr mMediaManager;
     PackageManagerPtr mPackageManager;
+    PackageCachePtr mPackageCache;
     MediaPlayerFactoryPtr mMediaPlayerFactory;
     AudioPlayerFactoryPtr mAudioPlayerFactory;
 #ifdef SCENEGRAPH
@@ -143,6 +143,11 @@ enum RootProperty {
     kTextMeasurementCacheLimit,
     /// Initial display state of the document, used by core prior to any display state updates
     kInitialDisplayState,
+    /// Approximate number of bytes of text layouts kept alive after components release them. 0 disables.
+    kTextLayoutCacheBudget,
+    /// Pages of fully inflated children kept on each side of the viewport of a LiveArray-backed
+    /// Sequence or GridSequence.  Children further away are released back to placeholders.  0 disables.
+    kSequenceVirtualizationWindow,
     /// The End key marks the end of the enum members.
     /// All new enum values should be added *before* this
     kRootPropertySetEnd
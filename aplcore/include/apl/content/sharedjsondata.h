@@ -166,6 +166,7 @@ public:
 
 private:
     friend class JsonData;
+    friend class PackedJson;
     SharedJsonData() = default;
 
 private:
@@ -81,6 +81,7 @@ enum ByteCodeOpcode {
     BC_OPCODE_APPEND_ARRAY,     // TOS = TOS_1.append(TOS)
     BC_OPCODE_APPEND_MAP,       // TOS = TOS_2.append(TOS_1, TOS)
     BC_OPCODE_EVALUATE,         // TOS = eval(TOS)
+    BC_OPCODE_NUMERIC_EXPRESSION, // TOS = numericExpression[value].evaluate()
 };
 
 /**
@@ -175,6 +176,53 @@ struct ByteCodeInstruction {
 
 static_assert(sizeof(ByteCodeInstruction) == 4, "Wrong size of ByteCodeInstruction");
 
+/**
+ * A straight-line arithmetic expression that the optimizer has compiled to operate on raw
+ * doubles.  The operands are numeric constants and bound symbols that held numbers when the
+ * byte code was optimized.  Each evaluation checks that every symbol still holds a number; if
+ * one does not, the same steps are executed with generic Object arithmetic so the result is
+ * identical to the unspecialized byte code.
+ */
+struct NumericExpression {
+    static const size_t MAX_DEPTH = 16;   // Maximum stack depth of the step list
+    static const size_t MAX_SYMBOLS = 8;  // Maximum number of distinct bound symbols
+
+    enum Operation {
+        LOAD_NUMBER,  // Push numbers[index]
+        LOAD_SYMBOL,  // Push the value of the bound symbol symbols[index]
+        PLUS,
+        MINUS,
+        MULTIPLY,
+        DIVIDE,
+        REMAINDER,
+        ADD,
+        SUBTRACT
+    };
+
+    struct Step {
+        Operation operation;
+        int index;
+    };
+
+    std::vector<Step> steps;
+    std::vector<double> numbers;
+    std::vector<int> symbols;   // Indices into the byte code data of the referenced bound symbols
+
+    /**
+     * Evaluate the expression.
+     * @param data The data of the byte code that owns this expression.
+     * @param symbolSet If not null, the bound symbols used are added to this set.
+     * @return The result of the evaluation.
+     */
+    Object evaluate(const std::vector<Object>& data, BoundSymbolSet *symbolSet) const;
+
+    /**
+     * @param data The data of the byte code that owns this expression.
+     * @return The expression in reverse Polish notation, for disassembly.
+     */
+    std::string toString(const std::vector<Object>& data) const;
+};
+
 
 /**
  * The Disassembly class is a convenience class for ByteCode that provides an iterator
@@ -266,6 +314,12 @@ public:
      */
     size_t instructionCount() const { return mInstructions.size(); }
 
+    /**
+     * @return The maximum depth the evaluation stack reaches while executing this byte code.
+     *         The value is computed from the instructions the first time it is requested.
+     */
+    size_t maxStackDepth() const;
+
     /**
      * Return the data item at a particular index.
      * @param index The index
@@ -305,8 +359,10 @@ private:
     std::weak_ptr<Context> mContext;
     std::vector<ByteCodeInstruction> mInstructions;
     std::vector<Object> mData;
+    std::vector<NumericExpression> mNumericExpressions;
 
     bool mOptimized = false;
+    mutable int mMaxStackDepth = -1;  // Lazily calculated; -1 means not yet calculated
 };
 
 
@@ -17,6 +17,7 @@
 #define _APL_BYTE_CODE_ASSEMBLER_H
 
 #include "apl/datagrammar/bytecode.h"
+#include "apl/datagrammar/bytecodecache.h"
 
 namespace apl {
 namespace datagrammar {
@@ -71,6 +72,8 @@ public:
 
 private:
     Object retrieve() const;
+    ByteCodeTemplatePtr makeTemplate() const;
+    static Object instantiate(const Context& context, const ByteCodeTemplate& byteCodeTemplate);
 
     /*** Methods after this point are for use by the PEGTL parser ***/
 
@@ -79,6 +82,7 @@ private:
     void loadConstant(ByteCodeConstant value);
     void loadImmediate(bciValueType value);
     void loadGlobal(const std::string& name);
+    void loadDimension(const std::string& value);
 
     void pushAttributeName(const std::string &name);
     void loadAttribute();
@@ -170,6 +174,8 @@ private:
     std::vector<ByteCodeInstruction>* mInstructionRef;
     std::vector<Object>* mDataRef;
     std::vector<Operator>* mOperatorsRef;
+    std::vector<ByteCodeTemplate::GlobalReference> mGlobals;  // Global symbols loaded, for the byte code cache
+    bool mCacheable = true;  // False if the byte code depends on the context beyond global symbol lookup
     int mDeferredDepth = 0;  // Track the stack of nested deferred evaluation #{..#{..${...}..}..}
     bool mCanDeferAndEval = false;  // Set to true if this assembler supports deferred evaluation (2023.2 or later)
 };
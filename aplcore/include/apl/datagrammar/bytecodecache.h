@@ -0,0 +1,105 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_BYTE_CODE_CACHE_H
+#define _APL_BYTE_CODE_CACHE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "apl/datagrammar/bytecode.h"
+#include "apl/utils/lrucache.h"
+
+namespace apl {
+namespace datagrammar {
+
+/**
+ * A context-independent copy of assembled (but not optimized) byte code.  Global symbol
+ * references are recorded by name and re-resolved each time the template is instantiated,
+ * so the same template may be shared by every context that parses the same expression.
+ */
+struct ByteCodeTemplate {
+    /**
+     * A reference to a global symbol loaded by the byte code.
+     */
+    struct GlobalReference {
+        size_t pc;          /// The instruction that loads the symbol
+        int dataIndex;      /// The data slot assigned to the symbol or -1 if no slot was assigned
+        std::string name;   /// The name of the symbol
+    };
+
+    std::vector<ByteCodeInstruction> instructions;
+    std::vector<Object> data;
+    std::vector<GlobalReference> globals;
+};
+
+using ByteCodeTemplatePtr = std::shared_ptr<const ByteCodeTemplate>;
+
+/**
+ * A bounded cache of parsed data-binding expressions keyed by the expression string.  One
+ * cache is held by each document; the requested APL version (which controls the grammar) is
+ * fixed for a document so it does not need to be part of the key.
+ */
+class ByteCodeCache {
+public:
+    static const size_t DEFAULT_SIZE = 1024;
+
+    explicit ByteCodeCache(size_t maxSize = DEFAULT_SIZE) : mCache(maxSize) {}
+
+    /**
+     * Look up an expression in the cache.
+     * @param expression The source string of the expression.
+     * @return The cached template or nullptr if the expression has not been cached.
+     */
+    ByteCodeTemplatePtr find(const std::string& expression) {
+        if (!mCache.has(expression)) {
+            mMisses++;
+            return nullptr;
+        }
+
+        mHits++;
+        return mCache.get(expression);
+    }
+
+    /**
+     * Store a template in the cache.  The caller should only store an expression after a miss.
+     * @param expression The source string of the expression.
+     * @param byteCodeTemplate The template.
+     */
+    void put(const std::string& expression, ByteCodeTemplatePtr byteCodeTemplate) {
+        mCache.put(expression, std::move(byteCodeTemplate));
+    }
+
+    /**
+     * @return The number of lookups that found a cached template.
+     */
+    size_t hits() const { return mHits; }
+
+    /**
+     * @return The number of lookups that did not find a cached template.
+     */
+    size_t misses() const { return mMisses; }
+
+private:
+    LruCache<std::string, ByteCodeTemplatePtr> mCache;
+    size_t mHits = 0;
+    size_t mMisses = 0;
+};
+
+} // namespace datagrammar
+} // namespace apl
+
+#endif // _APL_BYTE_CODE_CACHE_H
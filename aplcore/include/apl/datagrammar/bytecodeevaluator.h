@@ -31,7 +31,21 @@ namespace datagrammar {
  */
 class ByteCodeEvaluator {
 public:
-    ByteCodeEvaluator(const ByteCode& byteCode, BoundSymbolSet *symbols, int depth);
+    /**
+     * Instruction dispatch strategy
+     */
+    enum DispatchMode {
+        /// Dispatch each instruction through a switch statement in a loop
+        kDispatchSwitch,
+        /// Jump directly from one instruction handler to the next (computed goto).  On compilers
+        /// that don't support computed goto this is identical to kDispatchSwitch.
+        kDispatchThreaded
+    };
+
+    ByteCodeEvaluator(const ByteCode& byteCode,
+                      BoundSymbolSet *symbols,
+                      int depth,
+                      DispatchMode mode = kDispatchThreaded);
 
     /**
      * Start or continue executing the byte code.
@@ -52,11 +66,14 @@ public:
 private:
     enum State { INIT, DONE, ERROR };
 
+    template<bool THREADED> void run();
+
     const ByteCode& mByteCode;
     std::vector<Object> mStack;
     BoundSymbolSet *mSymbols;
     int mProgramCounter = 0;
     int mEvaluationDepth;
+    DispatchMode mDispatchMode;
     State mState = INIT;
 };
 
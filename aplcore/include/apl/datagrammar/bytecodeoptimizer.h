@@ -22,8 +22,8 @@ namespace apl {
 namespace datagrammar {
 
 /**
- * This class optimizes byte code with constant folding, dead code removal, and
- * context resolution.
+ * This class optimizes byte code with constant folding, dead code removal,
+ * context resolution, and specialization of numeric arithmetic.
  */
 class ByteCodeOptimizer {
 public:
@@ -37,8 +37,12 @@ private:
     ByteCodeOptimizer(ByteCode& byteCode);
 
     void simplifyOperations();
+    void specializeNumeric();
     void simplifyOperands();
 
+    NumericExpression buildNumericExpression(int start, int end) const;
+    int storeOperand(std::vector<Object>& operands, int index);
+
 private:
     ByteCode& mByteCode;
 };
@@ -97,7 +97,7 @@ template<> struct action< dimension >
     template< typename Input >
     static void apply( const Input& in, fail_state& failState, ByteCodeAssembler& assembler) {
         if (failState.failed || assembler.deferred()) return;
-        assembler.loadOperand(Object(Dimension(*(assembler.context()), in.string())));
+        assembler.loadDimension(in.string());
     }
 };
 
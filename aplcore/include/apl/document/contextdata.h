@@ -23,6 +23,7 @@
 #include "apl/engine/runtimestate.h"
 #include "apl/primitives/size.h"
 #include "apl/utils/counter.h"
+#include "apl/utils/objectpool.h"
 
 namespace apl {
 
@@ -54,6 +55,21 @@ public:
         return *this;
     }
 
+    /**
+     * Allocate the small shared objects created for this context (child contexts, dependants)
+     * from a pool.
+     * @param pool The object pool.  May be null to use the global heap.
+     */
+    ContextData& objectPool(const ObjectPoolPtr& pool) {
+        mObjectPool = pool;
+        return *this;
+    }
+
+    /**
+     * @return The object pool used by this context, or null if objects use the global heap.
+     */
+    const ObjectPoolPtr& objectPool() const { return mObjectPool; }
+
     std::string getLang() const { return mLang; }
     LayoutDirection getLayoutDirection() const { return mLayoutDirection; }
     bool getReinflationFlag() const { return mRuntimeState.getReinflation(); }
@@ -82,6 +98,7 @@ protected:
     SettingsPtr mSettings;
     std::string mLang;
     LayoutDirection mLayoutDirection = LayoutDirection::kLayoutDirectionInherit;
+    ObjectPoolPtr mObjectPool;
 };
 
 
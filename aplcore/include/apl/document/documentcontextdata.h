@@ -37,6 +37,10 @@ class TextPropertiesCache;
 }
 #endif // SCENEGRAPH
 
+namespace datagrammar {
+class ByteCodeCache;
+}
+
 class ExtensionManager;
 class FocusManager;
 class HoverManager;
@@ -108,6 +112,7 @@ public:
     MediaManager& mediaManager() const;
     MediaPlayerFactory& mediaPlayerFactory() const;
     UIDManager& uniqueIdManager() const { return *mUniqueIdManager; }
+    datagrammar::ByteCodeCache& byteCodeCache() const { return *mByteCodeCache; }
     DependantManager& dependantManager() const;
     VisibilityManager& visibilityManager() const;
 
@@ -185,6 +190,7 @@ private:
     std::unique_ptr<LiveDataManager> mDataManager;
     std::unique_ptr<ExtensionManager> mExtensionManager;
     std::unique_ptr<UIDManager> mUniqueIdManager;
+    std::unique_ptr<datagrammar::ByteCodeCache> mByteCodeCache;
     CoreComponentPtr mTop;
     SessionPtr mSession;
     WeakPtrSet<CoreComponent> mPendingOnMounts;
@@ -0,0 +1,82 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_VISUAL_CONTEXT_DELTA_H
+#define _APL_VISUAL_CONTEXT_DELTA_H
+
+#include <map>
+#include <string>
+
+#include "rapidjson/document.h"
+
+namespace apl {
+
+/**
+ * Reduces successive visual context serializations to the entries that changed.  Each entry of
+ * the visual context is identified by its "uid"; an entry is reported when it is new or when any
+ * of its members differ from the previous serialization.  The "children" member of a reported
+ * entry is replaced by the list of child uids, so a consumer can maintain a flat map of entries
+ * keyed by uid:
+ *
+ *     {
+ *       "changed": [ { "uid": ":1000", "children": [ ":1001", ":1002" ], ... }, ... ],
+ *       "removed": [ ":1003", ... ]
+ *     }
+ *
+ * The first call reports every entry.  Typical use:
+ *
+ *     auto context = root->serializeVisualContext(allocator);
+ *     auto delta = visualContextDelta.update(context, allocator);
+ */
+class VisualContextDelta {
+public:
+    /**
+     * Compare a visual context with the one passed to the previous call.
+     * @param visualContext The serialized visual context of a document.
+     * @param allocator Allocator for the returned value.
+     * @return An object holding the "changed" entries and the "removed" uids.
+     */
+    rapidjson::Value update(const rapidjson::Value& visualContext,
+                            rapidjson::Document::AllocatorType& allocator);
+
+    /**
+     * Forget the previous visual context.  The next call to update() reports every entry.
+     */
+    void reset() { mEntries.clear(); }
+
+    /**
+     * @return The number of entries in the previous visual context.
+     */
+    size_t size() const { return mEntries.size(); }
+
+private:
+    using StoredValue = rapidjson::GenericValue<rapidjson::UTF8<>, rapidjson::CrtAllocator>;
+
+    struct Entry {
+        StoredValue value;
+        unsigned generation;
+    };
+
+    void visit(const rapidjson::Value& entry, rapidjson::Value& changed,
+               rapidjson::Document::AllocatorType& allocator);
+
+    std::map<std::string, Entry> mEntries;
+    unsigned mGeneration = 0;
+    rapidjson::CrtAllocator mStoredAllocator;
+};
+
+} // namespace apl
+
+#endif // _APL_VISUAL_CONTEXT_DELTA_H
@@ -16,6 +16,9 @@
 #ifndef _APL_CONTEXT_H
 #define _APL_CONTEXT_H
 
+#include <algorithm>
+#include <vector>
+
 #include "apl/common.h"
 #include "apl/component/componentproperties.h"
 #include "apl/content/metrics.h"
@@ -24,6 +27,7 @@
 #include "apl/engine/recalculatesource.h"
 #include "apl/engine/recalculatetarget.h"
 #include "apl/engine/styleinstance.h"
+#include "apl/engine/symboltable.h"
 #include "apl/primitives/object.h"
 #include "apl/primitives/textmeasurerequest.h"
 #include "apl/scenegraph/common.h"
@@ -31,6 +35,7 @@
 #include "apl/utils/localemethods.h"
 #include "apl/utils/lrucache.h"
 #include "apl/utils/noncopyable.h"
+#include "apl/utils/objectpool.h"
 #include "apl/utils/path.h"
 #include "apl/yoga/yogaconfig.h"
 
@@ -54,6 +59,10 @@ class VisibilityManager;
 
 using DataSourceConnectionPtr = std::shared_ptr<DataSourceConnection>;
 
+namespace datagrammar {
+class ByteCodeCache;
+}
+
 /*
  * The data-binding context holds information about the local environment, metrics, and resources.
  * Context objects should be heap-allocated with a shared pointer to their parent context.
@@ -70,9 +79,7 @@ public:
      * @param parent The parent context.
      * @return The child context.
      */
-    static ContextPtr createFromParent(const ContextPtr &parent) {
-        return std::make_shared<Context>(parent);
-    }
+    static ContextPtr createFromParent(const ContextPtr &parent);
 
     /**
      * Create a top-level context for testing. Do not use this for non-testing code
@@ -148,7 +155,8 @@ public:
      * @param parent The parent of this context.
      */
     explicit Context(const ContextPtr& parent)
-        : mParent(parent), mTop(parent->top() ? parent->top() : parent), mCore(parent->mCore) {}
+        : mParent(parent), mTop(parent->top() ? parent->top() : parent), mCore(parent->mCore),
+          mSymbols(parent->mSymbols) {}
 
     /**
      * Construct a free-standing context.  Do not call this directly; use the ::create* method instead
@@ -167,7 +175,7 @@ public:
      * can set up a loop in the context system.  Calling this routine releases all locally defined data-bindings.
      */
     void release() {
-        mMap.clear();
+        mValues.clear();
     }
 
     /**
@@ -200,18 +208,34 @@ public:
         const ContextObject *mObject = nullptr;
     };
 
+    /**
+     * @return The table of interned names shared by this context and its ancestors.
+     */
+    SymbolTable& symbols() const { return *mSymbols; }
+
     /**
      * Find a reference to an object in a context.  The returned object may be empty.
      * @param key The name to search for
      * @return The context reference object
      */
     ContextRef find(const std::string& key) const {
-        auto it = mMap.find(key);
-        if (it != mMap.end())
-            return { *this, it->second };
+        return find(mSymbols->find(key));
+    }
 
-        if (mParent)
-            return mParent->find(key);
+    /**
+     * Find a reference to an object in a context by interned name.  The returned object may be empty.
+     * @param atom The interned name to search for
+     * @return The context reference object
+     */
+    ContextRef find(SymbolTable::Atom atom) const {
+        if (atom == SymbolTable::NO_ATOM)
+            return {};
+
+        for (auto context = this ; context ; context = context->mParent.get()) {
+            auto object = context->findLocal(atom);
+            if (object)
+                return { *context, *object };
+        }
 
         return {};
     }
@@ -222,7 +246,16 @@ public:
      * @return The value or null.
      */
     Object opt(const std::string& key) const {
-        auto cr = find(key);
+        return opt(mSymbols->find(key));
+    }
+
+    /**
+     * Look up a value in the context by interned name.  If the value doesn't exist, return null.
+     * @param atom The interned name to look up.
+     * @return The value or null.
+     */
+    Object opt(SymbolTable::Atom atom) const {
+        auto cr = find(atom);
         if (!cr.empty())
             return cr.object().value();
 
@@ -235,7 +268,16 @@ public:
      * @return True if the value is defined somewhere in this context or an ancestor context.
      */
     bool has(const std::string& key) const {
-        auto cr = find(key);
+        return has(mSymbols->find(key));
+    }
+
+    /**
+     * Check to see if a value exists in the context.
+     * @param atom The interned name to look up.
+     * @return True if the value is defined somewhere in this context or an ancestor context.
+     */
+    bool has(SymbolTable::Atom atom) const {
+        auto cr = find(atom);
         return !cr.empty();
     }
 
@@ -245,7 +287,7 @@ public:
      * @return True if the values is defined somewhere in this immediate context (not an ancestor)
      */
     bool hasLocal(const std::string& key) const {
-        return mMap.find(key) != mMap.end();
+        return findLocal(mSymbols->find(key)) != nullptr;
     }
 
     /**
@@ -271,11 +313,11 @@ public:
     }
 
     void setValue(std::string key, const Object& value, bool) override {
-        auto it = mMap.find(key);
-        if (it == mMap.end())
+        auto object = findLocal(mSymbols->find(key));
+        if (object == nullptr)
             return;
 
-        if (it->second.set(value))
+        if (object->set(value))
             enqueueDownstream(key);
     }
 
@@ -308,7 +350,7 @@ public:
      */
     void putConstant(const std::string& key, const Object& value)
     {
-        mMap.emplace(key, ContextObject(value));
+        emplaceLocal(key, ContextObject(value));
     }
 
     /**
@@ -323,7 +365,7 @@ public:
      */
     void putUserWriteable(const std::string& key, const Object& value, const BindingChangePtr& onChange = nullptr)
     {
-        mMap.emplace(key, ContextObject(value).userWriteable().onChange(onChange));
+        emplaceLocal(key, ContextObject(value).userWriteable().onChange(onChange));
     }
 
     /**
@@ -336,7 +378,7 @@ public:
      */
     void putSystemWriteable(const std::string& key, const Object& value)
     {
-        mMap.emplace(key, ContextObject(value).systemWriteable());
+        emplaceLocal(key, ContextObject(value).systemWriteable());
     }
 
     /**
@@ -349,11 +391,8 @@ public:
      */
     void putResource(const std::string& key, const Object& value, const Path& path) {
         // Toss away a resource if it already exists (we overwrite it)
-        auto it = mMap.find(key);
-        if (it != mMap.end())
-            mMap.erase(it);
-
-        mMap.emplace(key, ContextObject(value).provenance(path));
+        remove(key);
+        emplaceLocal(key, ContextObject(value).provenance(path));
     }
 
     /**
@@ -361,9 +400,10 @@ public:
      * @param key The string key name
      */
     void remove(const std::string& key) {
-        auto it = mMap.find(key);
-        if (it != mMap.end())
-            mMap.erase(it);
+        auto atom = mSymbols->find(key);
+        auto it = lowerBound(atom);
+        if (it != mValues.end() && it->first == atom)
+            mValues.erase(it);
     }
 
     /**
@@ -373,14 +413,8 @@ public:
      */
     std::string provenance(const std::string& key) const {
         // The provenance for a key can only be used if the current map has that key entry
-        auto it = mMap.find(key);
-        if (it != mMap.end())
-            return it->second.provenance().toString();
-
-        if (mParent)
-            return mParent->provenance(key);
-
-        return "";
+        auto cr = find(key);
+        return cr.empty() ? "" : cr.object().provenance().toString();
     }
 
     /**
@@ -389,25 +423,42 @@ public:
      * @return True if the value is mutable.
      */
     bool isMutable(const std::string& key) const {
-        auto it = mMap.find(key);
-        if (it != mMap.end())
-            return it->second.isMutable();
+        auto cr = find(key);
+        return !cr.empty() && cr.object().isMutable();
+    }
 
-        if (mParent)
-            return mParent->isMutable(key);
+    /**
+     * Iterates over the bindings defined in a single context, yielding (name, ContextObject) pairs.
+     */
+    class const_iterator {
+    public:
+        using value_type = std::pair<const std::string&, const ContextObject&>;
 
-        return false;
-    }
+        const_iterator(const Context& context, size_t index) : mContext(context), mIndex(index) {}
+
+        value_type operator*() const {
+            const auto& entry = mContext.mValues[mIndex];
+            return { mContext.mSymbols->name(entry.first), entry.second };
+        }
+
+        const_iterator& operator++() { mIndex++; return *this; }
+        bool operator==(const const_iterator& rhs) const { return mIndex == rhs.mIndex; }
+        bool operator!=(const const_iterator& rhs) const { return mIndex != rhs.mIndex; }
+
+    private:
+        const Context& mContext;
+        size_t mIndex;
+    };
 
     /**
      * @return An iterator to the beginning of defined bindings
      */
-    std::map<std::string, ContextObject>::const_iterator begin() const { return mMap.begin(); }
+    const_iterator begin() const { return { *this, 0 }; }
 
     /**
      * @return An iterator to the end of the defined bindings
      */
-    std::map<std::string, ContextObject>::const_iterator end() const { return mMap.end(); }
+    const_iterator end() const { return { *this, mValues.size() }; }
 
     /**
      * @return The parent of this context or nullptr if there is no parent
@@ -554,6 +605,12 @@ public:
      */
     SharedContextDataPtr getShared() const;
 
+    /**
+     * @return The cache of parsed data-binding expressions for this document or nullptr if this
+     *         context is not part of a document.
+     */
+    datagrammar::ByteCodeCache* byteCodeCache() const;
+
     /**
      * @return The human-readable mode of the viewport
      */
@@ -637,6 +694,11 @@ public:
 
     const SessionPtr& session() const;
 
+    /**
+     * @return The document object pool used for small shared allocations, or null if pooling is disabled.
+     */
+    const ObjectPoolPtr& objectPool() const;
+
     const YogaConfig& ygconfig() const;
 
     const TextMeasurementPtr& measure() const;
@@ -655,10 +717,36 @@ public:
     rapidjson::Value serialize(rapidjson::Document::AllocatorType& allocator);
 
 protected:
+    using Entry = std::pair<SymbolTable::Atom, ContextObject>;
+
+    std::vector<Entry>::const_iterator lowerBound(SymbolTable::Atom atom) const {
+        return std::lower_bound(mValues.begin(), mValues.end(), atom,
+                                [](const Entry& entry, SymbolTable::Atom a) { return entry.first < a; });
+    }
+
+    const ContextObject *findLocal(SymbolTable::Atom atom) const {
+        auto it = lowerBound(atom);
+        return it != mValues.end() && it->first == atom ? &it->second : nullptr;
+    }
+
+    ContextObject *findLocal(SymbolTable::Atom atom) {
+        return const_cast<ContextObject *>(static_cast<const Context*>(this)->findLocal(atom));
+    }
+
+    // Store a value unless the key is already defined in this context
+    void emplaceLocal(const std::string& key, ContextObject object) {
+        auto atom = mSymbols->intern(key);
+        auto it = lowerBound(atom);
+        if (it == mValues.end() || it->first != atom)
+            mValues.emplace(it, atom, std::move(object));
+    }
+
     ContextPtr mParent;
     ContextPtr mTop;
     ContextDataPtr mCore;
-    std::map<std::string, ContextObject> mMap;
+    SymbolTablePtr mSymbolTable;        // Only set in a top-level context; children share it
+    SymbolTable *mSymbols = nullptr;
+    std::vector<Entry> mValues;         // Local bindings sorted by atom
 
 private:
     /**
@@ -21,6 +21,8 @@
 
 namespace apl {
 
+class FrameBudget;
+
 /**
  * Core implementation of RootContext API.
  */
@@ -53,6 +55,8 @@ public:
     void updateDisplayState(DisplayState displayState) override;
     void reinflate() override;
     void clearPending() const override;
+    bool clearPending(apl_duration_t budget) const override;
+    ClearPendingStats getClearPendingStats() const override;
     bool hasEvent() const override;
     Event popEvent() override;
     Context& context() const override;
@@ -61,6 +65,7 @@ public:
     DocumentContextPtr topDocument() const override;
     bool isDirty() const override;
     const std::set<ComponentPtr>& getDirty() override;
+    void getDirtyProperties(DirtyPropertyBuffer& buffer) override;
     void clearDirty() override;
     bool isVisualContextDirty() const override;
     void clearVisualContextDirty() override;
@@ -171,7 +176,8 @@ private:
 
     bool setup(bool reinflate);
     ObjectMapPtr createDocumentEventProperties(const std::string& handler) const;
-    void clearPendingInternal(bool first) const;
+    void clearPendingInternal(bool first, FrameBudget *budget = nullptr) const;
+    size_t deferredDataUpdates() const;
     void updateTimeInternal(apl_time_t elapsedTime, apl_time_t utcTime);
 
 private:
@@ -181,6 +187,7 @@ private:
     apl_duration_t mLocalTimeAdjustment = 0;
     DisplayState mDisplayState;
     CoreDocumentContextPtr mTopDocument;
+    mutable ClearPendingStats mClearPendingStats;
     mutable Size mViewportSize;  // Viewport size in dp; mutable so that LayoutManager can change it
 #ifdef SCENEGRAPH
     sg::SceneGraphPtr mSceneGraph;
@@ -83,6 +83,11 @@ protected:
     BindingFunction mBindingFunction;
     BoundSymbolSet mSymbols;
     size_t mOrder;
+
+private:
+    friend class DependantManager;
+
+    bool mQueued = false;  // True while waiting in the DependantManager queue
 };
 
 }  // namespace apl
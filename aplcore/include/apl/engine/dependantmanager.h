@@ -30,6 +30,10 @@ namespace apl {
  *
  * The manager is responsible for assigning topological sort IDs as the dependencies are
  * generated and for processing the dependencies in sort order as they are triggered.
+ *
+ * Pending dependants are stored in a binary min-heap ordered by sort ID.  Each dependant
+ * carries an intrusive "queued" flag, so enqueuing a dependant that is already waiting to
+ * be processed is a constant-time no-op.
  */
 class DependantManager {
 public:
@@ -51,11 +55,16 @@ public:
      */
     void processDependencies(bool useDirtyFlag);
 
+    /**
+     * @return The number of dependants waiting to be processed.
+     */
+    size_t pending() const { return mProcessList.size(); }
+
 private:
     id_type mSortOrderGenerator = 10;  // Start at a non-zero value to help debugging
-    std::vector<DependantPtr> mProcessList;  // Sorted list of dependants.  Could be a deque
+    std::vector<DependantPtr> mProcessList;  // Min-heap of dependants ordered by sort order
 };
 
 } // namespace apl
 
-#endif
\ No newline at end of file
+#endif
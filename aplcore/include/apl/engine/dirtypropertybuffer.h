@@ -0,0 +1,114 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_DIRTY_PROPERTY_BUFFER_H
+#define _APL_DIRTY_PROPERTY_BUFFER_H
+
+#include <vector>
+
+#include "apl/common.h"
+#include "apl/component/componentproperties.h"
+
+namespace apl {
+
+class Object;
+
+/**
+ * A flat list of the properties that changed during a frame, filled by
+ * RootContext::getDirtyProperties().  The records of each component are contiguous and ordered by
+ * property key, so a view host can apply all of the changes of a component in one pass:
+ *
+ *     root->getDirtyProperties(buffer);
+ *     for (const auto& record : buffer)
+ *         updateProperty(record.component->getUniqueId(), record.key, record.value());
+ *     root->clearDirty();
+ *
+ * The buffer keeps its storage between frames, so reusing one buffer does not allocate once it has
+ * grown to the size of a typical frame.  The records refer to the components and their calculated
+ * property values; they are valid until clearDirty() is called or the document changes.
+ */
+class DirtyPropertyBuffer {
+public:
+    struct Record {
+        Component *component;
+        PropertyKey key;
+        const Object *property;
+
+        /**
+         * @return The new value of the property.
+         */
+        const Object& value() const { return *property; }
+    };
+
+    using const_iterator = std::vector<Record>::const_iterator;
+
+    /**
+     * Remove all records.  The storage is kept for the next frame.
+     */
+    void clear() {
+        mRecords.clear();
+        mComponentCount = 0;
+    }
+
+    /**
+     * Reserve space for a number of records.
+     * @param count The number of records.
+     */
+    void reserve(size_t count) { mRecords.reserve(count); }
+
+    /**
+     * Append a record.  Records must be appended component by component.
+     * @param component The component.
+     * @param key The property that changed.
+     * @param value The new value of the property.
+     */
+    void append(Component& component, PropertyKey key, const Object& value) {
+        if (mRecords.empty() || mRecords.back().component != &component)
+            mComponentCount++;
+        mRecords.emplace_back(Record{&component, key, &value});
+    }
+
+    /**
+     * @return The number of records.
+     */
+    size_t size() const { return mRecords.size(); }
+
+    /**
+     * @return True if there are no records.
+     */
+    bool empty() const { return mRecords.empty(); }
+
+    /**
+     * @return The number of components with at least one record.
+     */
+    size_t componentCount() const { return mComponentCount; }
+
+    /**
+     * @return The number of records the buffer can hold without allocating.
+     */
+    size_t capacity() const { return mRecords.capacity(); }
+
+    const Record& at(size_t index) const { return mRecords.at(index); }
+    const_iterator begin() const { return mRecords.begin(); }
+    const_iterator end() const { return mRecords.end(); }
+
+private:
+    std::vector<Record> mRecords;
+    size_t mComponentCount = 0;
+};
+
+} // namespace apl
+
+#endif // _APL_DIRTY_PROPERTY_BUFFER_H
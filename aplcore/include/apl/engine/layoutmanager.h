@@ -16,14 +16,16 @@
 #ifndef _APL_LAYOUT_MANAGER_H
 #define _APL_LAYOUT_MANAGER_H
 
-#include <set>
 #include <map>
+#include <vector>
 
 #include "apl/common.h"
 #include "apl/component/componentproperties.h"
+#include "apl/component/textmeasurement.h"
 #include "apl/content/metrics.h"
 #include "apl/primitives/object.h"
 #include "apl/primitives/size.h"
+#include "apl/primitives/textmeasurerequest.h"
 
 namespace apl {
 
@@ -60,10 +62,31 @@ class ConfigurationChange;
  * the MultiChildScrollableComponent keeps an "ensured range" of children which have Yoga nodes attached
  * to the node hierarchy.  As the component scrolls the ensured range is updated and additional nodes
  * are attached to the hierarchy.
+ *
+ * Layout passes are incremental.  Pending top nodes are queued using an intrusive flag on the component
+ * and Yoga's "has new layout" flag marks the nodes visited by calculateLayout.  Subtrees that Yoga skipped
+ * because their cached layout was still valid are not walked when processing and post-processing the
+ * layout changes.  The LayoutStats for the most recent pass report how much of the hierarchy was touched.
+ *
+ * When RootConfig::kExperimentalFeatureTextMeasurePrePass is enabled, a dirty top node is first run through
+ * a Yoga pass that only records the text measurements it would need.  Those are laid out together through
+ * TextMeasurement::layoutBatch and stored in the text layout cache, so the real pass finds most of them
+ * already measured.  Requests that change between the two passes are measured normally.
  */
 
 class LayoutManager {
 public:
+    /**
+     * Counts gathered during a single call to layout()
+     */
+    struct LayoutStats {
+        size_t topNodes = 0;    // Top nodes taken from the pending list
+        size_t calculated = 0;  // Top nodes that needed a Yoga calculateLayout call
+        size_t visited = 0;     // Components whose layout changes were processed
+        size_t relaid = 0;      // Visited components whose bounds or inner bounds changed
+        size_t batched = 0;     // Text layouts requested through the pre-pass batch
+    };
+
     /**
      * Instantiate a LayoutManager for the given CoreRootContext.
      * @param coreRootContext the CoreRootContext for which layouts will be managed
@@ -168,6 +191,35 @@ public:
      */
     void needToReProcessLayoutChanges() { mNeedToReProcessLayoutChanges = true; }
 
+    /**
+     * Record that the layout changes of a component have been processed.  Called by the component.
+     * @param changed True if the bounds or inner bounds of the component changed
+     */
+    void recordProcessed(bool changed) {
+        mStats.visited++;
+        if (changed)
+            mStats.relaid++;
+    }
+
+    /**
+     * @return True while the text measurement pre-pass is running.  Text components should record
+     *         their measurement with recordTextMeasurement() instead of measuring.
+     */
+    bool isRecordingTextMeasurements() const { return mRecordingTextMeasurements; }
+
+    /**
+     * Record a text measurement needed by a text component during the pre-pass.
+     * @param component The text component
+     * @param key The text layout cache key for the measurement
+     * @param entry The measurement to lay out
+     */
+    void recordTextMeasurement(CoreComponent& component, const TextMeasureRequest& key, TextLayoutBatchEntry&& entry);
+
+    /**
+     * @return Counts for the most recent layout pass
+     */
+    const LayoutStats& getLastLayoutStats() const { return mStats; }
+
     /**
      * @return Suggested min and max width for provided component.
      */
@@ -194,15 +246,22 @@ public:
 private:
     void layoutComponent(const CoreComponentPtr& component, bool useDirtyFlag, bool first);
     void flushLazyInflationInternal(const CoreComponentPtr& comp);
+    void schedule(const CoreComponentPtr& component);
+    std::vector<sg::TextLayoutPtr> prepareTextMeasurements(const CoreComponentPtr& component,
+                                                          float width, float height);
 
 private:
     const CoreRootContext& mRoot;
-    std::set<CoreComponentPtr> mPendingLayout;
+    std::vector<CoreComponentPtr> mPendingLayout;  // Each entry has kCoreComponentFlagLayoutPending set
     ViewportSize mConfiguredSize;
     bool mTerminated = false;
     bool mInLayout = false;    // Guard against recursive calls to layout
     bool mNeedToReProcessLayoutChanges = false;
     std::map<PPKey, Object, LayoutManager::PPKeyLess> mPostProcess;   // Collection of elements to post-process
+    LayoutStats mStats;
+    bool mRecordingTextMeasurements = false;
+    std::map<TextMeasureRequest, TextLayoutBatchEntry> mRecordedMeasurements;
+    std::vector<CoreComponent*> mRecordedComponents;  // Only valid during the pre-pass
 };
 
 } // namespace apl
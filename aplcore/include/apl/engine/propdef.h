@@ -358,6 +358,7 @@ public:
     typename std::map<K, PDef>::const_iterator begin() const { return mOrdered.begin(); }
     typename std::map<K, PDef>::const_iterator end() const { return mOrdered.end(); }
     typename std::map<K, PDef>::const_iterator find(K key) const { return mOrdered.find(key); }
+    std::size_t size() const { return mOrdered.size(); }
 
 protected:
     void addInternal(const PVec& list) {
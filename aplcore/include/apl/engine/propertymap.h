@@ -16,6 +16,9 @@
 #ifndef _APL_PROPERTY_MAP_H
 #define _APL_PROPERTY_MAP_H
 
+#include <algorithm>
+#include <vector>
+
 #include "apl/utils/bimap.h"
 #include "apl/primitives/object.h"
 
@@ -23,12 +26,21 @@ namespace apl {
 
 /**
  * Store calculated values that can be accessed by either string or integer index.
+ *
+ * The values are kept in a single vector sorted by key and located with a binary search.  This is
+ * considerably smaller than a node-based map and keeps the values of one component contiguous in
+ * memory.  Setting an existing key never moves other values, but inserting a new key may; do not
+ * hold a reference returned by get() across a set() of a key that may not already be present.
+ *
  * @tparam T The enumerated type stored.
  * @tparam bimap The bi-directional map.
  */
 template<class T, Bimap<int, std::string>& bimap>
 class PropertyMap {
 public:
+    using value_type = std::pair<T, Object>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
     PropertyMap() {}
 
     /**
@@ -42,7 +54,7 @@ public:
      * @return The value or Object::NULL_OBJECT if it does not exist
      */
     const Object& get(T key) const {
-        auto it = mValues.find(key);
+        auto it = find(key);
         if (it != mValues.end())
             return it->second;
 
@@ -55,7 +67,7 @@ public:
      * @return The value or Object::NULL_OBJECT if it does not exist
      */
     Object get(T key) {
-        auto it = mValues.find(key);
+        auto it = find(key);
         if (it != mValues.end())
             return it->second;
 
@@ -109,7 +121,27 @@ public:
      * @param value The value
      */
     void set(T key, const Object& value) {
-        mValues[key] = value;
+        auto it = lowerBound(key);
+        if (it != mValues.end() && it->first == key)
+            it->second = value;
+        else
+            mValues.emplace(it, key, value);
+    }
+
+    /**
+     * Reserve storage for a number of values.  Callers that know how many properties will be
+     * stored should call this first to avoid repeated re-allocation.
+     * @param count The number of values
+     */
+    void reserve(std::size_t count) {
+        mValues.reserve(count);
+    }
+
+    /**
+     * @return The number of bytes of heap memory allocated for the stored values.
+     */
+    std::size_t allocatedBytes() const {
+        return mValues.capacity() * sizeof(value_type);
     }
 
     /**
@@ -127,12 +159,23 @@ public:
         return get(key);
     }
 
-    typename std::map<T,Object>::const_iterator find(const T& key) const { return mValues.find(key); }
-    typename std::map<T,Object>::const_iterator begin() const { return mValues.begin(); }
-    typename std::map<T,Object>::const_iterator end() const { return mValues.end(); }
+    const_iterator find(const T& key) const {
+        auto it = std::lower_bound(mValues.begin(), mValues.end(), key, lessThanKey);
+        return it != mValues.end() && it->first == key ? it : mValues.end();
+    }
+
+    const_iterator begin() const { return mValues.begin(); }
+    const_iterator end() const { return mValues.end(); }
+
+private:
+    static bool lessThanKey(const value_type& lhs, const T& key) { return lhs.first < key; }
+
+    typename std::vector<value_type>::iterator lowerBound(T key) {
+        return std::lower_bound(mValues.begin(), mValues.end(), key, lessThanKey);
+    }
 
 private:
-    std::map<T, Object> mValues;
+    std::vector<value_type> mValues;   // Sorted by key
 };
 
 } // namespace apl
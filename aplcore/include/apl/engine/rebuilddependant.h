@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 
+#include "apl/engine/context.h"
 #include "apl/engine/dependant.h"
 #include "apl/engine/evaluate.h"
 
@@ -33,10 +34,11 @@ public:
         assert(!symbols.empty());
         assert(parentComponent);
 
-        auto dependant = std::make_shared<RebuildDependant>(parentComponent,
-                                                            downstream,
-                                                            sBindingFunctions.at(kBindingTypeBoolean),
-                                                            std::move(symbols));
+        auto dependant = makePooled<RebuildDependant>(downstream->objectPool(),
+                                                      parentComponent,
+                                                      downstream,
+                                                      sBindingFunctions.at(kBindingTypeBoolean),
+                                                      std::move(symbols));
         dependant->attach();
         // Register under "pseudo" upstream to disambiguate from any other upstreams.
         downstream->addUpstream("_SPECIAL_WHEN_CONDITIONAL", dependant);
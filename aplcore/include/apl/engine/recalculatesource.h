@@ -27,6 +27,10 @@ namespace apl {
 /**
  * A mixin class for objects where changing an element of this object will trigger recalculation of properties
  * on downstream objects.
+ *
+ * Downstream dependants are grouped by key and indexed by identity within each key, so that adding or removing
+ * a dependant does not require a linear scan when a single key fans out to a large number of dependants.
+ *
  * @tparam T The key type used to distinguish the various elements of this object.
  */
 template<class T>
@@ -41,37 +45,31 @@ public:
         // For now, we strip off the "/" section of the keys
         auto name = key.substr(0, key.find("/", 0));
 
-        // Don't add this pair if it already exists
-        // While we're searching, we check for weak pointers
-        auto dependants = mDownstream.equal_range(key);
-        auto it = dependants.first;
-        while (it != dependants.second) {
-            auto ptr = it->second.lock();
-            if (ptr) {
-                if (ptr == dependant) {
-                    LOG(LogLevel::kWarn) << "Attempted to add duplicate pair " << key;
-                    return;    // This pair already exists
-                }
-                it++;
-            } else {
-                LOG(LogLevel::kWarn) << "Unexpected released weak pointer";
-                it = mDownstream.erase(it);  // Throw it away
+        // Don't add this pair if it already exists.  A stale entry left by a released
+        // dependant at the same address is simply replaced.
+        auto& dependants = mDownstream[name];
+        auto it = dependants.find(dependant.get());
+        if (it != dependants.end()) {
+            if (!it->second.expired()) {
+                LOG(LogLevel::kWarn) << "Attempted to add duplicate pair " << key;
+                return;    // This pair already exists
             }
+            it->second = dependant;
+            return;
         }
 
-        mDownstream.emplace(name, dependant);
+        dependants.emplace(dependant.get(), dependant);
     }
 
     /**
-     * Remove this downstream dependant object.  Note that we also clear out
-     * any released weak_ptrs at the same time.
+     * Remove this downstream dependant object.
      * @param dependant The object to remove
      */
     void removeDownstream(const DependantPtr& dependant) {
         auto it = mDownstream.begin();
         while (it != mDownstream.end()) {
-            // TODO: Possible optimization by using owner_before comparison
-            if (it->second.expired() || it->second.lock() == dependant)
+            it->second.erase(dependant.get());
+            if (it->second.empty())
                 it = mDownstream.erase(it);
             else
                 it++;
@@ -83,18 +81,25 @@ public:
      * @param key The key that has changed.
      */
     void enqueueDownstream(T key) {
-        auto dependants = mDownstream.equal_range(key);
-        auto it = dependants.first;
-        while (it != dependants.second) {
+        auto dependants = mDownstream.find(key);
+        if (dependants == mDownstream.end())
+            return;
+
+        auto& map = dependants->second;
+        auto it = map.begin();
+        while (it != map.end()) {
             auto ptr = it->second.lock();
             if (ptr && ptr->enqueue()) {
                 it++;
             }
             else {
                 LOG(LogLevel::kWarn) << "Unexpected released weak pointer";
-                it = mDownstream.erase(it);
+                it = map.erase(it);
             }
         }
+
+        if (map.empty())
+            mDownstream.erase(dependants);
     }
 
     /**
@@ -103,18 +108,22 @@ public:
      * @return The number of downstream dependants.
      */
     size_t countDownstream(T key) {
-        return mDownstream.count(key);
+        auto it = mDownstream.find(key);
+        return it == mDownstream.end() ? 0 : it->second.size();
     }
 
     /**
      * @return The total number of downstream dependants connected to this source
      */
     size_t countDownstream() {
-        return mDownstream.size();
+        size_t result = 0;
+        for (const auto& m : mDownstream)
+            result += m.second.size();
+        return result;
     }
 
 private:
-    std::multimap<T, std::weak_ptr<Dependant>> mDownstream;
+    std::map<T, std::map<const Dependant*, std::weak_ptr<Dependant>>> mDownstream;
 };
 
 } // namespace apl
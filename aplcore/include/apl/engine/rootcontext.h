@@ -21,6 +21,7 @@
 #include "apl/content/rootconfig.h"
 #include "apl/content/settings.h"
 #include "apl/document/displaystate.h"
+#include "apl/engine/dirtypropertybuffer.h"
 #include "apl/engine/event.h"
 #include "apl/engine/info.h"
 #include "apl/focus/focusdirection.h"
@@ -43,6 +44,18 @@ class RootConfig;
 class TimeManager;
 struct PointerEvent;
 
+/**
+ * Work done by the most recent frame-budgeted RootContext::clearPending call.
+ */
+struct ClearPendingStats {
+    /// Number of live data objects flushed during the call
+    size_t flushed = 0;
+    /// Number of live data objects left over for a later call
+    size_t deferred = 0;
+    /// Wall-clock time spent in the call, in milliseconds
+    apl_duration_t elapsed = 0;
+};
+
 /**
  * Represents a top-level APL document.
  *
@@ -150,6 +163,26 @@ public:
      */
     virtual void clearPending() const = 0;
 
+    /**
+     * Frame-budgeted version of clearPending().  Live data changes are applied one data object at a
+     * time until the budget runs out; the remainder is deferred to the next call.  Timers, layout,
+     * media and visibility processing always complete for the changes that were applied, so the
+     * dirty set seen by the view host is consistent after every call.  At least one data object is
+     * flushed per call, even with a zero budget.
+     *
+     * Deferred changes are not applied by the implicit clearPending() inside hasEvent(), popEvent(),
+     * isDirty() and getDirty().  An explicit clearPending() call applies everything.
+     *
+     * @param budget The time available for this frame, in milliseconds.
+     * @return True if work was deferred and this method should be called again on the next frame.
+     */
+    virtual bool clearPending(apl_duration_t budget) const = 0;
+
+    /**
+     * @return Instrumentation for the most recent call to clearPending(apl_duration_t).
+     */
+    virtual ClearPendingStats getClearPendingStats() const = 0;
+
     /**
      * @return True if there is at least one queued event to be processed.
      */
@@ -193,6 +226,16 @@ public:
      */
     virtual const std::set<ComponentPtr>& getDirty() = 0;
 
+    /**
+     * External routine to get the changed properties of all of the dirty components in one flat
+     * buffer.  This is an alternative to calling getDirty() and serializing the dirty properties
+     * of each component; the buffer is reused between frames, so it does not allocate in the
+     * steady state.  The dirty flags are not cleared; call clearDirty() when the changes have
+     * been applied.
+     * @param buffer The buffer to fill.  Any previous records are removed.
+     */
+    virtual void getDirtyProperties(DirtyPropertyBuffer& buffer) = 0;
+
     /**
      * Clear all of the dirty flags.  This routine will clear all dirty
      * flags from child components.
@@ -23,6 +23,7 @@
 #include "apl/engine/jsonresource.h"
 #include "apl/engine/runtimestate.h"
 #include "apl/engine/styles.h"
+#include "apl/engine/symboltable.h"
 #include "apl/primitives/size.h"
 #include "apl/primitives/textmeasurerequest.h"
 #include "apl/scenegraph/common.h"
@@ -129,6 +130,12 @@ public:
 
     const YogaConfig& ygconfig() const { return mYogaConfig; }
 
+    /**
+     * @return The table of interned data-binding names shared by the contexts of every document
+     *         attached to this root.
+     */
+    const SymbolTablePtr& symbolTable() const { return mSymbolTable; }
+
     /**
      * @return The installed text measurement for this context.
      */
@@ -180,6 +187,7 @@ private:
     MediaPlayerFactoryPtr mMediaPlayerFactory;
 
     YogaConfig mYogaConfig;
+    SymbolTablePtr mSymbolTable;
     TextMeasurementPtr mTextMeasurement;
     int mScreenLockCount = 0;
 
@@ -0,0 +1,91 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ *
+ */
+
+#ifndef _APL_SYMBOL_TABLE_H
+#define _APL_SYMBOL_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "apl/utils/noncopyable.h"
+
+namespace apl {
+
+/**
+ * Interns the names used as data-binding keys.  Each distinct name is assigned a small integer
+ * "atom" the first time it is stored; contexts key their values on atoms so that lookups walking
+ * up the context chain compare integers instead of strings.  Atoms are only meaningful within
+ * the table that created them.  A single table is shared by every context that descends from the
+ * same top-level context.
+ */
+class SymbolTable : public NonCopyable {
+public:
+    using Atom = std::uint32_t;
+
+    /// Returned by find() for a name that has never been interned.
+    static const Atom NO_ATOM = UINT32_MAX;
+
+    /**
+     * Look up the atom for a name, assigning a new atom if the name has not been seen before.
+     * @param name The name
+     * @return The atom
+     */
+    Atom intern(const std::string& name) {
+        auto it = mAtoms.find(name);
+        if (it != mAtoms.end())
+            return it->second;
+
+        auto atom = static_cast<Atom>(mNames.size());
+        it = mAtoms.emplace(name, atom).first;
+        mNames.emplace_back(&it->first);
+        return atom;
+    }
+
+    /**
+     * Look up the atom for a name without interning it.
+     * @param name The name
+     * @return The atom or NO_ATOM if the name has never been interned.  A name that has never been
+     *         interned cannot be defined in any context using this table.
+     */
+    Atom find(const std::string& name) const {
+        auto it = mAtoms.find(name);
+        return it != mAtoms.end() ? it->second : NO_ATOM;
+    }
+
+    /**
+     * @param atom An atom created by this table
+     * @return The name of the atom
+     */
+    const std::string& name(Atom atom) const { return *mNames.at(atom); }
+
+    /**
+     * @return The number of interned names
+     */
+    size_t size() const { return mNames.size(); }
+
+private:
+    std::unordered_map<std::string, Atom> mAtoms;
+    std::vector<const std::string*> mNames;  // Points at the keys of mAtoms, which are stable
+};
+
+using SymbolTablePtr = std::shared_ptr<SymbolTable>;
+
+} // namespace apl
+
+#endif // _APL_SYMBOL_TABLE_H
@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 
+#include "apl/engine/context.h"
 #include "apl/engine/dependant.h"
 #include "apl/engine/evaluate.h"
 
@@ -44,12 +45,13 @@ public:
        assert(!symbols.empty());
        assert(downstream);
 
-       auto dependant = std::make_shared<TypedDependant<Downstream, Key>>(downstream,
-                                                                          downstreamKey,
-                                                                          std::move(expression),
-                                                                          bindingContext,
-                                                                          std::move(bindingFunction),
-                                                                          std::move(symbols));
+       auto dependant = makePooled<TypedDependant<Downstream, Key>>(bindingContext->objectPool(),
+                                                                    downstream,
+                                                                    downstreamKey,
+                                                                    std::move(expression),
+                                                                    bindingContext,
+                                                                    std::move(bindingFunction),
+                                                                    std::move(symbols));
        dependant->attach();
        downstream->addUpstream(downstreamKey, dependant);
    }
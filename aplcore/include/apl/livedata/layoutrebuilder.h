@@ -16,6 +16,9 @@
 #ifndef _APL_LAYOUT_REBUILDER_H
 #define _APL_LAYOUT_REBUILDER_H
 
+#include <map>
+#include <vector>
+
 #include "apl/common.h"
 #include "apl/utils/counter.h"
 #include "apl/utils/noncopyable.h"
@@ -89,6 +92,25 @@ public:
      */
     void inflateIfRequired(const CoreComponentPtr& child);
 
+    /**
+     * Release the inflated subtree of a child that has moved outside of the virtualization window.
+     * The child stays in place, holding its current size, and is inflated again by inflateIfRequired().
+     * @param child The child to deflate.
+     * @param useDirtyFlag True to notify the runtime about the removed children.
+     * @return True if the child was deflated.
+     */
+    bool deflate(const CoreComponentPtr& child, bool useDirtyFlag);
+
+    /**
+     * Release the children held for reuse by a layout with "-recycleItems" set.
+     */
+    void clearRecyclePool();
+
+    /**
+     * @return The number of removed children held for reuse.
+     */
+    size_t recyclePoolSize() const;
+
     /**
      * Notify rebuilder that particular data index is on screen.
      * @param idx The index of the item that is on screen.
@@ -135,7 +157,12 @@ public:
     std::shared_ptr<LiveArrayObject> getBackingArray() const { return mArray.lock(); }
 
 private:
+    friend class ChildWalker;
+
     ContextPtr buildBaseChildContext(const LiveArrayObjectPtr& array, size_t dataIndex, size_t insertIndex);
+    void removeChild(const CoreComponentPtr& layout, size_t index);
+    CoreComponentPtr reuseChild(const LiveArrayObjectPtr& array, const ContextPtr& childContext,
+                                size_t dataIndex, size_t insertIndex, int ordinal);
 
 private:
     ContextPtr mContext;
@@ -152,6 +179,9 @@ private:
 
     int mRebuilderToken;  // Unique token generated for each LayoutRebuilder.  Helps find where a rebuilder is active.
 
+    // Children removed from a recycling layout, keyed by the index of the "item" they were built from
+    std::map<int, std::vector<CoreComponentPtr>> mRecyclePool;
+
     static int sRebuilderToken;
 };
 
@@ -0,0 +1,79 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_LIVE_ARRAY_MAPPING_H
+#define _APL_LIVE_ARRAY_MAPPING_H
+
+#include <vector>
+
+#include "apl/livedata/livearraychange.h"
+
+namespace apl {
+
+/**
+ * A compacted form of the changes made to a LiveArray since the last flush.  The current array
+ * is described as an ordered list of runs.  Each run is either a block of newly inserted items or
+ * a block of items carried over from the old array, with a flag marking whether they were updated.
+ *
+ * The mapping is built once from the change list.  Each lookup is then a binary search over the
+ * runs, so mapping every index of the array costs O(items * log(runs)) instead of
+ * O(items * changes).
+ */
+class LiveArrayMapping {
+public:
+    using size_type = LiveArrayChange::size_type;
+
+    /**
+     * Build the mapping from a list of changes.
+     * @param changes The changes, in the order they were applied to the array.  REPLACE is not allowed.
+     * @param newSize The current size of the array, after all of the changes.
+     */
+    void build(const std::vector<LiveArrayChange>& changes, size_type newSize);
+
+    /**
+     * Map an index in the current array back to the index it had before the changes.
+     * @param index The current index in the array.
+     * @return A pair containing the old index and a flag that is true if the item was updated.  The
+     *         old index is -1 if the item was inserted.
+     */
+    std::pair<int, bool> newToOld(size_type index) const;
+
+    /**
+     * @return The number of runs needed to describe the changes.
+     */
+    size_t runCount() const { return mRuns.size(); }
+
+    /**
+     * @return The size of the array before the changes.
+     */
+    size_type oldSize() const { return mOldSize; }
+
+private:
+    struct Run {
+        size_type newStart;
+        size_type length;
+        int oldStart;  // -1 for inserted items
+        bool updated;
+    };
+
+    size_t splitAt(size_type position);
+
+    std::vector<Run> mRuns;
+    size_type mOldSize = 0;
+};
+
+} // namespace apl
+
+#endif // _APL_LIVE_ARRAY_MAPPING_H
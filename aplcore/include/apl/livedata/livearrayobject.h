@@ -20,6 +20,7 @@
 #include "apl/utils/counter.h"
 #include "apl/livedata/livedataobject.h"
 #include "apl/livedata/livearraychange.h"
+#include "apl/livedata/livearraymapping.h"
 
 namespace apl {
 
@@ -33,8 +34,9 @@ namespace apl {
  *
  * To observe when a LiveArrayObject is flushed, register a "flush" callback.
  *
- * TODO: All internal changes are stored in a single array.  It may be more efficient to collapse
- *       these into three vectors: "removed", "updated", and "inserted".
+ * The changes are stored in a single array in the order they arrived, which is what extensions
+ * are sent.  Index lookups from the layout rebuilder go through a LiveArrayMapping that is
+ * compacted from the change list the first time it is needed after a change.
  */
 class LiveArrayObject : public LiveDataObject, Counter<LiveArrayObject> {
 public:
@@ -109,6 +111,8 @@ private:
 private:
     LiveArrayPtr mLiveArray;
     std::vector<LiveArrayChange> mChanges;
+    LiveArrayMapping mMapping;
+    bool mMappingValid = false;
 };
 
 } // namespace apl
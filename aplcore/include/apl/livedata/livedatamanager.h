@@ -23,6 +23,7 @@
 
 namespace apl {
 
+class FrameBudget;
 class LiveDataObject;
 
 /**
@@ -46,6 +47,7 @@ public:
     void remove(const std::shared_ptr<LiveDataObject>& tracker) {
         mTrackers.erase(mTrackers.find(tracker));
         mDirty.erase(mDirty.find(tracker));
+        mDeferred.erase(tracker);
     }
 
     /**
@@ -57,10 +59,29 @@ public:
     }
 
     /**
-     * Flush all dirty changes associated with this data manager
+     * Flush all dirty changes associated with this data manager.  Trackers deferred by an earlier
+     * budgeted flush stay deferred unless they have been marked dirty again.
      */
     void flushDirty();
 
+    /**
+     * Flush dirty trackers one at a time until the frame budget expires.  Any trackers left over
+     * are deferred and picked up first by the next budgeted flush or by resumeDeferred().
+     * @param budget The frame budget to charge each flushed tracker against.
+     * @return The number of trackers flushed.
+     */
+    size_t flushDirty(FrameBudget& budget);
+
+    /**
+     * Return all deferred trackers to the dirty set so that the next flush processes them.
+     */
+    void resumeDeferred();
+
+    /**
+     * @return The number of trackers deferred by the last budgeted flush.
+     */
+    size_t deferred() const { return mDeferred.size(); }
+
     /**
      * @return The set of dirty trackers.
      */
@@ -78,6 +99,7 @@ public:
 private:
     SharedPtrSet<LiveDataObject> mTrackers;
     SharedPtrSet<LiveDataObject> mDirty;
+    SharedPtrSet<LiveDataObject> mDeferred;
 };
 
 } // namespace apl
@@ -83,10 +83,12 @@ public:
      * the course of flushing data, since they already have access to the latest data. Note that this assumes that live
      * data con only change outside of the data flushing stage. If we add a feature that allows the data flushing
      * pathway to modify the data in some way, we'll have to revisit this assumption.
+     *
+     * The downstream dependants of this object are queued here but not recalculated.  Because every dirty object
+     * is pre-flushed before any is flushed, the dependants of all changed objects are coalesced and recalculated
+     * in a single topological pass by the first call to flush().
      */
-    void preFlush() {
-        mMaxWatcherTokenBeforeFlush = mWatcherToken;
-    }
+    void preFlush();
 
     /**
      * Flush tracking changes
@@ -16,6 +16,7 @@
 #ifndef _APL_BOUND_SYMBOL_H
 #define _APL_BOUND_SYMBOL_H
 
+#include "apl/engine/symboltable.h"
 #include "apl/primitives/objecttype.h"
 
 namespace apl {
@@ -29,9 +30,7 @@ namespace apl {
 class BoundSymbol
 {
 public:
-    BoundSymbol(const ContextPtr& context, std::string name)
-        : mContext(context), mName(std::move(name))
-    {}
+    BoundSymbol(const ContextPtr& context, std::string name);
 
     ContextPtr getContext() const { return mContext.lock(); }
     std::string getName() const { return mName; }
@@ -63,6 +62,7 @@ public:
 private:
     std::weak_ptr<Context> mContext;
     std::string mName;
+    SymbolTable::Atom mAtom;  // The interned name in the symbol table of the context
 };
 
 } // namespace apl
@@ -39,13 +39,16 @@
 #include <map>
 #include <cmath>
 #include <cstdint>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "rapidjson/document.h"
 
 #include "apl/common.h"
 #include "apl/utils/deprecated.h"
+#include "apl/utils/flatmap.h"
 #include "apl/utils/visitor.h"
 
 #ifdef APL_CORE_UWP
@@ -70,7 +73,11 @@ class ObjectType;
 
 class streamer;
 
+#ifdef FLAT_OBJECT_MAP
+using ObjectMap = FlatMap<std::string, Object>;
+#else
 using ObjectMap = std::map<std::string, Object>;
+#endif
 using ObjectMapPtr = std::shared_ptr<ObjectMap>;
 using ObjectArray = std::vector<Object>;
 using ObjectArrayPtr = std::shared_ptr<ObjectArray>;
@@ -82,8 +89,9 @@ using ObjectArrayPtr = std::shared_ptr<ObjectArray>;
  * maps (for context and for JSONObject) and arrays (vectors or JSONArray).
  *
  * To avoid dynamic casting, the base object has methods for manipulating all of these
- * types.  The types that require additional storage put a shared_ptr in a single data
- * property.
+ * types.  Small, trivially copyable value types (rectangles, radii, 2D transforms) are
+ * stored in place.  The types that require additional storage put a shared_ptr in a
+ * single data property.
  *
  * Note that certain types stored in Objects are treated as immutable and certain types
  * are mutable.  Examples of immutable types are:
@@ -110,7 +118,8 @@ public:
         kStorageTypeValue,
         kStorageTypeString,
         kStorageTypeReference,
-        kStorageTypePointer
+        kStorageTypePointer,
+        kStorageTypeInline
     };
 
     // Constructors
@@ -148,6 +157,18 @@ public:
         >
     Object(T&& content) : mType(T::ObjectType::instance()), mU(T::ObjectType::createDirectObjectData(std::move(content))) {}
 
+    template<
+        class T,
+        StorageType ST = T::ObjectType::scStorageType,
+        typename = typename std::enable_if<ST == StorageType::kStorageTypeInline>::type
+        >
+    Object(const T& content) : mType(T::ObjectType::instance()) {
+        static_assert(sizeof(T) <= sizeof(DataHolder::inlined), "Inline type is too large");
+        static_assert(alignof(T) <= alignof(DataHolder), "Inline type is over-aligned");
+        static_assert(std::is_trivially_copyable<T>::value, "Inline type must be trivially copyable");
+        new(mU.inlined) T(content);
+    }
+
     Object(const std::shared_ptr<RangeGenerator>& range);
     Object(const std::shared_ptr<SliceGenerator>& slice);
 
@@ -229,6 +250,7 @@ public:
         double value;
         std::string string;
         std::shared_ptr<ObjectData> data;
+        unsigned char inlined[sizeof(std::string)];
 
         DataHolder() : value(0.0) {}
         DataHolder(double v) : value(v) {}
@@ -246,11 +268,14 @@ public:
     template<
         class T,
         StorageType ST = T::ObjectType::scStorageType,
-        typename = typename std::enable_if<ST == StorageType::kStorageTypeReference>::type
+        typename = typename std::enable_if<ST == StorageType::kStorageTypeReference ||
+                                           ST == StorageType::kStorageTypeInline>::type
         >
     const T& get() const {
         assert(is<T>());
-        return *static_cast<const T*>(extractDataInner(mU));
+        return *static_cast<const T*>(ST == StorageType::kStorageTypeInline
+                                          ? static_cast<const void*>(mU.inlined)
+                                          : extractDataInner(mU));
     }
 
     /**
@@ -304,6 +329,10 @@ public:
     // Mutable objects
     bool isMutable() const;
 
+    // JSON-backed MAP and ARRAY objects that own their document and have no data-binding expressions
+    // or resource references
+    bool isStaticJson() const;
+
     // BoundSymbol, and compiled ByteCodeInstruction objects
     Object eval() const;
 
@@ -16,6 +16,9 @@
 #ifndef _APL_OBJECT_DATA_H
 #define _APL_OBJECT_DATA_H
 
+#include <cstring>
+#include <iterator>
+
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
@@ -80,6 +83,13 @@ public:
      */
     virtual bool isMutable() const { return false; }
 
+    /**
+     * @return True if this object is read-only JSON that keeps its document alive and contains no
+     *         data-binding expressions or resource references.  Evaluating such an object returns
+     *         it unchanged.
+     */
+    virtual bool isStaticJson() const { return false; }
+
     /**
      * @return The evaluation of this object.  Most objects return NULL.
      */
@@ -165,8 +175,8 @@ protected:
         if (size() != rhs.size())
             return false;
 
-        auto left = getMap();
-        auto right = rhs.getMap();
+        const auto& left = getMap();
+        const auto& right = rhs.getMap();
         for (auto &m : left) {
             auto it = right.find(m.first);
             if (it == right.end())
@@ -400,13 +410,77 @@ public:
     virtual ~JSONBaseData() = default;
 
     bool operator==(const ObjectData& rhs) const override {
-        if (getJson()->IsObject()) {
-            return mapCompare(rhs);
-        } else if (getJson()->IsArray()) {
+        const auto& json = *getJson();
+        if (json.IsObject()) {
+            // Compare straight from the DOM rather than materializing the map
+            if (json.MemberCount() != rhs.size())
+                return false;
+
+            for (const auto& m : json.GetObject()) {
+                const std::string name(m.name.GetString(), m.name.GetStringLength());
+                if (!rhs.has(name) || Object(m.value) != rhs.get(name))
+                    return false;
+            }
+            return true;
+        } else if (json.IsArray()) {
             return arrayCompare(rhs);
         }
         return false;
     }
+
+    bool isStaticJson() const override {
+        if (mStaticJson < 0)
+            mStaticJson = isStaticValue(*getJson()) ? 1 : 0;
+        return mStaticJson != 0;
+    }
+
+protected:
+    /**
+     * Check a JSON value for strings that data-binding would change: embedded ${...} or #{...}
+     * expressions and "@" resource references.
+     */
+    static bool isStaticValue(const rapidjson::Value& value) { // NOLINT(misc-no-recursion)
+        switch (value.GetType()) {
+            case rapidjson::kStringType: {
+                const char *start = value.GetString();
+                const char *end = start + value.GetStringLength();
+                if (start != end && *start == '@')
+                    return false;
+
+                for (auto p = start; (p = static_cast<const char*>(std::memchr(p, '{', end - p))) != nullptr; p++)
+                    if (p != start && (p[-1] == '$' || p[-1] == '#'))
+                        return false;
+                return true;
+            }
+            case rapidjson::kObjectType:
+                for (const auto& m : value.GetObject())
+                    if (!isStaticValue(m.value))
+                        return false;
+                return true;
+            case rapidjson::kArrayType:
+                for (const auto& v : value.GetArray())
+                    if (!isStaticValue(v))
+                        return false;
+                return true;
+            default:
+                return true;
+        }
+    }
+
+    /**
+     * Copy the members of a JSON object into a map in a single range insert, which keeps
+     * conversion O(N log N) whichever ObjectMap representation is in use.
+     */
+    static void fillMap(ObjectMap& map, const rapidjson::Value& value) {
+        std::vector<std::pair<std::string, Object>> members;
+        members.reserve(value.MemberCount());
+        for (const auto& v : value.GetObject())
+            members.emplace_back(v.name.GetString(), v.value);
+        map.insert(std::make_move_iterator(members.begin()), std::make_move_iterator(members.end()));
+    }
+
+private:
+    mutable int mStaticJson = -1;  // Cached result of isStaticValue(); -1 until first checked
 };
 
 /****************************************************************************/
@@ -488,12 +562,11 @@ public:
         return mVector;
     }
 
-    const std::map<std::string, Object>& getMap() const override {
+    const ObjectMap& getMap() const override {
         assert(mValue->IsObject());
 
         if (mValue->MemberCount() != mMap.size())
-            for (const auto& v : mValue->GetObject())
-                const_cast<std::map<std::string, Object>&>(mMap).emplace(v.name.GetString(), v.value);
+            fillMap(const_cast<ObjectMap&>(mMap), *mValue);
         return mMap;
     }
 
@@ -505,6 +578,9 @@ public:
         return "JSON<" + std::string(buffer.GetString()) + ">";
     }
 
+    // A borrowed value may be released once evaluation is done, so it is never handed out as-is
+    bool isStaticJson() const override { return false; }
+
 protected:
     const rapidjson::Value* getJson() const override {
         return mValue;
@@ -512,7 +588,7 @@ protected:
 
 private:
     const rapidjson::Value *mValue;
-    const std::map<std::string, Object> mMap;
+    const ObjectMap mMap;
     const std::vector<Object> mVector;
 };
 
@@ -525,6 +601,8 @@ public:
         : JSONData(value),
           mDoc(std::move(doc)) { assert(value); }
 
+    bool isStaticJson() const override { return JSONBaseData::isStaticJson(); }
+
 private:
     const std::shared_ptr<rapidjson::Document> mDoc;
 };
@@ -608,12 +686,11 @@ public:
         return mVector;
     }
 
-    const std::map<std::string, Object>& getMap() const override {
+    const ObjectMap& getMap() const override {
         assert(mDoc.IsObject());
 
         if (mDoc.MemberCount() != mMap.size())
-            for (const auto& v : mDoc.GetObject())
-                const_cast<std::map<std::string, Object>&>(mMap).emplace(v.name.GetString(), v.value);
+            fillMap(const_cast<ObjectMap&>(mMap), mDoc);
         return mMap;
     }
 
@@ -628,7 +705,7 @@ protected:
 
 private:
     const rapidjson::Document mDoc;
-    const std::map<std::string, Object> mMap;
+    const ObjectMap mMap;
     const std::vector<Object> mVector;
 };
 
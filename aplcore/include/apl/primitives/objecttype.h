@@ -148,6 +148,9 @@ public:
     // Mutable objects
     virtual bool isMutable(const Object::DataHolder&) const { return false; }
 
+    // JSON-backed MAP and ARRAY objects
+    virtual bool isStaticJson(const Object::DataHolder&) const { return false; }
+
     // BoundSymbol, and compiled ByteCodeInstruction objects
     virtual Object eval(const Object::DataHolder&) const { aplThrow(NOT_SUPPORTED_ERROR); }
 
@@ -288,6 +291,42 @@ public:
     STORAGE_TYPE(kStorageTypeReference);
 };
 
+/**
+ * Object type for small, trivially copyable values that are stored directly in the Object
+ * rather than behind a shared ObjectData.  Copying such an Object never allocates.
+ */
+template<class T>
+class InlineObjectType : public virtual SimpleObjectType<T> {
+public:
+    bool truthy(const Object::DataHolder& dataHolder) const final {
+        return inner(dataHolder).truthy();
+    }
+
+    rapidjson::Value serialize(
+        const Object::DataHolder& dataHolder,
+        rapidjson::Document::AllocatorType& allocator) const final {
+        return inner(dataHolder).serialize(allocator);
+    }
+
+    std::string toDebugString(const Object::DataHolder& dataHolder) const final {
+        return inner(dataHolder).toDebugString();
+    }
+
+    bool equals(const Object::DataHolder& lhs, const Object::DataHolder& rhs) const override {
+        return inner(lhs) == inner(rhs);
+    }
+
+    bool empty(const Object::DataHolder& dataHolder) const override {
+        return inner(dataHolder).empty();
+    }
+
+    static const T& inner(const Object::DataHolder& dataHolder) {
+        return *reinterpret_cast<const T*>(dataHolder.inlined);
+    }
+
+    STORAGE_TYPE(kStorageTypeInline);
+};
+
 template<class T>
 class PointerHolderObjectType : public BaseObjectType<T> {
 public:
@@ -331,6 +370,10 @@ public:
         return dataHolder.data->isMutable();
     }
 
+    bool isStaticJson(const Object::DataHolder& dataHolder) const final {
+        return dataHolder.data->isStaticJson();
+    }
+
     void accept(const Object::DataHolder& dataHolder, Visitor<Object>& visitor) const final {
         dataHolder.data->accept(visitor);
     }
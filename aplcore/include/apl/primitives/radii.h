@@ -160,7 +160,7 @@ public:
     bool empty() const { return mData[0] == 0 && mData[1] == 0 && mData[2] == 0 && mData[3] == 0; }
     bool truthy() const { return !empty(); }
 
-    class ObjectType final : public ReferenceHolderObjectType<Radii> {};
+    class ObjectType final : public InlineObjectType<Radii> {};
 
 private:
     void sanitize();
@@ -273,7 +273,7 @@ public:
 
     std::string toDebugString() const;
 
-    class ObjectType final : public ReferenceHolderObjectType<Rect> {};
+    class ObjectType final : public InlineObjectType<Rect> {};
 
 private:
     float mX;
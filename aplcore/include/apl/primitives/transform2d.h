@@ -378,7 +378,7 @@ public:
 
     std::string toDebugString() const;
 
-    class ObjectType final : public ReferenceHolderObjectType<Transform2D> {};
+    class ObjectType final : public InlineObjectType<Transform2D> {};
 
 private:
     std::array<float, 6> mData;
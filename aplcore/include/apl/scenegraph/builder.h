@@ -23,10 +23,24 @@
 #include "apl/scenegraph/node.h"
 #include "apl/scenegraph/path.h"
 #include "apl/scenegraph/pathop.h"
+#include "apl/utils/noncopyable.h"
+#include "apl/utils/objectpool.h"
 
 namespace apl {
 namespace sg {
 
+/**
+ * While a scope is alive the builder functions below allocate from its pool.  Scopes nest and
+ * are tracked per thread, so scene graphs built on different threads do not share a pool.
+ */
+class BuilderPoolScope : public NonCopyable {
+public:
+    explicit BuilderPoolScope(const ObjectPoolPtr& pool);
+    ~BuilderPoolScope();
+
+private:
+    const ObjectPoolPtr *mPrevious;
+};
 
 class stroke {
 public:
@@ -24,6 +24,9 @@
 #include "apl/utils/noncopyable.h"
 
 namespace apl {
+
+class ObjectPool;
+
 namespace sg {
 
 class SceneGraphUpdates;
@@ -43,9 +46,19 @@ public:
 
     SceneGraphUpdates& updates() { return mUpdates; }
 
+    /**
+     * Allocate the layers, nodes, paths and paints built for this scene graph from an object pool
+     * instead of the global heap.  The pool is not thread-safe: the scene graph objects must be
+     * released on the thread that builds and updates the scene graph.
+     * @param pool The pool.  May be null.
+     */
+    void setObjectPool(const std::shared_ptr<ObjectPool>& pool) { mObjectPool = pool; }
+    const std::shared_ptr<ObjectPool>& getObjectPool() const { return mObjectPool; }
+
     rapidjson::Value serialize(rapidjson::Document::AllocatorType& allocator) const;
 
 private:
+    std::shared_ptr<ObjectPool> mObjectPool;
     LayerPtr mTopLayer;
     SceneGraphUpdates mUpdates;
     Size mViewportSize;
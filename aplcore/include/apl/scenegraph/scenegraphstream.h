@@ -0,0 +1,223 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_SG_SCENE_GRAPH_STREAM_H
+#define _APL_SG_SCENE_GRAPH_STREAM_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "apl/primitives/point.h"
+#include "apl/primitives/rect.h"
+#include "apl/primitives/size.h"
+#include "apl/primitives/transform2d.h"
+#include "apl/scenegraph/common.h"
+
+namespace apl {
+namespace sg {
+
+/**
+ * Encodes the per-frame changes of a scene graph into a single binary buffer.
+ *
+ * The view host calls RootContext::getSceneGraph() once per frame and then passes the scene graph
+ * to encode().  The first buffer holds every layer; each later buffer only holds the layers that
+ * were created, changed or removed since the previous call.  A SceneGraphDecoder, typically in
+ * another process, applies the buffers in order to rebuild the layer tree.
+ *
+ * The encoder must see every frame.  If a frame is skipped (or a buffer is lost) call reset() so
+ * that the next buffer holds the complete scene graph again.
+ *
+ * Layout (version 1, all numbers are little-endian):
+ *
+ *     "APLS" version:u8 frameFlags:u8 reserved:u16 frame:u32 topLayer:u32
+ *     viewportWidth:f32 viewportHeight:f32 recordCount:u32
+ *     record*
+ *
+ *     record := type:u8 layerId:u32 payload
+ *         create     name-length:u32 name properties     Every property is present
+ *         update     properties                          Only changed properties are present
+ *         remove     No payload.  The layer is no longer in the scene graph.
+ *
+ *     properties := mask:u16 interaction:u8 characteristics:u8 then, in mask bit order (the
+ *                   bits are the Layer::Flags values):
+ *         opacity                 f32
+ *         position or size        bounds as 4 x f32
+ *         transform               6 x f32
+ *         child offset            2 x f32
+ *         outline                 blob
+ *         content                 content offset as 2 x f32, then blob
+ *         shadow                  blob
+ *         children                count:u32 { layerId:u32 }*
+ *         child clip              blob
+ *         accessibility           blob
+ *
+ *     blob := length:u32 bytes    A PackedJson encoding of the serialized value; length 0 if unset
+ *
+ * Layer ids are assigned by the encoder and are never reused within a stream.  The frameFlags
+ * reset bit tells the decoder to discard every layer it holds before applying the records.
+ */
+class SceneGraphEncoder {
+public:
+    /// Current version of the binary layout
+    static const int VERSION = 1;
+
+    /**
+     * Encode the changes since the last call.
+     * @param sceneGraph The scene graph just returned by RootContext::getSceneGraph().
+     * @param out Buffer to write into.  It is cleared first; reusing the same buffer each frame
+     *            avoids reallocating it.
+     */
+    void encode(SceneGraph& sceneGraph, std::string& out);
+
+    /**
+     * Forget all layers.  The next call to encode() writes the entire scene graph.
+     */
+    void reset();
+
+    /**
+     * @return The number of layers the decoder is expected to hold.
+     */
+    size_t getLayerCount() const { return mLayers.size(); }
+
+private:
+    struct Tracked {
+        LayerPtr layer;
+        std::uint32_t id;
+        std::uint32_t parent = 0;
+        bool pending = true;   // Queued for a create record in this frame
+        std::vector<std::uint32_t> children;
+    };
+
+    std::uint32_t track(const LayerPtr& layer);
+    void writeCreate(Tracked& tracked);
+    void writeUpdate(Tracked& tracked, std::uint16_t mask);
+    void writeProperties(Tracked& tracked, std::uint16_t mask);
+    void writeChildren(Tracked& tracked);
+    void writeBlob(const rapidjson::Value& value);
+    void writeEmptyBlob();
+    void remove(std::uint32_t id);
+
+private:
+    std::unordered_map<const Layer*, Tracked> mLayers;
+    std::unordered_map<std::uint32_t, const Layer*> mById;
+    std::vector<const Layer*> mPending;
+    std::vector<std::uint32_t> mDetached;
+    LayerPtr mTop;
+    std::uint32_t mNextId = 1;
+    std::uint32_t mFrame = 0;
+    std::uint32_t mRecords = 0;
+    bool mNeedsReset = true;
+    std::string *mOut = nullptr;
+    rapidjson::Document::AllocatorType mAllocator;
+};
+
+/**
+ * Rebuilds a layer tree from the buffers written by a SceneGraphEncoder.  The decoder does not
+ * create Layer or Node objects; it keeps the decoded properties of each layer so that a renderer
+ * can read them directly.  Node content, outlines, clipping paths, shadows and accessibility
+ * information are kept in their packed form and expanded on request.
+ */
+class SceneGraphDecoder {
+public:
+    struct LayerState {
+        std::string name;
+        Rect bounds;
+        float opacity = 1.0f;
+        Transform2D transform;
+        Point childOffset;
+        Point contentOffset;
+        std::uint8_t interaction = 0;
+        std::uint8_t characteristics = 0;
+        std::vector<std::uint32_t> children;
+
+        // PackedJson encodings; empty if not set
+        std::string outline;
+        std::string content;
+        std::string shadow;
+        std::string childClip;
+        std::string accessibility;
+    };
+
+    /**
+     * Apply one buffer.  After a failure the decoder state is undefined; call reset() and have the
+     * encoder reset as well.
+     * @param data The buffer.
+     * @param length The buffer length in bytes.
+     * @return True if the buffer was applied.
+     */
+    bool decode(const char *data, size_t length);
+
+    /**
+     * Discard all layers.
+     */
+    void reset();
+
+    /**
+     * @return A description of the last decoding failure.
+     */
+    const std::string& error() const { return mError; }
+
+    /**
+     * @return The frame number of the last buffer applied.
+     */
+    std::uint32_t getFrame() const { return mFrame; }
+
+    /**
+     * @return The id of the top layer, or 0 if there is none.
+     */
+    std::uint32_t getTopLayer() const { return mTopLayer; }
+
+    /**
+     * @return The viewport size.
+     */
+    Size getViewportSize() const { return mViewportSize; }
+
+    /**
+     * @param id The layer id.
+     * @return The layer or nullptr if there is no such layer.
+     */
+    const LayerState *getLayer(std::uint32_t id) const;
+
+    /**
+     * @return The number of layers held.
+     */
+    size_t getLayerCount() const { return mLayers.size(); }
+
+    /**
+     * Serialize the decoded tree in the same format as SceneGraph::serialize().
+     * @param allocator RapidJSON memory allocator
+     * @return The serialized value
+     */
+    rapidjson::Value serialize(rapidjson::Document::AllocatorType& allocator) const;
+
+private:
+    rapidjson::Value serializeLayer(std::uint32_t id, rapidjson::Document::AllocatorType& allocator) const;
+
+private:
+    std::unordered_map<std::uint32_t, LayerState> mLayers;
+    std::uint32_t mFrame = 0;
+    std::uint32_t mTopLayer = 0;
+    Size mViewportSize;
+    std::string mError;
+};
+
+} // namespace sg
+} // namespace apl
+
+#endif // _APL_SG_SCENE_GRAPH_STREAM_H
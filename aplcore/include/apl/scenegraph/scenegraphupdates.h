@@ -18,7 +18,7 @@
 
 #include <functional>
 #include <memory>
-#include <set>
+#include <vector>
 
 #include "apl/scenegraph/common.h"
 
@@ -31,6 +31,10 @@ namespace sg {
  * can end up creating some new children and later updating them based on the dirty component
  * hierarchy (for example, a pager will create the new layer being paged in, then call update
  * on that newly created page because the _component_ hierarchy had the new page marked as dirty).
+ *
+ * The layers are tracked in vectors that keep their capacity between frames, so recording the
+ * changes of a frame does not allocate once the vectors have grown.  Duplicates are removed, and
+ * created layers are dropped from the changed list, before the lists are read.
  */
 class SceneGraphUpdates {
 public:
@@ -50,9 +54,12 @@ public:
     void processResize();
 
 private:
-    std::set<LayerPtr> mChanged;
-    std::set<LayerPtr> mCreated;
-    std::set<LayerPtr> mResize;
+    void normalize();
+
+    std::vector<LayerPtr> mChanged;
+    std::vector<LayerPtr> mCreated;
+    std::vector<LayerPtr> mResize;
+    bool mNormalized = true;
 };
 
 } // namespace sg
@@ -16,20 +16,160 @@
 #ifndef _APL_TEXT_LAYOUT_CACHE_H
 #define _APL_TEXT_LAYOUT_CACHE_H
 
+#include <algorithm>
+#include <cstdint>
+
+#include "apl/primitives/textmeasurerequest.h"
 #include "apl/scenegraph/common.h"
+#include "apl/scenegraph/textlayout.h"
+#include "apl/utils/lrucache.h"
 #include "apl/utils/weakcache.h"
 
 namespace apl {
 namespace sg {
 
 /**
-* Basic cache implementation for the TextLayout cache.
-* We wrap this in a class rather than directly exposing WeakCache to give ourselves
-* options for changing it in the future.
-*/
-class TextLayoutCache : public WeakCache<TextMeasureRequest, TextLayout> {};
+ * Two-tier cache of text layouts keyed by measurement request.
+ *
+ * The first tier is a weak cache: a layout stays available for as long as some component holds it.
+ * Behind it sits a strong LRU tier that keeps recently inserted layouts alive after the components
+ * have dropped them (for example, when a sequence item is scrolled out of view and released).  The
+ * strong tier is bounded by an approximate byte budget; a budget of zero disables it.
+ */
+class TextLayoutCache {
+public:
+    struct Stats {
+        size_t hits = 0;          // Found in the weak tier and still in use elsewhere
+        size_t strongHits = 0;    // Found only because the strong tier kept the layout alive
+        size_t misses = 0;
+        size_t evictions = 0;     // Layouts dropped from the strong tier to stay within budget
+        size_t evictedBytes = 0;
+    };
+
+    /**
+     * @param byteBudget Approximate number of bytes the strong tier may hold
+     */
+    explicit TextLayoutCache(size_t byteBudget = 0) : mStrong(SIZE_MAX), mByteBudget(byteBudget) {}
+
+    /**
+     * Find a layout in the cache.
+     * @param key The measurement request
+     * @return The layout or nullptr
+     */
+    TextLayoutPtr find(const TextMeasureRequest& key) {
+        auto layout = mWeak.find(key);
+        if (mStrong.has(key)) {
+            const auto& held = mStrong.get(key).first;  // Also refreshes the LRU position
+
+            // Nothing but the strong tier owns this layout, so without it this would have been a miss
+            if (!layout || (layout == held && layout.use_count() == 2)) {
+                mStats.strongHits++;
+                if (!layout) {
+                    layout = held;
+                    mWeak.insert(key, layout);
+                }
+                return layout;
+            }
+        }
+
+        if (layout) {
+            mStats.hits++;
+            return layout;
+        }
+
+        mStats.misses++;
+        return nullptr;
+    }
+
+    /**
+     * Insert a layout into the cache, evicting older layouts from the strong tier as needed.
+     * @param key The measurement request
+     * @param layout The layout
+     */
+    void insert(const TextMeasureRequest& key, const TextLayoutPtr& layout) {
+        mWeak.insert(key, layout);
+        if (mByteBudget == 0 || !layout)
+            return;
+
+        if (mStrong.has(key))
+            mBytes -= mStrong.get(key).second;
+
+        auto bytes = estimateBytes(*layout);
+        mStrong.put(key, {layout, bytes});
+        mBytes += bytes;
+        trim();
+    }
+
+    /**
+     * Change the byte budget of the strong tier.
+     * @param byteBudget Approximate number of bytes.  Zero disables the strong tier.
+     */
+    void setByteBudget(size_t byteBudget) {
+        mByteBudget = byteBudget;
+        trim();
+    }
+
+    size_t getByteBudget() const { return mByteBudget; }
+
+    /**
+     * @return The approximate number of bytes held by the strong tier
+     */
+    size_t getBytes() const { return mBytes; }
+
+    /**
+     * @return The number of layouts held by the strong tier
+     */
+    size_t getStrongSize() const { return mStrong.size(); }
+
+    /**
+     * @return Hit, miss and eviction counts since the cache was created
+     */
+    const Stats& getStats() const { return mStats; }
+
+    /**
+     * Clean the weak tier - remove all expired items
+     */
+    void clean() { mWeak.clean(); }
+
+    /**
+     * @return The number of live layouts in the weak tier.  This method will clean the weak tier.
+     */
+    size_t size() { return mWeak.size(); }
+
+    /**
+     * @return True if the weak tier is empty.  This method will clean the weak tier.
+     */
+    bool empty() { return mWeak.empty(); }
+
+    /**
+     * Rough memory cost of a text layout: a fixed overhead for the layout object, plus the text
+     * and per-line bookkeeping.  Runtimes hold glyph data as well, so this errs on the low side.
+     * @param layout The layout
+     * @return The approximate number of bytes
+     */
+    static size_t estimateBytes(const TextLayout& layout) {
+        return 256 + 4 * layout.getByteLength() + 64 * std::max(layout.getLineCount(), 0);
+    }
+
+private:
+    void trim() {
+        while (mBytes > mByteBudget && !mStrong.empty()) {
+            auto bytes = mStrong.popLeastRecent().second.second;
+            mBytes -= bytes;
+            mStats.evictions++;
+            mStats.evictedBytes += bytes;
+        }
+    }
+
+private:
+    WeakCache<TextMeasureRequest, TextLayout> mWeak;
+    LruCache<TextMeasureRequest, std::pair<TextLayoutPtr, size_t>> mStrong;
+    size_t mByteBudget;
+    size_t mBytes = 0;
+    Stats mStats;
+};
 
 } // namespace sg
 } // namespace apl
 
-#endif // _APL_TEXT_PROPERTIES_CACHE_H
+#endif // _APL_TEXT_LAYOUT_CACHE_H
@@ -0,0 +1,74 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_FRAME_BUDGET_H
+#define _APL_FRAME_BUDGET_H
+
+#include <chrono>
+
+#include "apl/common.h"
+
+namespace apl {
+
+/**
+ * A wall-clock deadline for work done on behalf of a single frame.  Work loops check expired()
+ * before starting each unit of work and call recordUnit() when it completes.  The budget never
+ * reports expiry before the first unit has been recorded, so every frame makes forward progress
+ * even when the budget is zero.
+ */
+class FrameBudget {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @param budget The time allowed for this frame, in milliseconds.
+     */
+    explicit FrameBudget(apl_duration_t budget)
+        : mStart(clock::now()),
+          mDeadline(mStart + std::chrono::duration_cast<clock::duration>(
+                                 std::chrono::duration<apl_duration_t, std::milli>(budget < 0 ? 0 : budget)))
+    {}
+
+    /**
+     * @return True if at least one unit of work has been done and the deadline has passed.
+     */
+    bool expired() const { return mUnits > 0 && clock::now() >= mDeadline; }
+
+    /**
+     * Record that a unit of work has been completed.
+     */
+    void recordUnit() { mUnits++; }
+
+    /**
+     * @return The number of units of work recorded against this budget.
+     */
+    size_t units() const { return mUnits; }
+
+    /**
+     * @return The time in milliseconds since this budget was created.
+     */
+    apl_duration_t elapsed() const {
+        return std::chrono::duration<apl_duration_t, std::milli>(clock::now() - mStart).count();
+    }
+
+private:
+    clock::time_point mStart;
+    clock::time_point mDeadline;
+    size_t mUnits = 0;
+};
+
+} // namespace apl
+
+#endif // _APL_FRAME_BUDGET_H
@@ -45,6 +45,10 @@ const std::string REBUILD_LAST_ITEMS = "__lastItems";
 const std::string REBUILD_ITEMS = "__items";
 /// Source index value for non-live data controlled children
 const std::string REBUILD_SOURCE_INDEX = "__sourceIndex";
+/// Index of the "item" selected for a child by evaluating the "when" clauses
+const std::string REBUILD_ITEM_INDEX = "__itemIndex";
+/// Item definition kept by an inflated child of a virtualizing layout so that it can be re-inflated
+const std::string REBUILD_VIRTUAL_ITEM = "__virtualItem";
 
 } // namespace apl
 
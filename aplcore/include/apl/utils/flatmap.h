@@ -0,0 +1,224 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_FLAT_MAP_H
+#define _APL_FLAT_MAP_H
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "apl/utils/throw.h"
+
+namespace apl {
+
+/**
+ * An associative container with the std::map interface, stored as a vector of key-value pairs
+ * sorted by key.  Lookups are a binary search over contiguous memory, iteration is in key order
+ * (so positional access such as Object::keyAt() is constant time), and a map of N entries is a
+ * single allocation rather than N tree nodes.
+ *
+ * Unlike std::map, inserting or erasing an element invalidates all iterators and references
+ * into the map.  Inserting a single key into the middle of a large map is linear; use the range
+ * insert() when adding many keys at once.
+ *
+ * @tparam Key The key type
+ * @tparam T The mapped type
+ * @tparam Compare The ordering of the keys
+ */
+template<class Key, class T, class Compare = std::less<Key>>
+class FlatMap {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using container_type = std::vector<value_type>;
+    using size_type = typename container_type::size_type;
+    using difference_type = typename container_type::difference_type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+    using reverse_iterator = typename container_type::reverse_iterator;
+    using const_reverse_iterator = typename container_type::const_reverse_iterator;
+
+    FlatMap() = default;
+    FlatMap(std::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+
+    template<class InputIt>
+    FlatMap(InputIt first, InputIt last) { insert(first, last); }
+
+    iterator begin() noexcept { return mData.begin(); }
+    const_iterator begin() const noexcept { return mData.begin(); }
+    const_iterator cbegin() const noexcept { return mData.cbegin(); }
+    iterator end() noexcept { return mData.end(); }
+    const_iterator end() const noexcept { return mData.end(); }
+    const_iterator cend() const noexcept { return mData.cend(); }
+    reverse_iterator rbegin() noexcept { return mData.rbegin(); }
+    const_reverse_iterator rbegin() const noexcept { return mData.rbegin(); }
+    reverse_iterator rend() noexcept { return mData.rend(); }
+    const_reverse_iterator rend() const noexcept { return mData.rend(); }
+
+    bool empty() const noexcept { return mData.empty(); }
+    size_type size() const noexcept { return mData.size(); }
+    void clear() noexcept { mData.clear(); }
+    void reserve(size_type capacity) { mData.reserve(capacity); }
+
+    iterator lower_bound(const Key& key) {
+        return std::lower_bound(mData.begin(), mData.end(), key, KeyLess(mCompare));
+    }
+
+    const_iterator lower_bound(const Key& key) const {
+        return std::lower_bound(mData.begin(), mData.end(), key, KeyLess(mCompare));
+    }
+
+    iterator upper_bound(const Key& key) {
+        return std::upper_bound(mData.begin(), mData.end(), key, KeyLess(mCompare));
+    }
+
+    const_iterator upper_bound(const Key& key) const {
+        return std::upper_bound(mData.begin(), mData.end(), key, KeyLess(mCompare));
+    }
+
+    iterator find(const Key& key) {
+        auto it = lower_bound(key);
+        return it != mData.end() && !mCompare(key, it->first) ? it : mData.end();
+    }
+
+    const_iterator find(const Key& key) const {
+        auto it = lower_bound(key);
+        return it != mData.end() && !mCompare(key, it->first) ? it : mData.end();
+    }
+
+    size_type count(const Key& key) const { return find(key) != mData.end() ? 1 : 0; }
+
+    T& at(const Key& key) {
+        auto it = find(key);
+        if (it == mData.end())
+            aplThrow("FlatMap::at key not found");
+        return it->second;
+    }
+
+    const T& at(const Key& key) const {
+        auto it = find(key);
+        if (it == mData.end())
+            aplThrow("FlatMap::at key not found");
+        return it->second;
+    }
+
+    T& operator[](const Key& key) {
+        auto it = lower_bound(key);
+        if (it == mData.end() || mCompare(key, it->first))
+            it = mData.emplace(it, key, T());
+        return it->second;
+    }
+
+    T& operator[](Key&& key) {
+        auto it = lower_bound(key);
+        if (it == mData.end() || mCompare(key, it->first))
+            it = mData.emplace(it, std::move(key), T());
+        return it->second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        auto it = lower_bound(value.first);
+        if (it != mData.end() && !mCompare(value.first, it->first))
+            return {it, false};
+        return {mData.insert(it, value), true};
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        auto it = lower_bound(value.first);
+        if (it != mData.end() && !mCompare(value.first, it->first))
+            return {it, false};
+        return {mData.insert(it, std::move(value)), true};
+    }
+
+    iterator insert(const_iterator, const value_type& value) { return insert(value).first; }
+    iterator insert(const_iterator, value_type&& value) { return insert(std::move(value)).first; }
+
+    /**
+     * Insert a range of elements.  As with std::map, keys that are already present (or repeated
+     * within the range) keep their first value.  The range is appended and the map re-sorted once,
+     * so bulk construction is O(N log N).
+     */
+    template<class InputIt>
+    void insert(InputIt first, InputIt last) {
+        auto existing = mData.size();
+        mData.insert(mData.end(), first, last);
+        if (mData.size() == existing)
+            return;
+
+        KeyLess less(mCompare);
+        std::stable_sort(mData.begin(), mData.end(), less);
+        mData.erase(std::unique(mData.begin(), mData.end(),
+                                [&](const value_type& lhs, const value_type& rhs) {
+                                    return !less(lhs, rhs) && !less(rhs, lhs);
+                                }),
+                    mData.end());
+    }
+
+    void insert(std::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    template<class... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return insert(value_type(std::forward<Args>(args)...)).first;
+    }
+
+    size_type erase(const Key& key) {
+        auto it = find(key);
+        if (it == mData.end())
+            return 0;
+        mData.erase(it);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos) { return mData.erase(pos); }
+    iterator erase(iterator pos) { return mData.erase(pos); }
+    iterator erase(const_iterator first, const_iterator last) { return mData.erase(first, last); }
+
+    void swap(FlatMap& other) noexcept {
+        mData.swap(other.mData);
+        std::swap(mCompare, other.mCompare);
+    }
+
+    friend bool operator==(const FlatMap& lhs, const FlatMap& rhs) { return lhs.mData == rhs.mData; }
+    friend bool operator!=(const FlatMap& lhs, const FlatMap& rhs) { return lhs.mData != rhs.mData; }
+    friend bool operator<(const FlatMap& lhs, const FlatMap& rhs) { return lhs.mData < rhs.mData; }
+
+private:
+    struct KeyLess {
+        explicit KeyLess(const Compare& compare) : compare(compare) {}
+        bool operator()(const value_type& lhs, const value_type& rhs) const { return compare(lhs.first, rhs.first); }
+        bool operator()(const value_type& lhs, const Key& rhs) const { return compare(lhs.first, rhs); }
+        bool operator()(const Key& lhs, const value_type& rhs) const { return compare(lhs, rhs.first); }
+        const Compare& compare;
+    };
+
+    container_type mData;
+    Compare mCompare;
+};
+
+} // namespace apl
+
+#endif // _APL_FLAT_MAP_H
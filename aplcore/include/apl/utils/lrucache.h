@@ -16,6 +16,7 @@
 #ifndef _APL_LRU_CACHE_H
 #define _APL_LRU_CACHE_H
 
+#include <cassert>
 #include <list>
 #include <unordered_map>
 
@@ -30,6 +31,12 @@ public:
     LruCache(size_t sizeLimit) : mMaxSize(sizeLimit) {}
 
     void put(K id, V item) {
+        auto it = mAccess.find(id);
+        if (it != mAccess.end()) {
+            mItems.erase(it->second);
+            mAccess.erase(it);
+        }
+
         mItems.push_front({id, item});
         if (mItems.size() > mMaxSize) {
             auto& removedItem = mItems.back();
@@ -50,6 +57,26 @@ public:
         return mItems.front().second;
     }
 
+    /**
+     * Remove the least recently used item.  The cache must not be empty.
+     * @return The removed key and value
+     */
+    std::pair<K, V> popLeastRecent() {
+        assert(!mItems.empty());
+        auto result = std::move(mItems.back());
+        mAccess.erase(result.first);
+        mItems.pop_back();
+        return result;
+    }
+
+    size_t size() const { return mItems.size(); }
+    bool empty() const { return mItems.empty(); }
+
+    void clear() {
+        mAccess.clear();
+        mItems.clear();
+    }
+
 private:
     using itemPack = std::pair<K, V>;
     std::list<itemPack> mItems;
@@ -0,0 +1,155 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_OBJECT_POOL_H
+#define _APL_OBJECT_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "apl/utils/noncopyable.h"
+
+namespace apl {
+
+/**
+ * A size-class pool for the small, short-lived heap objects created while inflating a document
+ * (contexts, dependants, binding arrays and maps).  Memory is carved out of large chunks and
+ * recycled through per-size free lists; chunks are only returned to the system when the pool
+ * itself is destroyed.
+ *
+ * The pool is not thread-safe.  It is owned by a single document and every allocator holds a
+ * shared reference to it, so the pool stays alive until the last pooled object has been released.
+ */
+class ObjectPool : public NonCopyable {
+public:
+    /// Allocation granularity.  Also the alignment guaranteed for pooled blocks.
+    static const size_t GRANULARITY;
+    /// Requests larger than this go straight to the global heap
+    static const size_t MAX_POOLED_SIZE;
+    /// Size of each chunk requested from the global heap
+    static const size_t CHUNK_SIZE;
+
+    struct Stats {
+        /// Number of blocks handed out by the pool
+        size_t allocations = 0;
+        /// Number of blocks returned to the pool
+        size_t deallocations = 0;
+        /// Number of allocations that were satisfied from a free list
+        size_t reused = 0;
+        /// Number of requests that were too large and fell back to the global heap
+        size_t oversized = 0;
+        /// Bytes currently handed out
+        size_t bytesInUse = 0;
+        /// High-water mark of bytesInUse
+        size_t peakBytesInUse = 0;
+        /// Total bytes of chunk memory requested from the global heap
+        size_t reservedBytes = 0;
+    };
+
+    ObjectPool() = default;
+    ~ObjectPool();
+
+    /**
+     * Allocate a block of memory.
+     * @param bytes The number of bytes required.
+     * @return A pointer to memory aligned to at least GRANULARITY bytes.
+     */
+    void *allocate(size_t bytes);
+
+    /**
+     * Return a block of memory to the pool.
+     * @param ptr The block returned by allocate().
+     * @param bytes The size originally passed to allocate().
+     */
+    void deallocate(void *ptr, size_t bytes);
+
+    /**
+     * @return Allocation statistics for this pool.
+     */
+    const Stats& getStats() const { return mStats; }
+
+private:
+    struct FreeNode {
+        FreeNode *next;
+    };
+
+    static size_t sizeClass(size_t bytes) { return (bytes + GRANULARITY - 1) / GRANULARITY; }
+
+    void *carve(size_t bytes);
+
+    std::vector<FreeNode *> mFreeLists;
+    std::vector<void *> mChunks;
+    char *mCursor = nullptr;
+    char *mEnd = nullptr;
+    Stats mStats;
+};
+
+using ObjectPoolPtr = std::shared_ptr<ObjectPool>;
+
+/**
+ * Standard allocator adapter over an ObjectPool, for use with std::allocate_shared.  Each copy
+ * holds a reference to the pool, so the pool outlives any control block allocated from it.
+ */
+template<class T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(ObjectPoolPtr pool) : mPool(std::move(pool)) {}
+
+    template<class U>
+    PoolAllocator(const PoolAllocator<U>& other) : mPool(other.pool()) {}
+
+    T *allocate(size_t n) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types cannot be pooled");
+        return static_cast<T *>(mPool->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, size_t n) {
+        mPool->deallocate(ptr, n * sizeof(T));
+    }
+
+    const ObjectPoolPtr& pool() const { return mPool; }
+
+    template<class U>
+    bool operator==(const PoolAllocator<U>& rhs) const { return mPool == rhs.pool(); }
+
+    template<class U>
+    bool operator!=(const PoolAllocator<U>& rhs) const { return mPool != rhs.pool(); }
+
+private:
+    ObjectPoolPtr mPool;
+};
+
+/**
+ * Create a shared object, allocating it from the pool when one is supplied.
+ * @param pool The pool to allocate from.  May be null.
+ * @param args Constructor arguments
+ * @return The shared pointer
+ */
+template<class T, class... Args>
+std::shared_ptr<T>
+makePooled(const ObjectPoolPtr& pool, Args&&... args)
+{
+    if (pool)
+        return std::allocate_shared<T>(PoolAllocator<T>(pool), std::forward<Args>(args)...);
+    return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+} // namespace apl
+
+#endif // _APL_OBJECT_POOL_H
@@ -77,6 +77,8 @@ public:
 
     bool isAborted() const override;
 
+    const Point *getSearchPoint() const override { return &mGlobalPoint; }
+
     /**
      * @return The found component or nullptr if no satisfactory component could be found.
      */
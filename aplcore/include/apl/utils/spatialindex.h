@@ -0,0 +1,131 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef _APL_SPATIAL_INDEX_H
+#define _APL_SPATIAL_INDEX_H
+
+#include <cstdint>
+#include <vector>
+
+#include "apl/primitives/point.h"
+#include "apl/primitives/rect.h"
+
+namespace apl {
+
+/**
+ * A uniform grid over a fixed list of rectangles, used to answer "which rectangles contain this
+ * point" and "which rectangles intersect this region" without testing every rectangle.
+ *
+ * The rectangles are identified by their position in the list passed to build().  Empty
+ * rectangles are never returned.  Rectangles that cover a large part of the grid are kept in a
+ * separate list that every query checks, so that a few large boxes (for example, full-size
+ * backgrounds) do not fill every cell.
+ *
+ * Queries do not allocate memory once the index has been built.  The index is not thread-safe.
+ */
+class SpatialIndex {
+public:
+    /// A rectangle that overlaps more than this many cells is stored in the "large" list
+    static const size_t MAX_CELLS_PER_BOX = 16;
+
+    /**
+     * Replace the indexed rectangles.
+     * @param boxes The rectangles.  Query results refer to positions in this list.
+     */
+    void build(std::vector<Rect>&& boxes);
+
+    /**
+     * Remove all rectangles.
+     */
+    void clear();
+
+    /**
+     * @return The number of rectangles passed to build().
+     */
+    size_t size() const { return mBoxes.size(); }
+
+    /**
+     * @param index Position of the rectangle
+     * @return The rectangle
+     */
+    const Rect& getBox(size_t index) const { return mBoxes.at(index); }
+
+    /**
+     * Call a function for each rectangle that contains a point, starting with the highest
+     * position.  Rect::contains() is used to test the point.
+     * @param point The point
+     * @param func Called with the position of each rectangle.  Return false to stop the search.
+     */
+    template<class F>
+    void reverseFindAt(const Point& point, F&& func) const {
+        if (mLarge.empty() && mEntries.empty())
+            return;
+
+        const uint32_t *first = nullptr;
+        const uint32_t *last = nullptr;
+        if (mBounds.contains(point)) {
+            auto cell = column(point.getX()) + row(point.getY()) * mColumns;
+            first = mEntries.data() + mCellStart[cell];
+            last = mEntries.data() + mCellStart[cell + 1];
+        }
+
+        // Merge the cell list and the large list, both sorted in ascending order
+        auto large = mLarge.data() + mLarge.size();
+        while (first != last || large != mLarge.data()) {
+            uint32_t index;
+            if (first == last)
+                index = *--large;
+            else if (large == mLarge.data())
+                index = *--last;
+            else
+                index = last[-1] > large[-1] ? *--last : *--large;
+
+            if (mBoxes[index].contains(point) && !func(static_cast<size_t>(index)))
+                return;
+        }
+    }
+
+    /**
+     * Find the rectangles that intersect a region.  A rectangle intersects the region if
+     * Rect::intersect() returns a non-empty rectangle.
+     * @param region The region
+     * @param result Cleared, then filled with the positions of the matching rectangles in
+     *               ascending order.
+     */
+    void findIntersecting(const Rect& region, std::vector<size_t>& result) const;
+
+private:
+    void report(uint32_t index, const Rect& region, std::vector<size_t>& result) const;
+    bool isLarge(const Rect& box) const;
+    void cellRange(const Rect& rect, int& c0, int& c1, int& r0, int& r1) const;
+    int column(float x) const;
+    int row(float y) const;
+
+    std::vector<Rect> mBoxes;
+    Rect mBounds;
+    int mColumns = 0;
+    int mRows = 0;
+    float mCellWidth = 0;
+    float mCellHeight = 0;
+    std::vector<uint32_t> mCellStart;   // Offset of each cell in mEntries; one extra at the end
+    std::vector<uint32_t> mEntries;     // Rectangle positions, ascending within each cell
+    std::vector<uint32_t> mLarge;       // Rectangles not stored in cells, ascending
+    mutable std::vector<uint32_t> mStamp;   // Last query that reported each rectangle
+    mutable uint32_t mQuery = 0;
+};
+
+} // namespace apl
+
+#endif // _APL_SPATIAL_INDEX_H
@@ -18,6 +18,8 @@
 #ifndef _APL_VISITOR_H
 #define _APL_VISITOR_H
 
+#include "apl/primitives/point.h"
+
 namespace apl {
 
 /**
@@ -73,6 +75,13 @@ public:
      * @return True if the visit should be short-circuited.
      */
     virtual bool isAborted() const { return false; }
+
+    /**
+     * A visitor that is only interested in objects containing a point may return that point so
+     * that the traversal can skip children that cannot contain it.
+     * @return The point in the global coordinate space or nullptr.
+     */
+    virtual const Point *getSearchPoint() const { return nullptr; }
 };
 
 }
@@ -79,6 +79,13 @@ public:
     void calculateLayout(float ownerWidth, float ownerHeight, LayoutDirection ownerDirection);
     bool isDirty() const;
 
+    /**
+     * @return True if Yoga has visited this node during a layout pass since the flag was last
+     *         cleared.  Nodes whose cached layout was reused wholesale by an ancestor are not visited.
+     */
+    bool hasNewLayout() const;
+    void setHasNewLayout(bool hasNewLayout);
+
     void setDirtiedFunc(DirtiedFunc dirtiedFunc);
     void setMeasureFunc();
     void setBaselineFunc();
@@ -311,7 +311,7 @@ public:
                 return;
 
             if (!mOnSpeechMark.empty()) {
-                auto speechMarkOpt = std::make_shared<std::map<std::string, Object>>();
+                auto speechMarkOpt = std::make_shared<ObjectMap>();
                 speechMarkOpt->emplace("markType", sSpeechMarkTypeMap.at(mark.type));
                 speechMarkOpt->emplace("markTime", mark.time);
                 speechMarkOpt->emplace("markValue", mark.value);
@@ -77,7 +77,8 @@ ImportPackageCommand::execute(const TimersPtr& timers, bool fastMode) {
         return nullptr;
     }
 
-    mPackageResolver = PackageResolver::create(packageManager, mContext->session());
+    mPackageResolver = PackageResolver::create(packageManager, mContext->session(),
+                                               mContext->getRootConfig().getPackageCache());
     mPackageResolver->load(
         evaluationContext, session, request,
         [coreDocumentContext, importPackageAction, version](std::vector<PackagePtr>&& ordered) {
@@ -450,6 +450,7 @@ Bimap<int, std::string> sComponentPropertyBimap = {
     {kPropertyPointerEvents,                "pointerEvents"},
     {kPropertyPreserve,                     "preserve"},
     {kPropertyRangeKaraokeTarget,           "_rangeKaraokeTarget"},
+    {kPropertyRecycleItems,                 "-recycleItems"},
     {kPropertyResourceId,                   "resourceId"},
     {kPropertyResourceState,                "_resourceState"},
     {kPropertyResourceType,                 "_resourceType"},
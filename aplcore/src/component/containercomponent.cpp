@@ -110,19 +110,20 @@ ContainerComponent::calculateChildrenVisualLayer(const std::map<int, float>& vis
         return result;
     }
 
+    // Calculate the visible rectangles once rather than for every pair of children
     std::vector<int> indexes;
+    std::vector<Rect> visibleRects;
     indexes.reserve(visibleIndexes.size());
+    visibleRects.reserve(visibleIndexes.size());
     for(auto const& vi : visibleIndexes) {
         indexes.emplace_back(vi.first);
+        visibleRects.emplace_back(mChildren.at(vi.first)->calculateVisibleRect(visibleRect));
         result.emplace(vi.first, visualLayer);
     }
 
-    for(int i=0; i<indexes.size(); i++) {
-        auto& childi = mChildren.at(indexes.at(i));
-        for(int j=i+1; j<visibleIndexes.size(); j++) {
-            auto childj = mChildren.at(indexes.at(j));
-            bool intersects = childi->calculateVisibleRect(visibleRect)
-                    .intersect(childj->calculateVisibleRect(visibleRect)).area() > 0;
+    for(size_t i=0; i<indexes.size(); i++) {
+        for(size_t j=i+1; j<indexes.size(); j++) {
+            bool intersects = visibleRects.at(i).intersect(visibleRects.at(j)).area() > 0;
             if(intersects) {
                 result.at(indexes.at(j)) = result.at(indexes.at(i)) + 1;
             }
@@ -251,8 +251,12 @@ CoreComponent::releaseSelf()
     mContext->layoutManager().remove(shared_from_corecomponent());
     deregisterFromVisibilityTracking();
     RecalculateTarget::removeUpstreamDependencies();
+    if (mRebuilder)
+        mRebuilder->clearRecyclePool();
     mParent = nullptr;
     mChildren.clear();
+    mChildIndex.reset();
+    mVisualContextCache.reset();
     mCalculated.clear();
     mFlags.set(kComponentFlagInvalid);
     mFlags.set(kComponentFlagIsReleased);
@@ -302,8 +306,17 @@ CoreComponent::raccept(Visitor<CoreComponent>& visitor) const
 {
     visitor.visit(*this);
     visitor.push();
-    for (auto it = mChildren.rbegin(); !visitor.isAborted() && it != mChildren.rend(); it++)
-        (*it)->raccept(visitor);
+    Point point;
+    auto index = visitor.isAborted() ? nullptr : getChildIndexAt(visitor, point);
+    if (index) {
+        index->reverseFindAt(point, [&](size_t i) {
+            mChildren[i]->raccept(visitor);
+            return !visitor.isAborted();
+        });
+    } else {
+        for (auto it = mChildren.rbegin(); !visitor.isAborted() && it != mChildren.rend(); it++)
+            (*it)->raccept(visitor);
+    }
     visitor.pop();
 }
 
@@ -465,6 +478,7 @@ CoreComponent::markDisplayedChildrenStale(bool useDirtyFlag)
     // Children visibility can't be stale if component can't have one.
     if (multiChild() || singleChild()) {
         mCoreFlags.set(kCoreComponentFlagDisplayedChildrenStale);
+        if (mChildIndex) mChildIndex->displayedStale = true;
         if (useDirtyFlag) setDirty(kPropertyNotifyChildrenChanged);
     }
 }
@@ -490,7 +504,90 @@ CoreComponent::isDisplayedChild(const CoreComponent& child) const
 {
     auto& mutableThis = const_cast<CoreComponent&>(*this);
     mutableThis.ensureDisplayedChildren();
-    return std::count(mDisplayedChildren.begin(), mDisplayedChildren.end(), child.shared_from_corecomponent());
+
+    auto index = ensureChildIndex();
+    if (!index)
+        return std::count(mDisplayedChildren.begin(), mDisplayedChildren.end(), child.shared_from_corecomponent());
+
+    // The focus finder checks every child, so keep a sorted copy for lookups
+    if (index->displayedStale) {
+        index->displayed.clear();
+        for (const auto& m : mDisplayedChildren)
+            index->displayed.emplace_back(m.get());
+        std::sort(index->displayed.begin(), index->displayed.end());
+        index->displayedStale = false;
+    }
+
+    return std::binary_search(index->displayed.begin(), index->displayed.end(), &child);
+}
+
+/**
+ * The axis aligned bounding box of a child in the child coordinate space of its parent.  Note that
+ * the transform is applied assuming the top-left corner of the child is at (0,0).
+ */
+static Rect
+childBoundingBox(const CoreComponent& child)
+{
+    auto childBounds = child.getCalculated(kPropertyBounds).get<Rect>();
+    const auto& transform = child.getCalculated(kPropertyTransform).get<Transform2D>();
+    Point childBoundsTopLeft = childBounds.getTopLeft();
+    childBounds = transform.calculateAxisAlignedBoundingBox(Rect{0, 0, childBounds.getWidth(), childBounds.getHeight()});
+    childBounds.offset(childBoundsTopLeft);
+    return childBounds;
+}
+
+// Components with fewer children than this are searched linearly
+static const size_t CHILD_INDEX_MIN_CHILDREN = 16;
+
+// The indexed boxes are grown by this much so that rounding errors in the transforms cannot
+// exclude a child that the exact test would accept.
+static const float CHILD_INDEX_MARGIN = 1.0f;
+
+CoreComponent::ChildIndex *
+CoreComponent::ensureChildIndex() const
+{
+    if (mChildren.size() < CHILD_INDEX_MIN_CHILDREN)
+        return nullptr;
+
+    if (!mChildIndex) {
+        if (!getRootConfig().experimentalFeatureEnabled(RootConfig::kExperimentalFeatureSpatialIndex))
+            return nullptr;
+        auto& mutableThis = const_cast<CoreComponent&>(*this);
+        mutableThis.mChildIndex = std::make_unique<ChildIndex>();
+    }
+
+    auto index = mChildIndex.get();
+    if (index->boxesStale) {
+        std::vector<Rect> boxes;
+        boxes.reserve(mChildren.size());
+        for (const auto& child : mChildren) {
+            auto box = childBoundingBox(*child);
+            if (!box.empty())
+                box = Rect(box.getX() - CHILD_INDEX_MARGIN, box.getY() - CHILD_INDEX_MARGIN,
+                           box.getWidth() + 2 * CHILD_INDEX_MARGIN, box.getHeight() + 2 * CHILD_INDEX_MARGIN);
+            boxes.emplace_back(box);
+        }
+        index->boxes.build(std::move(boxes));
+        index->boxesStale = false;
+    }
+
+    return index;
+}
+
+const SpatialIndex *
+CoreComponent::getChildIndexAt(const Visitor<CoreComponent>& visitor, Point& point) const
+{
+    auto searchPoint = visitor.getSearchPoint();
+    if (!searchPoint)
+        return nullptr;
+
+    auto index = ensureChildIndex();
+    if (!index)
+        return nullptr;
+
+    // Children that fail the bounds test are pruned by the visitor, so skipping them is exact
+    point = toLocalPoint(*searchPoint) + scrollPosition();
+    return &index->boxes;
 }
 
 void
@@ -512,26 +609,17 @@ CoreComponent::ensureDisplayedChildren()
     viewportRect.offset(scrollPosition());
 
     std::vector<CoreComponentPtr> sticky;
-    // Process the children, identify those displayed within local viewport
-    for (auto& child : mChildren) {
+    auto addIfDisplayed = [&](const CoreComponentPtr& child) {
         // only visible children
         if (child->isDisplayable()) {
             // compare child rect, transformed as needed, against the viewport
-            auto childBounds = child->getCalculated(kPropertyBounds).get<Rect>();
-            const auto& transform = child->getCalculated(kPropertyTransform).get<Transform2D>();
             // The axis aligned bounding box is an approximation for checking bounds intersection.
             // The AABB test eliminates children that are guaranteed NOT to intersect. It does not
             // prove the parent and child do intersect.
             // TODO a complete solution applies the "separating axis theorem". The parent AABB is
             // TODO transformed into the child space and tested for intersection. If a separating axis cannot be
             // TODO identified using both tests, the parent and child intersect.
-
-            // Note that the transform is applied assuming the top-left corner of the child is at (0,0)
-            Point childBoundsTopLeft = childBounds.getTopLeft();
-            childBounds = transform.calculateAxisAlignedBoundingBox(Rect{0, 0, childBounds.getWidth(), childBounds.getHeight()});
-            childBounds.offset(childBoundsTopLeft);
-
-            if (!viewportRect.intersect(childBounds).empty()) {
+            if (!viewportRect.intersect(childBoundingBox(*child)).empty()) {
                 if (child->getCalculated(kPropertyPosition) == kPositionSticky) {
                     sticky.emplace_back(child);
                 } else {
@@ -539,6 +627,18 @@ CoreComponent::ensureDisplayedChildren()
                 }
             }
         }
+    };
+
+    // Process the children, identify those displayed within local viewport.  The child index
+    // narrows the search down to the children whose (slightly enlarged) boxes overlap the viewport.
+    auto index = ensureChildIndex();
+    if (index) {
+        index->boxes.findIntersecting(viewportRect, index->found);
+        for (auto i : index->found)
+            addIfDisplayed(mChildren[i]);
+    } else {
+        for (auto& child : mChildren)
+            addIfDisplayed(child);
     }
 
     // Insert the sticky elements at the end
@@ -583,8 +683,13 @@ CoreComponent::insertChild(const CoreComponentPtr& child, size_t index, bool use
 
     coreChild->markGlobalToLocalTransformStale();
     markDisplayedChildrenStale(useDirtyFlag);
+    markChildIndexStale();
     setVisualContextDirty();
 
+    // The index and ordinal of the children that follow have changed
+    for (auto i = index; i < mChildren.size(); i++)
+        mChildren[i]->markVisualContextStale();
+
     // Register component for visibility calculation considerations, if required
     coreChild->registerForVisibilityTrackingIfRequired();
 
@@ -641,12 +746,17 @@ CoreComponent::removeChildAfterMarkedRemoved(const CoreComponentPtr& child, size
         notifyChildChanged(index, child, kChildChangeActionRemove);
 
     markDisplayedChildrenStale(useDirtyFlag);
+    markChildIndexStale();
     mDisplayedChildren.clear();
 
     if (useDirtyFlag) {
         setVisualContextDirty();
     }
 
+    markVisualContextStale();
+    for (auto i = index; i < mChildren.size(); i++)
+        mChildren[i]->markVisualContextStale();
+
     // Update the position: sticky components tree
     auto p = stickyfunctions::getHorizontalAndVerticalScrollable(shared_from_corecomponent());
     auto horizontalScrollable   = std::get<0>(p);
@@ -947,6 +1057,7 @@ void
 CoreComponent::assignProperties(const ComponentPropDefSet& propDefSet)
 {
     auto stylePtr = getStyle();
+    mCalculated.reserve(mCalculated.size() + propDefSet.size());
 
     for (const auto& cpd : propDefSet) {
         const auto& pd = cpd.second;
@@ -970,7 +1081,7 @@ CoreComponent::assignProperties(const ComponentPropDefSet& propDefSet)
                 else {
                     value = pd.calculate(*mContext, p->second);
                 }
-                mAssigned.emplace(pd.key);
+                mAssigned.set(pd.key);
             }
             else {
                 // Make sure this wasn't a required property
@@ -1186,12 +1297,11 @@ CoreComponent::setPropertyInternal(ConstComponentPropIterator it, const Object&
     }
 
     // If this property was previously assigned we need to clear any dependants
-    auto assigned = mAssigned.find(it->first);
-    if (assigned != mAssigned.end()) // Erase all upstream dependants that drive this key
+    if (mAssigned.test(it->first)) // Erase all upstream dependants that drive this key
         removeUpstream(it->first);
 
     // Mark this property in the "assigned" set of properties.
-    mAssigned.emplace(it->first);
+    mAssigned.set(it->first);
 
     // Check to see if the actual value of the property changed and update appropriately
     const ComponentPropDef& def = it->second;
@@ -1566,8 +1676,7 @@ CoreComponent::setValue(PropertyKey key, const Object& value, bool useDirtyFlag)
         return;
     }
 
-    auto it = mAssigned.find(key);
-    if (it == mAssigned.end())
+    if (!mAssigned.test(key))
         return;
 
     // Check the standard properties first
@@ -1611,7 +1720,7 @@ CoreComponent::updateStyleInternal(const StyleInstancePtr& stylePtr, const Compo
         const ComponentPropDef& pd = it.second;
 
         // If the property was explicitly assigned by the user, the style won't change it.
-        if (mAssigned.count(pd.key))
+        if (mAssigned.test(pd.key))
             continue;
 
         // Check to see if the value has changed.
@@ -1771,6 +1880,7 @@ CoreComponent::updateInheritedState()
         return;
 
     mState = mParent->getState();
+    markVisualContextStale();
     for (auto& child : mChildren)
         child->updateInheritedState();
 }
@@ -1925,8 +2035,10 @@ CoreComponent::processLayoutChanges(bool useDirtyFlag, bool first)
         mCalculated.set(kPropertyBounds, std::move(rect));
         markGlobalToLocalTransformStale();
         markDisplayedChildrenStale(useDirtyFlag);
-        if (mParent)
+        if (mParent) {
             mParent->markDisplayedChildrenStale(useDirtyFlag);
+            mParent->markChildIndexStale();
+        }
         setVisualContextDirty();
         setVisibilityDirty();
         if (useDirtyFlag)
@@ -1948,9 +2060,10 @@ CoreComponent::processLayoutChanges(bool useDirtyFlag, bool first)
                      borderTop + paddingTop,
                      width - (borderLeft + paddingLeft + borderRight + paddingRight),
                      height - (borderTop + paddingTop + borderBottom + paddingBottom));
-    changed = inner != mCalculated.get(kPropertyInnerBounds).get<Rect>();
+    auto innerChanged = inner != mCalculated.get(kPropertyInnerBounds).get<Rect>();
+    mContext->layoutManager().recordProcessed(changed || innerChanged);
 
-    if (changed) {
+    if (innerChanged) {
         mCalculated.set(kPropertyInnerBounds, std::move(inner));
         markDisplayedChildrenStale(useDirtyFlag);
         if (useDirtyFlag)
@@ -1960,9 +2073,10 @@ CoreComponent::processLayoutChanges(bool useDirtyFlag, bool first)
     if (shouldPropagateLayoutChanges()) {
         // Inform all children that they should re-check their bounds. No need to do that for not
         // attached ones. Note that children of a Pager are not attached, and hence they will not
-        // be processed.
+        // be processed.  Children that Yoga did not visit kept their cached layout, so the whole
+        // subtree can be skipped.
         for (auto& child : mChildren)
-            if (child->isAttached())
+            if (child->isAttached() && (first || child->mYogaNode.hasNewLayout()))
                 child->processLayoutChanges(useDirtyFlag, first);
     }
 
@@ -2059,11 +2173,14 @@ CoreComponent::postProcessLayoutChanges(bool first)
     }
 
     for (auto& child : mChildren)
-        if (child->isAttached())
+        if (child->isAttached() && (first || child->mYogaNode.hasNewLayout()))
             child->postProcessLayoutChanges(first);
 
     // update the displayed children
     ensureDisplayedChildren();
+
+    // The layout has been consumed; the next pass only revisits this node if Yoga lays it out again
+    mYogaNode.setHasNewLayout(false);
 }
 
 
@@ -2204,6 +2321,7 @@ CoreComponent::fixTransform(bool useDirtyFlag)
         // transform change make parent display stale
         if (mParent) {
             mParent->markDisplayedChildrenStale(useDirtyFlag);
+            mParent->markChildIndexStale();
         }
         setVisualContextDirty();
         if (useDirtyFlag)
@@ -2378,6 +2496,19 @@ CoreComponent::serializeDirty(rapidjson::Document::AllocatorType& allocator) {
 
 rapidjson::Value
 CoreComponent::serializeVisualContext(rapidjson::Document::AllocatorType& allocator) {
+    return serializeVisualContextFromTop(allocator, false);
+}
+
+rapidjson::Value
+CoreComponent::serializeDocumentVisualContext(rapidjson::Document::AllocatorType& allocator)
+{
+    return serializeVisualContextFromTop(allocator,
+        getRootConfig().experimentalFeatureEnabled(RootConfig::kExperimentalFeatureVisualContextCache));
+}
+
+rapidjson::Value
+CoreComponent::serializeVisualContextFromTop(rapidjson::Document::AllocatorType& allocator, bool useCache)
+{
     float viewportWidth = mContext->width();
     float viewportHeight = mContext->height();
     Rect viewportRect(0, 0, viewportWidth, viewportHeight);
@@ -2387,23 +2518,79 @@ CoreComponent::serializeVisualContext(rapidjson::Document::AllocatorType& alloca
 
     rapidjson::Value children(rapidjson::kArrayType);
     serializeVisualContextInternal(children, allocator, topComponentOpacity, topComponentVisibility,
-            topComponentVisibleRect, 0);
+            topComponentVisibleRect, 0, useCache);
 
     // We always have viewport component
     return children[0].GetObject();
 }
 
-void
+bool
 CoreComponent::serializeVisualContextInternal(
     rapidjson::Value &outArray, rapidjson::Document::AllocatorType& allocator, float realOpacity,
-    float visibility, const Rect& visibleRect, int visualLayer)
+    float visibility, const Rect& visibleRect, int visualLayer, bool useCache)
+{
+    if (!useCache)
+        return serializeVisualContextEntries(outArray, allocator, realOpacity, visibility, visibleRect,
+                                             visualLayer, false);
+
+    // Nothing in this subtree changed and it is in the same place, so the entries are unchanged
+    const auto& globalToLocal = getGlobalToLocalTransform();
+    const auto& bounds = getCalculated(kPropertyBounds).get<Rect>();
+    auto cache = mVisualContextCache.get();
+    if (cache && !mCoreFlags.isSet(kCoreComponentFlagVisualContextStale) &&
+        cache->realOpacity == realOpacity && cache->visibility == visibility &&
+        cache->visibleRect == visibleRect && cache->visualLayer == visualLayer &&
+        cache->globalToLocal == globalToLocal && cache->bounds == bounds) {
+        for (const auto& entry : cache->entries.GetArray())
+            outArray.PushBack(rapidjson::Value(entry, allocator), allocator);
+        return true;
+    }
+
+    auto start = outArray.Size();
+    auto cacheable = serializeVisualContextEntries(outArray, allocator, realOpacity, visibility,
+                                                   visibleRect, visualLayer, true);
+    clearVisualContextStale();
+
+    // The top component is rebuilt whenever anything changes, so it is not worth caching
+    if (!cacheable || !getParentIfInDocument()) {
+        mVisualContextCache.reset();
+        return cacheable;
+    }
+
+    if (!cache) {
+        mVisualContextCache = std::make_unique<VisualContextCache>();
+        cache = mVisualContextCache.get();
+    }
+
+    cache->realOpacity = realOpacity;
+    cache->visibility = visibility;
+    cache->visibleRect = visibleRect;
+    cache->visualLayer = visualLayer;
+    cache->globalToLocal = globalToLocal;
+    cache->bounds = bounds;
+
+    rapidjson::CrtAllocator cacheAllocator;
+    cache->entries.SetArray();
+    for (auto i = start; i < outArray.Size(); i++)
+        cache->entries.PushBack(decltype(cache->entries)(outArray[i], cacheAllocator), cacheAllocator);
+    return true;
+}
+
+bool
+CoreComponent::serializeVisualContextEntries(
+    rapidjson::Value &outArray, rapidjson::Document::AllocatorType& allocator, float realOpacity,
+    float visibility, const Rect& visibleRect, int visualLayer, bool useCache)
 {
     auto parentInDocument = getParentIfInDocument();
     if(visibility == 0.0 && parentInDocument) {
         // Not visible and not viewport component.
-        return;
+        return true;
     }
 
+    // Embedded documents track their own changes, so a host is always rebuilt
+    bool childUseCache = useCache && getType() != kComponentTypeHost;
+    bool cacheable = childUseCache;
+
     // Decide if actionable
     bool actionable = !getCalculated(kPropertyEntities).empty();
     rapidjson::Value tags(rapidjson::kObjectType);
@@ -2429,15 +2616,15 @@ CoreComponent::serializeVisualContextInternal(
             auto childRealOpacity = child->calculateRealOpacity(realOpacity);
             auto childVisibility = childIdx.second;
             auto childVisualLayer = visualLayers.at(childIdx.first);
-            child->serializeVisualContextInternal(
+            cacheable &= child->serializeVisualContextInternal(
                     includeInContext ? children : outArray, allocator,
-                    childRealOpacity, childVisibility, childVisibleRect, childVisualLayer);
+                    childRealOpacity, childVisibility, childVisibleRect, childVisualLayer, childUseCache);
         }
     }
 
     // we already should have included visible children on this point so break out if parent is not "actionable".
     if(!includeInContext) {
-        return;
+        return cacheable;
     }
 
     rapidjson::Value visualContext(rapidjson::kObjectType);
@@ -2478,6 +2665,7 @@ CoreComponent::serializeVisualContextInternal(
     }
 
     outArray.PushBack(visualContext.Move(), allocator);
+    return cacheable;
 }
 
 std::string
@@ -2501,10 +2689,36 @@ CoreComponent::getVisualContextType() const
 void
 CoreComponent::setVisualContextDirty()
 {
+    markVisualContextStale();
+
     // set this component as dirty visual context
     mContext->setDirtyVisualContext(shared_from_this());
 }
 
+void
+CoreComponent::markVisualContextStale()
+{
+    // A stale component always has stale ancestors, so stop at the first one
+    for (auto component = this;
+         component && !component->mCoreFlags.isSet(kCoreComponentFlagVisualContextStale);
+         component = component->mParent.get())
+        component->mCoreFlags.set(kCoreComponentFlagVisualContextStale);
+}
+
+void
+CoreComponent::clearVisualContextStale()
+{
+    if (!mCoreFlags.checkAndClear(kCoreComponentFlagVisualContextStale))
+        return;
+
+    // An embedded document clears its components when it is serialized
+    if (getType() == kComponentTypeHost)
+        return;
+
+    for (const auto& child : mChildren)
+        child->clearVisualContextStale();
+}
+
 void
 CoreComponent::setVisibilityDirty()
 {
@@ -169,6 +169,13 @@ GridSequenceComponent::ensureChildAttached(const CoreComponentPtr& child, int ta
     applyChildSize(child, targetIdx);
 }
 
+void
+GridSequenceComponent::refreshChildNode(const CoreComponentPtr& child, size_t index)
+{
+    MultiChildScrollableComponent::refreshChildNode(child, index);
+    applyChildSize(child, index);
+}
+
 void
 GridSequenceComponent::calculateAbsoluteChildSizes(float gridWidth, float gridHeight)
 {
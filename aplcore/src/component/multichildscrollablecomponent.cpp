@@ -125,6 +125,7 @@ MultiChildScrollableComponent::propDefSet() const
         {kPropertySnap,        kSnapNone,             sSnapMap,       kPropInOut | kPropStyled},
         {kPropertyNumbered,    false,                 asBoolean,      kPropIn | kPropVisualContext},
         {kPropertyOnScroll,    Object::EMPTY_ARRAY(), asCommand,      kPropIn},
+        {kPropertyRecycleItems, false,                asBoolean,      kPropIn},
         {kPropertyCenterId,    getCenterId,           setCenterId,    kPropDynamic | kPropSetAfterLayout},
         {kPropertyCenterIndex, getCenterIndex,        setCenterIndex, kPropDynamic | kPropSetAfterLayout},
         {kPropertyFirstId,     getFirstId,            setFirstId,     kPropDynamic | kPropSetAfterLayout},
@@ -391,12 +392,28 @@ MultiChildScrollableComponent::raccept(Visitor<CoreComponent>& visitor) const
     visitor.visit(*this);
     visitor.push();
     if (!mEnsuredChildren.empty()) {
-        for (int i = mEnsuredChildren.upperBound();
-             i >= mEnsuredChildren.lowerBound() && !visitor.isAborted(); i--) {
-            auto child = CoreComponent::cast(mChildren.at(i));
-            if (child != nullptr && child->isAttached() &&
-                !child->getCalculated(kPropertyBounds).get<Rect>().empty())
-                child->raccept(visitor);
+        Point point;
+        auto index = visitor.isAborted() ? nullptr : getChildIndexAt(visitor, point);
+        if (index) {
+            index->reverseFindAt(point, [&](size_t i) -> bool {
+                if (static_cast<int>(i) > mEnsuredChildren.upperBound())
+                    return true;
+                if (static_cast<int>(i) < mEnsuredChildren.lowerBound())
+                    return false;
+                auto child = CoreComponent::cast(mChildren.at(i));
+                if (child != nullptr && child->isAttached() &&
+                    !child->getCalculated(kPropertyBounds).get<Rect>().empty())
+                    child->raccept(visitor);
+                return !visitor.isAborted();
+            });
+        } else {
+            for (int i = mEnsuredChildren.upperBound();
+                 i >= mEnsuredChildren.lowerBound() && !visitor.isAborted(); i--) {
+                auto child = CoreComponent::cast(mChildren.at(i));
+                if (child != nullptr && child->isAttached() &&
+                    !child->getCalculated(kPropertyBounds).get<Rect>().empty())
+                    child->raccept(visitor);
+            }
         }
     }
     visitor.pop();
@@ -1051,6 +1068,9 @@ MultiChildScrollableComponent::processLayoutChangesInternal(bool useDirtyFlag, b
 
     ensureChildrenVisibilityUpdated();
 
+    if (!first)
+        virtualizeChildren(useDirtyFlag);
+
     if (first) {
         // Avoid yoga initiated re-layout that may be caused by attaching components that were already laid-out
         mContext->layoutManager().remove(getLayoutRoot());
@@ -1071,6 +1091,58 @@ MultiChildScrollableComponent::processLayoutChangesInternal(bool useDirtyFlag, b
     mAvailableRange = Range(startEdge, std::max(lastEdge - pageSize, startEdge));
 }
 
+bool
+MultiChildScrollableComponent::virtualizesChildren() const
+{
+    return mRebuilder &&
+           mContext->getRootConfig().getProperty(RootProperty::kSequenceVirtualizationWindow).getDouble() > 0;
+}
+
+void
+MultiChildScrollableComponent::refreshChildNode(const CoreComponentPtr& child, size_t index)
+{
+    child->updateNodeProperties();
+    if (childrenUseSpacingProperty())
+        child->fixSpacing(index == 0);
+}
+
+void
+MultiChildScrollableComponent::virtualizeChildren(bool useDirtyFlag)
+{
+    if (!virtualizesChildren() || mEnsuredChildren.empty())
+        return;
+
+    APL_TRACE_BLOCK("MultiChildScrollableComponent:virtualizeChildren");
+    auto window = mContext->getRootConfig().getProperty(RootProperty::kSequenceVirtualizationWindow).getDouble();
+    auto horizontal = isHorizontal();
+    const auto& innerBounds = mCalculated.get(kPropertyInnerBounds).get<Rect>();
+    auto position = scrollPosition();
+    float viewStart = horizontal ? innerBounds.getX() + position.getX() : innerBounds.getY() + position.getY();
+    float viewSize = horizontal ? innerBounds.getWidth() : innerBounds.getHeight();
+    float keepStart = viewStart - window * viewSize;
+    float keepEnd = viewStart + viewSize + window * viewSize;
+
+    bool changed = false;
+    for (int index = mEnsuredChildren.lowerBound(); index <= mEnsuredChildren.upperBound(); index++) {
+        const auto& child = mChildren.at(index);
+        const auto& bounds = child->getCalculated(kPropertyBounds).get<Rect>();
+        float start = horizontal ? bounds.getLeft() : bounds.getTop();
+        float end = horizontal ? bounds.getRight() : bounds.getBottom();
+
+        if (end < keepStart || start > keepEnd) {
+            changed |= mRebuilder->deflate(child, useDirtyFlag);
+        } else if (!child->getContext()->opt("_item").isNull()) {
+            // Back inside the window: inflate again and release the size held while deflated
+            mRebuilder->inflateIfRequired(child);
+            refreshChildNode(child, index);
+            changed = true;
+        }
+    }
+
+    if (changed)
+        relayoutInPlace(useDirtyFlag, false);
+}
+
 void
 MultiChildScrollableComponent::onScrollPositionUpdated()
 {
@@ -171,6 +171,7 @@ PagerComponent::propDefSet() const {
         {kPropertyPageDirection,  kScrollDirectionHorizontal, sScrollDirectionMap, kPropIn | kPropDynamic },
         {kPropertyHandlePageMove, Object::EMPTY_ARRAY(),      asArray,             kPropIn },
         {kPropertyOnPageChanged,  Object::EMPTY_ARRAY(),      asCommand,           kPropIn },
+        {kPropertyRecycleItems,   false,                      asBoolean,           kPropIn },
         {kPropertyCurrentPage,    0,                          asInteger,           kPropRuntimeState | kPropVisualContext | kPropVisibility | kPropAccessibility },
         {kPropertyPageId,         getPageId,                  setPageId,           kPropDynamic },
         {kPropertyPageIndex,      getPageIndex,               setPageIndex,        kPropDynamic },
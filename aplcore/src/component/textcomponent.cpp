@@ -18,6 +18,7 @@
 #include "apl/component/componentpropdef.h"
 #include "apl/component/textmeasurement.h"
 #include "apl/content/rootconfig.h"
+#include "apl/engine/layoutmanager.h"
 #include "apl/primitives/styledtext.h"
 #include "apl/time/sequencer.h"
 #include "apl/utils/session.h"
@@ -197,7 +198,7 @@ TextComponent::checkKaraokeTargetColor()
 
     // If we're in karaoke mode AND we haven't manually assigned a color, we need to recalculate the Karaoke target color
     // and the non-Karaoke color
-    if (mState.get(kStateKaraoke) && mAssigned.count(kPropertyColor) == 0) {
+    if (mState.get(kStateKaraoke) && !mAssigned.test(kPropertyColor)) {
         State state = mState;  // Copy the old state.
 
         // Check the karaoke target color
@@ -297,6 +298,19 @@ TextComponent::textMeasure(float width, MeasureMode widthMode, float height, Mea
 
     auto& layoutCache = getContext()->textLayoutCache();
     auto layout = layoutCache.find(tmr);
+
+    // During the text measurement pre-pass only record the request; don't touch the current layout
+    auto& layoutManager = mContext->layoutManager();
+    if (layoutManager.isRecordingTextMeasurements()) {
+        if (layout)
+            return layout->getSize();
+
+        layoutManager.recordTextMeasurement(*this, tmr, {mTextChunk, mTextProperties,
+                                                         MeasureRequest(width, widthMode, height, heightMode),
+                                                         nullptr});
+        return {widthMode == MeasureMode::Exactly ? width : 0, heightMode == MeasureMode::Exactly ? height : 0};
+    }
+
     if (layout) {
         mLayout = layout;
     } else {
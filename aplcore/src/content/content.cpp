@@ -163,6 +163,7 @@ Content::refresh(const Metrics& metrics, const RootConfig& config)
 
     // Update the package manager in our package resolver. It may be new.
     mPackageResolver->setPackageManager(mConfig.getPackageManager() == nullptr ? mContentPackageManager : mConfig.getPackageManager());
+    mPackageResolver->setPackageCache(mConfig.getPackageCache());
 
     addExtensions(*mMainPackage);
     preloadPackages();
@@ -185,9 +186,9 @@ Content::init(bool supportsEvaluation)
 
     if (mConfig.getPackageManager() == nullptr) {
         mContentPackageManager = std::make_shared<ContentPackageManager>();
-        mPackageResolver = PackageResolver::create(mContentPackageManager, mSession);
+        mPackageResolver = PackageResolver::create(mContentPackageManager, mSession, mConfig.getPackageCache());
     } else {
-        mPackageResolver = PackageResolver::create(mConfig.getPackageManager(), mSession);
+        mPackageResolver = PackageResolver::create(mConfig.getPackageManager(), mSession, mConfig.getPackageCache());
     }
     // First chance where we can extract settings. Set up the session.
     auto diagnosticLabel = getDocumentSettings()->getValue("-diagnosticLabel").asString();
@@ -652,7 +653,7 @@ Content::getExtensionSettings(const std::string& uri)
         loadExtensionSettings();
     }
 
-    const std::map<std::string, Object>::const_iterator& es = mExtensionSettings->find(uri);
+    auto es = mExtensionSettings->find(uri);
     if (es != mExtensionSettings->end()) {
         LOG_IF(DEBUG_CONTENT).session(mSession) << "getExtensionSettings " << uri
                                                 << ":" << es->second.toDebugString()
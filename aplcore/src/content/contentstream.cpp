@@ -0,0 +1,358 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/content/contentstream.h"
+
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "apl/content/content.h"
+#include "apl/content/importrequest.h"
+#include "apl/content/jsondata.h"
+#include "apl/content/packagemanager.h"
+#include "apl/utils/log.h"
+#include "apl/utils/make_unique.h"
+#include "apl/utils/session.h"
+#include "apl/utils/stringfunctions.h"
+
+namespace apl {
+
+static const bool DEBUG_CONTENT_STREAM = false;
+
+static const char *STREAM_IMPORT = "import";
+static const char *STREAM_IMPORT_TYPE = "type";
+static const char *STREAM_IMPORT_TYPE_PACKAGE = "package";
+static const char *STREAM_IMPORT_WHEN = "when";
+static const char *STREAM_IMPORT_LOAD_AFTER = "loadAfter";
+
+/**
+ * True if the string can be used without an evaluation context.
+ */
+static bool
+isStaticString(const rapidjson::Value& value)
+{
+    return value.IsString() && std::strstr(value.GetString(), "${") == nullptr;
+}
+
+/**
+ * True if the import record can be turned into an ImportRequest before the document evaluation
+ * context exists: a plain package import with no "when" clause and no data-binding expressions.
+ */
+static bool
+isStaticImport(const rapidjson::Value& value)
+{
+    if (!value.IsObject() || value.HasMember(STREAM_IMPORT_WHEN))
+        return false;
+
+    for (const auto& m : value.GetObject()) {
+        if (std::strcmp(m.name.GetString(), STREAM_IMPORT_TYPE) == 0) {
+            if (!m.value.IsString() || std::strcmp(m.value.GetString(), STREAM_IMPORT_TYPE_PACKAGE) != 0)
+                return false;
+        } else if (std::strcmp(m.name.GetString(), STREAM_IMPORT_LOAD_AFTER) == 0 && m.value.IsArray()) {
+            for (const auto& item : m.value.GetArray())
+                if (!isStaticString(item))
+                    return false;
+        } else if (!isStaticString(m.value)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Package manager that sits between the Content and the viewhost package manager.  Packages can be
+ * requested before the Content exists; the Content's own requests for the same packages are then
+ * answered from here.  Requests for anything else pass straight through.
+ */
+class ContentStream::PrefetchPackageManager : public PackageManager,
+                                              public std::enable_shared_from_this<PrefetchPackageManager> {
+public:
+    PrefetchPackageManager(const PackageManagerPtr& packageManager, const SessionPtr& session)
+        : mPackageManager(packageManager),
+          mSession(session)
+    {}
+
+    void loadPackage(const PackageRequestPtr& packageRequest) override
+    {
+        auto it = mEntries.find(packageRequest->request());
+        if (it == mEntries.end()) {
+            mPackageManager->loadPackage(packageRequest);
+            return;
+        }
+
+        auto& entry = it->second;
+        if (!entry.done)
+            entry.waiting.emplace_back(packageRequest);
+        else if (entry.data)
+            packageRequest->succeed(*entry.data);
+        else
+            packageRequest->fail(entry.errorMessage, entry.errorCode);
+    }
+
+    /**
+     * Request every import in the list that can be resolved without an evaluation context.
+     * @param importList The "import" array of a document or package.
+     */
+    void prefetchImports(const rapidjson::Value& importList)
+    {
+        if (!importList.IsArray())
+            return;
+
+        for (const auto& value : importList.GetArray()) {
+            if (!isStaticImport(value))
+                continue;
+
+            auto request = ImportRequest::create(value, nullptr, mSession);
+            if (request.isValid())
+                prefetch(request);
+        }
+    }
+
+    size_t size() const { return mEntries.size(); }
+
+private:
+    struct Entry {
+        bool done = false;
+        std::unique_ptr<SharedJsonData> data;  // Set on success
+        std::string errorMessage;
+        int errorCode = 0;
+        std::vector<PackageRequestPtr> waiting;
+    };
+
+    void prefetch(const ImportRequest& request)
+    {
+        if (mEntries.count(request))
+            return;
+
+        // The import resolver reuses an earlier request with the same name when its version
+        // satisfies the "accept" pattern, so the package would never be asked for.
+        for (const auto& m : mEntries)
+            if (m.first.reference().name() == request.reference().name() &&
+                m.first.isAcceptableReplacementFor(request))
+                return;
+
+        LOG_IF(DEBUG_CONTENT_STREAM).session(mSession) << "Early request for " << request.reference().toString();
+        mEntries.emplace(request, Entry());
+
+        auto weakSelf = std::weak_ptr<PrefetchPackageManager>(shared_from_this());
+        mPackageManager->loadPackage(std::make_shared<PackageRequest>(
+            request,
+            [weakSelf](const ImportRequest& request, const SharedJsonData& data) {
+                if (auto self = weakSelf.lock())
+                    self->onLoaded(request, data);
+            },
+            [weakSelf](const ImportRequest& request, const std::string& errorMessage, int errorCode) {
+                if (auto self = weakSelf.lock())
+                    self->onFailed(request, errorMessage, errorCode);
+            }));
+    }
+
+    void onLoaded(const ImportRequest& request, const SharedJsonData& data)
+    {
+        auto it = mEntries.find(request);
+        if (it == mEntries.end() || it->second.done)
+            return;
+
+        it->second.done = true;
+        it->second.data = std::make_unique<SharedJsonData>(data);
+        auto waiting = std::move(it->second.waiting);
+
+        // The package may import other packages; request those before handing it over.
+        if (data && data.get().IsObject()) {
+            auto imports = data.get().FindMember(STREAM_IMPORT);
+            if (imports != data.get().MemberEnd())
+                prefetchImports(imports->value);
+        }
+
+        for (const auto& packageRequest : waiting)
+            packageRequest->succeed(data);
+    }
+
+    void onFailed(const ImportRequest& request, const std::string& errorMessage, int errorCode)
+    {
+        auto it = mEntries.find(request);
+        if (it == mEntries.end() || it->second.done)
+            return;
+
+        it->second.done = true;
+        it->second.errorMessage = errorMessage;
+        it->second.errorCode = errorCode;
+        auto waiting = std::move(it->second.waiting);
+
+        for (const auto& packageRequest : waiting)
+            packageRequest->fail(errorMessage, errorCode);
+    }
+
+private:
+    PackageManagerPtr mPackageManager;
+    SessionPtr mSession;
+    std::map<ImportRequest, Entry> mEntries;
+};
+
+ContentStreamPtr
+ContentStream::create(const SessionPtr& session, const Metrics& metrics, const RootConfig& config)
+{
+    return std::make_shared<ContentStream>(session, metrics, config);
+}
+
+ContentStream::ContentStream(const SessionPtr& session, const Metrics& metrics, const RootConfig& config)
+    : mSession(session),
+      mMetrics(metrics),
+      mConfig(config)
+{
+    if (auto packageManager = mConfig.getPackageManager())
+        mPrefetch = std::make_shared<PrefetchPackageManager>(packageManager, mSession);
+}
+
+bool
+ContentStream::append(const char *data, size_t length)
+{
+    if (mState == State::FINISHED || mState == State::ERROR)
+        return false;
+
+    auto offset = mBuffer.size();
+    mBuffer.append(data, length);
+    if (mState == State::SCANNING)
+        scan(offset);
+
+    return mState != State::ERROR;
+}
+
+ContentPtr
+ContentStream::finish()
+{
+    if (mState == State::FINISHED)
+        return nullptr;
+
+    mState = State::FINISHED;
+
+    auto config = mConfig;
+    if (mPrefetch) {
+        mEarlyRequestCount = mPrefetch->size();
+        config.packageManager(mPrefetch);
+    }
+
+    auto content = Content::create(JsonData(mBuffer), mSession, mMetrics, config);
+    mBuffer.clear();
+    mBuffer.shrink_to_fit();
+    return content;
+}
+
+size_t
+ContentStream::getEarlyRequestCount() const
+{
+    if (mState == State::FINISHED || !mPrefetch)
+        return mEarlyRequestCount;
+
+    return mPrefetch->size();
+}
+
+/**
+ * Walk the newly appended bytes, tracking only enough of the JSON grammar to find where each
+ * top-level member of the document starts and ends.  Values are not parsed here.
+ */
+void
+ContentStream::scan(size_t from)
+{
+    const auto length = mBuffer.size();
+    for (size_t i = from; i < length; i++) {
+        const char c = mBuffer[i];
+
+        if (mInString) {
+            if (mEscape) {
+                mEscape = false;
+            } else if (c == '\\') {
+                mEscape = true;
+            } else if (c == '"') {
+                mInString = false;
+                if (mDepth == 1 && mExpectKey)
+                    mCurrentKey.assign(mBuffer, mKeyStart, i - mKeyStart);
+            }
+            continue;
+        }
+
+        switch (c) {
+            case '"':
+                if (mDepth == 0) {
+                    mState = State::ERROR;
+                    return;
+                }
+                mInString = true;
+                mKeyStart = i + 1;
+                break;
+            case '{':
+            case '[':
+                if (mDepth == 0) {
+                    if (c != '{') {
+                        mState = State::ERROR;
+                        return;
+                    }
+                    mExpectKey = true;
+                }
+                mDepth++;
+                break;
+            case '}':
+            case ']':
+                if (mDepth == 0) {
+                    mState = State::ERROR;
+                    return;
+                }
+                if (mDepth == 1)
+                    memberComplete(i);
+                if (--mDepth == 0) {
+                    mState = State::COMPLETE;
+                    return;
+                }
+                break;
+            case ':':
+                if (mDepth == 1 && mExpectKey) {
+                    mExpectKey = false;
+                    mValueStart = i + 1;
+                }
+                break;
+            case ',':
+                if (mDepth == 1) {
+                    memberComplete(i);
+                    mExpectKey = true;
+                }
+                break;
+            default:
+                if (mDepth == 0 && !sutil::isspace(c)) {
+                    mState = State::ERROR;
+                    return;
+                }
+                break;
+        }
+    }
+}
+
+void
+ContentStream::memberComplete(size_t end)
+{
+    if (mExpectKey || !mPrefetch || mCurrentKey != STREAM_IMPORT)
+        return;
+
+    rapidjson::Document imports;
+    imports.Parse(mBuffer.data() + mValueStart, end - mValueStart);
+    if (imports.HasParseError())
+        return;
+
+    LOG_IF(DEBUG_CONTENT_STREAM).session(mSession) << "Import list complete at offset " << end;
+    mPrefetch->prefetchImports(imports);
+}
+
+} // namespace apl
@@ -0,0 +1,153 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/content/packagecache.h"
+
+#include "apl/content/package.h"
+
+namespace apl {
+
+/**
+ * Approximate heap usage of a rapidjson value: the value itself plus any string or member storage.
+ */
+static size_t
+estimateValueSize(const rapidjson::Value& value) // NOLINT(misc-no-recursion)
+{
+    size_t result = sizeof(rapidjson::Value);
+
+    switch (value.GetType()) {
+        case rapidjson::kStringType:
+            result += value.GetStringLength() + 1;
+            break;
+        case rapidjson::kArrayType:
+            for (const auto& item : value.GetArray())
+                result += estimateValueSize(item);
+            break;
+        case rapidjson::kObjectType:
+            for (const auto& m : value.GetObject())
+                result += estimateValueSize(m.name) + estimateValueSize(m.value);
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+size_t
+PackageCache::estimateSize(const Package& package)
+{
+    return sizeof(Package) + package.name().size() + estimateValueSize(package.json());
+}
+
+std::string
+PackageCache::makeKey(const ImportRef& ref)
+{
+    // Names and versions cannot contain newlines, so this is unambiguous
+    return ref.name() + "\n" + ref.version() + "\n" + ref.source() + "\n" + ref.domain();
+}
+
+PackagePtr
+PackageCache::find(const ImportRef& ref)
+{
+    auto key = makeKey(ref);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mIndex.find(key);
+    if (it == mIndex.end()) {
+        mStats.misses++;
+        return nullptr;
+    }
+
+    mStats.hits++;
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return it->second->package;
+}
+
+void
+PackageCache::insert(const ImportRef& ref, const PackagePtr& package)
+{
+    if (!package)
+        return;
+
+    auto key = makeKey(ref);
+    auto bytes = estimateSize(*package);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mIndex.find(key);
+    if (it != mIndex.end()) {
+        mStats.bytes -= it->second->bytes;
+        mEntries.erase(it->second);
+        mIndex.erase(it);
+    }
+
+    if (bytes > mMaxBytes)
+        return;
+
+    evict(mMaxBytes - bytes);
+    mEntries.push_front(Entry{key, package, bytes});
+    mIndex.emplace(std::move(key), mEntries.begin());
+    mStats.insertions++;
+    mStats.bytes += bytes;
+}
+
+bool
+PackageCache::remove(const ImportRef& ref)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mIndex.find(makeKey(ref));
+    if (it == mIndex.end())
+        return false;
+
+    mStats.bytes -= it->second->bytes;
+    mEntries.erase(it->second);
+    mIndex.erase(it);
+    return true;
+}
+
+void
+PackageCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mIndex.clear();
+    mStats.bytes = 0;
+}
+
+PackageCache::Stats
+PackageCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto result = mStats;
+    result.count = mEntries.size();
+    return result;
+}
+
+/**
+ * Drop least recently used packages until no more than maxBytes are held.  The mutex must be held.
+ */
+void
+PackageCache::evict(size_t maxBytes)
+{
+    while (mStats.bytes > maxBytes && !mEntries.empty()) {
+        const auto& last = mEntries.back();
+        mStats.bytes -= last.bytes;
+        mStats.evictions++;
+        mIndex.erase(last.key);
+        mEntries.pop_back();
+    }
+}
+
+} // namespace apl
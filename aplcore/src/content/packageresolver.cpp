@@ -15,6 +15,7 @@
 
 #include "apl/content/packageresolver.h"
 
+#include "apl/content/packagecache.h"
 #include "apl/utils/make_unique.h"
 
 namespace apl {
@@ -50,6 +51,9 @@ PackageResolver::onPackageLoaded(const ImportRequest& request, JsonData&& jsonDa
         return;
     }
 
+    if (mPackageCache)
+        mPackageCache->insert(request.reference(), ptr);
+
     addPackage(request, ptr);
 }
 
@@ -117,6 +121,13 @@ PackageResolver::loadRequested(PendingImportPackage& pending)
             continue ;
         }
 
+        if (mPackageCache) {
+            if (auto cached = mPackageCache->find(request.reference())) {
+                addPackage(request, cached);
+                continue;
+            }
+        }
+
         auto packageRequest = std::make_shared<PackageManager::PackageRequest>(
             request,
             [weakSelf](const ImportRequest& request, const SharedJsonData& jsonData) {
@@ -0,0 +1,359 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/content/packedjson.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace apl {
+
+namespace {
+
+const char PACKED_MAGIC[4] = {'A', 'P', 'L', 'P'};
+const size_t PACKED_HEADER_SIZE = 8;
+const int PACKED_MAX_DEPTH = 512;
+
+enum PackedTag : uint8_t {
+    kPackedNull = 0,
+    kPackedFalse,
+    kPackedTrue,
+    kPackedInt,
+    kPackedUint,
+    kPackedDouble,
+    kPackedString,
+    kPackedArray,
+    kPackedObject
+};
+
+/****************************************************************************/
+
+class Packer {
+public:
+    std::string pack(const rapidjson::Value& value) {
+        writeValue(value);
+
+        std::string result(PACKED_MAGIC, sizeof(PACKED_MAGIC));
+        result.push_back(static_cast<char>(PackedJson::VERSION));
+        result.append(PACKED_HEADER_SIZE - result.size(), '\0');
+
+        writeVarint(result, mStrings.size());
+        for (const auto& s : mStrings) {
+            writeVarint(result, s->size());
+            result.append(*s);
+            result.push_back('\0');
+        }
+
+        result.append(mTree);
+        return result;
+    }
+
+private:
+    static void writeVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    void writeTag(PackedTag tag) { mTree.push_back(static_cast<char>(tag)); }
+
+    void writeString(const rapidjson::Value& value) {
+        auto result = mIndex.emplace(std::string(value.GetString(), value.GetStringLength()), mStrings.size());
+        if (result.second)
+            mStrings.push_back(&result.first->first);
+        writeVarint(mTree, result.first->second);
+    }
+
+    void writeValue(const rapidjson::Value& value) { // NOLINT(misc-no-recursion)
+        switch (value.GetType()) {
+            case rapidjson::kNullType:
+                writeTag(kPackedNull);
+                break;
+            case rapidjson::kFalseType:
+                writeTag(kPackedFalse);
+                break;
+            case rapidjson::kTrueType:
+                writeTag(kPackedTrue);
+                break;
+            case rapidjson::kNumberType:
+                if (value.IsDouble()) {
+                    writeTag(kPackedDouble);
+                    auto d = value.GetDouble();
+                    uint64_t bits;
+                    std::memcpy(&bits, &d, sizeof(bits));
+                    for (int i = 0; i < 8; i++)
+                        mTree.push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+                } else if (value.IsUint64()) {
+                    writeTag(kPackedUint);
+                    writeVarint(mTree, value.GetUint64());
+                } else {
+                    writeTag(kPackedInt);
+                    auto i = value.GetInt64();
+                    writeVarint(mTree, (static_cast<uint64_t>(i) << 1) ^ static_cast<uint64_t>(i >> 63));
+                }
+                break;
+            case rapidjson::kStringType:
+                writeTag(kPackedString);
+                writeString(value);
+                break;
+            case rapidjson::kArrayType:
+                writeTag(kPackedArray);
+                writeVarint(mTree, value.Size());
+                for (const auto& item : value.GetArray())
+                    writeValue(item);
+                break;
+            case rapidjson::kObjectType:
+                writeTag(kPackedObject);
+                writeVarint(mTree, value.MemberCount());
+                for (const auto& m : value.GetObject()) {
+                    writeString(m.name);
+                    writeValue(m.value);
+                }
+                break;
+        }
+    }
+
+private:
+    std::unordered_map<std::string, uint64_t> mIndex;
+    std::vector<const std::string*> mStrings;  // In index order; points at the keys of mIndex
+    std::string mTree;
+};
+
+/****************************************************************************/
+
+class Unpacker {
+public:
+    Unpacker(const char *data, size_t length)
+        : mData(reinterpret_cast<const uint8_t*>(data)),
+          mLength(length)
+    {}
+
+    bool unpack(rapidjson::Document& doc) {
+        if (!PackedJson::isPacked(reinterpret_cast<const char*>(mData), mLength)) {
+            mError = "Not a packed package";
+            return false;
+        }
+
+        if (mData[sizeof(PACKED_MAGIC)] != PackedJson::VERSION) {
+            mError = "Unsupported packed package version " + std::to_string(mData[sizeof(PACKED_MAGIC)]);
+            return false;
+        }
+
+        mOffset = PACKED_HEADER_SIZE;
+        if (!readStrings() || !readValue(doc, doc.GetAllocator(), 0))
+            return false;
+
+        if (mOffset != mLength)
+            return fail();
+
+        return true;
+    }
+
+    const std::string& error() const { return mError; }
+
+private:
+    bool fail() {
+        if (mError.empty())
+            mError = "Malformed packed package at offset " + std::to_string(mOffset);
+        return false;
+    }
+
+    size_t remaining() const { return mLength - mOffset; }
+
+    bool readVarint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (mOffset >= mLength)
+                return fail();
+            auto byte = mData[mOffset++];
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+        return fail();
+    }
+
+    /**
+     * Read a count of items that each take at least one more byte, rejecting counts that could not
+     * possibly fit in the remaining data.
+     */
+    bool readCount(rapidjson::SizeType& count) {
+        uint64_t value;
+        if (!readVarint(value) || value > remaining() || value > std::numeric_limits<rapidjson::SizeType>::max())
+            return fail();
+        count = static_cast<rapidjson::SizeType>(value);
+        return true;
+    }
+
+    bool readStrings() {
+        rapidjson::SizeType count;
+        if (!readCount(count))
+            return false;
+
+        mStrings.reserve(count);
+        for (rapidjson::SizeType i = 0; i < count; i++) {
+            uint64_t length;
+            if (!readVarint(length) || length >= remaining() || length > std::numeric_limits<rapidjson::SizeType>::max())
+                return fail();
+
+            auto start = reinterpret_cast<const char*>(mData + mOffset);
+            if (start[length] != '\0')
+                return fail();
+
+            mStrings.emplace_back(start, static_cast<rapidjson::SizeType>(length));
+            mOffset += length + 1;
+        }
+        return true;
+    }
+
+    bool readString(rapidjson::Value& value) {
+        uint64_t index;
+        if (!readVarint(index) || index >= mStrings.size())
+            return fail();
+
+        const auto& s = mStrings[index];
+        value.SetString(rapidjson::StringRef(s.first, s.second));  // No copy; points into the packed data
+        return true;
+    }
+
+    bool readValue(rapidjson::Value& value, rapidjson::Document::AllocatorType& allocator, int depth) { // NOLINT(misc-no-recursion)
+        if (mOffset >= mLength || depth > PACKED_MAX_DEPTH)
+            return fail();
+
+        switch (mData[mOffset++]) {
+            case kPackedNull:
+                value.SetNull();
+                return true;
+            case kPackedFalse:
+                value.SetBool(false);
+                return true;
+            case kPackedTrue:
+                value.SetBool(true);
+                return true;
+            case kPackedInt: {
+                uint64_t zigzag;
+                if (!readVarint(zigzag))
+                    return false;
+                value.SetInt64(static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1));
+                return true;
+            }
+            case kPackedUint: {
+                uint64_t u;
+                if (!readVarint(u))
+                    return false;
+                value.SetUint64(u);
+                return true;
+            }
+            case kPackedDouble: {
+                if (remaining() < 8)
+                    return fail();
+                uint64_t bits = 0;
+                for (int i = 0; i < 8; i++)
+                    bits |= static_cast<uint64_t>(mData[mOffset++]) << (8 * i);
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                value.SetDouble(d);
+                return true;
+            }
+            case kPackedString:
+                return readString(value);
+            case kPackedArray: {
+                rapidjson::SizeType count;
+                if (!readCount(count))
+                    return false;
+                value.SetArray();
+                value.Reserve(count, allocator);
+                for (rapidjson::SizeType i = 0; i < count; i++) {
+                    rapidjson::Value item;
+                    if (!readValue(item, allocator, depth + 1))
+                        return false;
+                    value.PushBack(item, allocator);
+                }
+                return true;
+            }
+            case kPackedObject: {
+                rapidjson::SizeType count;
+                if (!readCount(count))
+                    return false;
+                value.SetObject();
+                for (rapidjson::SizeType i = 0; i < count; i++) {
+                    rapidjson::Value name;
+                    rapidjson::Value item;
+                    if (!readString(name) || !readValue(item, allocator, depth + 1))
+                        return false;
+                    value.AddMember(name, item, allocator);
+                }
+                return true;
+            }
+            default:
+                mOffset--;
+                return fail();
+        }
+    }
+
+private:
+    const uint8_t *mData;
+    size_t mLength;
+    size_t mOffset = 0;
+    std::vector<std::pair<const char*, rapidjson::SizeType>> mStrings;
+    std::string mError;
+};
+
+} // namespace
+
+/****************************************************************************/
+
+bool
+PackedJson::isPacked(const char *data, size_t length)
+{
+    return data && length >= PACKED_HEADER_SIZE && std::memcmp(data, PACKED_MAGIC, sizeof(PACKED_MAGIC)) == 0;
+}
+
+std::string
+PackedJson::pack(const rapidjson::Value& value)
+{
+    return Packer().pack(value);
+}
+
+SharedJsonData
+PackedJson::unpack(const char *data, size_t length, const std::shared_ptr<const void>& owner)
+{
+    // The document only references the packed strings, so the owner lives as long as it does
+    std::shared_ptr<rapidjson::Document> doc(new rapidjson::Document(),
+                                             [owner](rapidjson::Document *d) { delete d; });
+
+    Unpacker unpacker(data, length);
+    if (!unpacker.unpack(*doc)) {
+        SharedJsonData result;
+        result.mError = unpacker.error();
+        return result;
+    }
+
+    return SharedJsonData(doc);
+}
+
+SharedJsonData
+PackedJson::unpack(std::string&& data)
+{
+    auto holder = std::make_shared<std::string>(std::move(data));
+    return unpack(holder->data(), holder->size(), holder);
+}
+
+} // namespace apl
@@ -192,6 +192,8 @@ RootConfig::propDefSet() const
             {RootProperty::kSendEventAdditionalFlags,                    Object::EMPTY_MAP(),                           asAny},
             {RootProperty::kTextMeasurementCacheLimit,                   500,                                           asInteger},
             {RootProperty::kInitialDisplayState,                         DEFAULT_DISPLAY_STATE,                         sDisplayStateMap},
+            {RootProperty::kTextLayoutCacheBudget,                       0,                                             asInteger},
+            {RootProperty::kSequenceVirtualizationWindow,                0,                                             asNumber},
         });
     return sRootProperties;
 }
@@ -334,6 +336,7 @@ RootConfig::copy() const
     copy->measure(getMeasure());
     copy->experimentalFeatures(getExperimentalFeatures());
     copy->packageManager(getPackageManager());
+    copy->packageCache(getPackageCache());
     
 #ifdef SCENEGRAPH
     copy->editTextFactory(getEditTextFactory());
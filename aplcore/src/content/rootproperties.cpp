@@ -56,6 +56,8 @@ Bimap<int, std::string> sRootPropertyBimap = {
         { RootProperty::kInitialDisplayState,                         "initialDisplayState"},
         { RootProperty::kLayoutDirection,                             "layoutDirection"},
         { RootProperty::kTextMeasurementCacheLimit,                   "textMeasurementCacheLimit"},
+        { RootProperty::kTextLayoutCacheBudget,                       "textLayoutCacheBudget"},
+        { RootProperty::kSequenceVirtualizationWindow,                "sequenceVirtualizationWindow"},
         { RootProperty::kScreenMode,                                  "screenMode" },
         { RootProperty::kScreenReader,                                "screenReader" },
         { RootProperty::kPointerInactivityTimeout,                    "pointerInactivityTimeout" },
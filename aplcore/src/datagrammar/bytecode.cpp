@@ -13,6 +13,9 @@
  * permissions and limitations under the License.
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include "apl/datagrammar/bytecode.h"
 #include "apl/datagrammar/bytecodeevaluator.h"
 #include "apl/datagrammar/bytecodeoptimizer.h"
@@ -50,6 +53,9 @@ ByteCode::evaluate(BoundSymbolSet* symbols, int depth) const
             case BC_OPCODE_LOAD_IMMEDIATE:
                 return cmd.value;
 
+            case BC_OPCODE_NUMERIC_EXPRESSION:
+                return mNumericExpressions.at(cmd.value).evaluate(mData, symbols);
+
             default:
                 CONSOLE(mContext) << "Unexpected trivial instruction " << cmd.type;
                 return Object::NULL_OBJECT();
@@ -77,7 +83,97 @@ ByteCode::optimize()
     if (!mOptimized) {
         ByteCodeOptimizer::optimize(*this);
         mOptimized = true;
+        mMaxStackDepth = -1;
+    }
+}
+
+/**
+ * Walk every reachable instruction, tracking the stack depth on entry.  The assembler only
+ * generates forward jumps and the stack depth at a branch target is the same along every path,
+ * so each instruction needs to be visited once.
+ */
+size_t
+ByteCode::maxStackDepth() const
+{
+    if (mMaxStackDepth >= 0)
+        return mMaxStackDepth;
+
+    const int len = mInstructions.size();
+    std::vector<int> depthAt(len + 1, -1);
+    std::vector<int> pending = {0};
+    depthAt[0] = 0;
+    int maxDepth = 0;
+
+    auto branch = [&](int target, int depth) {
+        if (target >= 0 && target <= len && depthAt[target] < 0) {
+            depthAt[target] = depth;
+            pending.push_back(target);
+        }
+    };
+
+    while (!pending.empty()) {
+        auto pc = pending.back();
+        pending.pop_back();
+        auto depth = depthAt[pc];
+
+        for ( ; pc < len ; pc++) {
+            const auto& cmd = mInstructions[pc];
+            switch (cmd.type) {
+                case BC_OPCODE_LOAD_CONSTANT:
+                case BC_OPCODE_LOAD_IMMEDIATE:
+                case BC_OPCODE_LOAD_DATA:
+                case BC_OPCODE_LOAD_BOUND_SYMBOL:
+                case BC_OPCODE_NUMERIC_EXPRESSION:
+                    depth++;
+                    break;
+                case BC_OPCODE_CALL_FUNCTION:
+                    depth -= cmd.value;
+                    break;
+                case BC_OPCODE_MERGE_STRING:
+                    depth -= cmd.value - 1;
+                    break;
+                case BC_OPCODE_ARRAY_ACCESS:
+                case BC_OPCODE_BINARY_MULTIPLY:
+                case BC_OPCODE_BINARY_DIVIDE:
+                case BC_OPCODE_BINARY_REMAINDER:
+                case BC_OPCODE_BINARY_ADD:
+                case BC_OPCODE_BINARY_SUBTRACT:
+                case BC_OPCODE_COMPARE_OP:
+                case BC_OPCODE_APPEND_ARRAY:
+                    depth--;
+                    break;
+                case BC_OPCODE_APPEND_MAP:
+                    depth -= 2;
+                    break;
+                case BC_OPCODE_JUMP_IF_FALSE_OR_POP:
+                case BC_OPCODE_JUMP_IF_TRUE_OR_POP:
+                case BC_OPCODE_JUMP_IF_NOT_NULL_OR_POP:
+                    branch(pc + cmd.value + 1, depth);
+                    depth--;
+                    break;
+                case BC_OPCODE_POP_JUMP_IF_FALSE:
+                    depth--;
+                    branch(pc + cmd.value + 1, depth);
+                    break;
+                default:
+                    break;
+            }
+
+            maxDepth = std::max(maxDepth, depth);
+
+            if (cmd.type == BC_OPCODE_JUMP) {
+                branch(pc + cmd.value + 1, depth);
+                break;
+            }
+
+            if (depthAt[pc + 1] >= 0)   // Already walked from this point
+                break;
+            depthAt[pc + 1] = depth;
+        }
     }
+
+    mMaxStackDepth = maxDepth;
+    return mMaxStackDepth;
 }
 
 
@@ -109,6 +205,7 @@ static const char *BYTE_CODE_COMMAND_STRING[] = {
         "APPEND_ARRAY           ",
         "APPEND_MAP             ",
         "EVALUATE               ",
+        "NUMERIC_EXPRESSION     ",  // value = index of the numeric expression
 };
 
 // This must match the enumerated ByteCodeComparison values
@@ -193,6 +290,9 @@ ByteCode::instructionAsString(int pc) const
         case BC_OPCODE_POP_JUMP_IF_FALSE:
             result += " GOTO " + std::to_string(pc + cmd.value + 1);
             break;
+        case BC_OPCODE_NUMERIC_EXPRESSION:
+            result += " [" + mNumericExpressions.at(cmd.value).toString(mData) + "]";
+            break;
         default:
             break;
     }
@@ -201,6 +301,95 @@ ByteCode::instructionAsString(int pc) const
 }
 
 
+const size_t NumericExpression::MAX_DEPTH;
+const size_t NumericExpression::MAX_SYMBOLS;
+
+Object
+NumericExpression::evaluate(const std::vector<Object>& data, BoundSymbolSet *symbolSet) const
+{
+    assert(symbols.size() <= MAX_SYMBOLS);
+
+    // Each symbol is evaluated once, no matter how many times the expression references it
+    Object values[MAX_SYMBOLS];
+    auto numeric = true;
+    for (size_t i = 0 ; i < symbols.size() ; i++) {
+        const auto& symbol = data[symbols[i]];
+        values[i] = symbol.eval();
+        if (symbolSet != nullptr)
+            symbolSet->emplace(symbol.get<BoundSymbol>());
+        numeric = numeric && values[i].isNumber();
+    }
+
+    if (numeric) {
+        double stack[MAX_DEPTH];
+        int sp = 0;
+        for (const auto& step : steps) {
+            switch (step.operation) {
+                case LOAD_NUMBER: stack[sp++] = numbers[step.index]; break;
+                case LOAD_SYMBOL: stack[sp++] = values[step.index].getDouble(); break;
+                case PLUS: break;
+                case MINUS: stack[sp - 1] = -stack[sp - 1]; break;
+                case MULTIPLY: sp--; stack[sp - 1] *= stack[sp]; break;
+                case DIVIDE: sp--; stack[sp - 1] /= stack[sp]; break;
+                case REMAINDER: sp--; stack[sp - 1] = std::fmod(stack[sp - 1], stack[sp]); break;
+                case ADD: sp--; stack[sp - 1] += stack[sp]; break;
+                case SUBTRACT: sp--; stack[sp - 1] -= stack[sp]; break;
+            }
+        }
+        assert(sp == 1);
+        return stack[0];
+    }
+
+    // The guard failed: at least one symbol no longer holds a number.
+    std::vector<Object> stack;
+    stack.reserve(MAX_DEPTH);
+    auto binary = [&](Object (*f)(const Object&, const Object&)) {
+        auto b = std::move(stack.back());
+        stack.pop_back();
+        stack.back() = f(stack.back(), b);
+    };
+
+    for (const auto& step : steps) {
+        switch (step.operation) {
+            case LOAD_NUMBER: stack.emplace_back(numbers[step.index]); break;
+            case LOAD_SYMBOL: stack.emplace_back(values[step.index]); break;
+            case PLUS: stack.back() = CalculateUnaryPlus(stack.back()); break;
+            case MINUS: stack.back() = CalculateUnaryMinus(stack.back()); break;
+            case MULTIPLY: binary(CalculateMultiply); break;
+            case DIVIDE: binary(CalculateDivide); break;
+            case REMAINDER: binary(CalculateRemainder); break;
+            case ADD: binary(CalculateAdd); break;
+            case SUBTRACT: binary(CalculateSubtract); break;
+        }
+    }
+    assert(stack.size() == 1);
+    return stack.back();
+}
+
+std::string
+NumericExpression::toString(const std::vector<Object>& data) const
+{
+    static const char *OPERATION_STRING[] = {"", "", "+x", "-x", "*", "/", "%", "+", "-"};
+
+    std::string result;
+    for (const auto& step : steps) {
+        if (!result.empty())
+            result += " ";
+        switch (step.operation) {
+            case LOAD_NUMBER:
+                result += Object(numbers[step.index]).asString();
+                break;
+            case LOAD_SYMBOL:
+                result += data.at(symbols[step.index]).toDebugString();
+                break;
+            default:
+                result += OPERATION_STRING[step.operation];
+                break;
+        }
+    }
+    return result;
+}
+
 std::string
 ByteCodeInstruction::toString() const
 {
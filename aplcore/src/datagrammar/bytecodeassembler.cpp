@@ -71,6 +71,14 @@ ByteCodeAssembler::parse(const Context& context, const std::string& value)
     if (value.find("${") == std::string::npos && value.find("#{") == std::string::npos)
         return value;
 
+    // Reuse the byte code of a previously parsed copy of this expression if possible
+    auto cache = context.byteCodeCache();
+    if (cache) {
+        auto cached = cache->find(value);
+        if (cached)
+            return instantiate(context, *cached);
+    }
+
     pegtl::string_input<> in(value, "");
     datagrammar::ByteCodeAssembler assembler(context);
     fail_state failState;
@@ -90,12 +98,54 @@ ByteCodeAssembler::parse(const Context& context, const std::string& value)
         }
 
     } else {
+        if (cache && assembler.mCacheable)
+            cache->put(value, assembler.makeTemplate());
         return assembler.retrieve();
     }
 
     return value;
 }
 
+/**
+ * Instantiate cached byte code in a new context.  Global symbols are resolved following the same
+ * rules as loadGlobal(): missing symbols become NULL, immutable symbols are copied in as constants,
+ * and mutable symbols become bound symbols.
+ */
+Object
+ByteCodeAssembler::instantiate(const Context& context, const ByteCodeTemplate& byteCodeTemplate)
+{
+    auto byteCode = std::make_shared<ByteCode>(std::const_pointer_cast<Context>(context.shared_from_this()));
+    auto& instructions = byteCode->mInstructions;
+    auto& data = byteCode->mData;
+    instructions = byteCodeTemplate.instructions;
+    data = byteCodeTemplate.data;
+
+    for (const auto& m : byteCodeTemplate.globals) {
+        auto cr = context.find(m.name);
+        if (cr.empty()) {
+            instructions.at(m.pc) = ByteCodeInstruction{BC_OPCODE_LOAD_CONSTANT, BC_CONSTANT_NULL};
+            continue;
+        }
+
+        auto index = m.dataIndex;
+        if (index < 0) {
+            index = asBCI(data.size());
+            data.emplace_back(Object::NULL_OBJECT());
+        }
+
+        if (!cr.object().isMutable()) {
+            data.at(index) = cr.object().value();
+            instructions.at(m.pc) = ByteCodeInstruction{BC_OPCODE_LOAD_DATA, index};
+        }
+        else {
+            data.at(index) = BoundSymbol(cr.context(), m.name);
+            instructions.at(m.pc) = ByteCodeInstruction{BC_OPCODE_LOAD_BOUND_SYMBOL, index};
+        }
+    }
+
+    return byteCode;
+}
+
 ByteCodeAssembler::ByteCodeAssembler(const Context& context)
     : mContext(std::const_pointer_cast<Context>(context.shared_from_this())),
       mCode{CodeUnit(mContext)}
@@ -112,6 +162,22 @@ ByteCodeAssembler::retrieve() const
     return mCode.byteCode;
 }
 
+ByteCodeTemplatePtr
+ByteCodeAssembler::makeTemplate() const
+{
+    auto result = std::make_shared<ByteCodeTemplate>();
+    result->instructions = *mInstructionRef;
+    result->data = *mDataRef;
+    result->globals = mGlobals;
+
+    // Drop the context-specific values so the template does not hold references into this context
+    for (const auto& m : mGlobals)
+        if (m.dataIndex >= 0)
+            result->data.at(m.dataIndex) = Object::NULL_OBJECT();
+
+    return result;
+}
+
 void
 ByteCodeAssembler::loadOperand(const apl::Object& value)
 {
@@ -138,12 +204,15 @@ ByteCodeAssembler::loadGlobal(const std::string& name)
 {
     auto cr = mContext->find(name);
     if (cr.empty()) { // Not found -> load NULL
+        mGlobals.emplace_back(ByteCodeTemplate::GlobalReference{mInstructionRef->size(), -1, name});
         mInstructionRef->emplace_back(
             ByteCodeInstruction{BC_OPCODE_LOAD_CONSTANT, BC_CONSTANT_NULL});
         return;
     }
 
     auto len = asBCI(mDataRef->size());
+    mGlobals.emplace_back(ByteCodeTemplate::GlobalReference{mInstructionRef->size(), len, name});
+
     // Immutable globals can be replaced by a constant value
     if (!cr.object().isMutable()) {
         mDataRef->emplace_back(cr.object().value());
@@ -156,6 +225,14 @@ ByteCodeAssembler::loadGlobal(const std::string& name)
     mInstructionRef->emplace_back(ByteCodeInstruction{BC_OPCODE_LOAD_BOUND_SYMBOL, len});
 }
 
+void
+ByteCodeAssembler::loadDimension(const std::string& value)
+{
+    // Relative dimensions are converted using the current viewport, so they can't be cached
+    mCacheable = false;
+    loadOperand(Object(Dimension(*mContext, value)));
+}
+
 void
 ByteCodeAssembler::pushAttributeName(const std::string &name)
 {
@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <cmath>
+
 #include "apl/datagrammar/bytecodeevaluator.h"
 
 #include "apl/buildTimeConstants.h"
@@ -26,11 +28,16 @@ namespace datagrammar {
 
 static const bool DEBUG_BYTE_CODE = false;
 
-ByteCodeEvaluator::ByteCodeEvaluator(const ByteCode& byteCode, BoundSymbolSet *symbols, int depth)
+ByteCodeEvaluator::ByteCodeEvaluator(const ByteCode& byteCode,
+                                     BoundSymbolSet *symbols,
+                                     int depth,
+                                     DispatchMode mode)
     : mByteCode(byteCode),
       mSymbols(symbols),
-      mEvaluationDepth(depth)
+      mEvaluationDepth(depth),
+      mDispatchMode(mode)
 {
+    mStack.reserve(byteCode.maxStackDepth());
 }
 
 static std::string
@@ -48,27 +55,120 @@ ByteCodeEvaluator::advance()
 {
     assert(mState == INIT);
 
-    const auto &instructions = mByteCode.mInstructions;
+    if (mDispatchMode == kDispatchThreaded)
+        run<true>();
+    else
+        run<false>();
+
+    // If we get to this point, the program has finished executing.
+    mState = DONE;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define APL_BYTE_CODE_COMPUTED_GOTO
+#endif
+
+/*
+ * Each instruction handler is written once.  The handler is reachable both as a switch case and,
+ * when computed goto is available, as a label in the direct-threading table.  In threaded mode
+ * each handler fetches the next instruction and jumps straight to its handler instead of
+ * returning to the top of the loop.
+ */
+#define FETCH_INSTRUCTION()                                                                  \
+    if (mProgramCounter >= len)                                                              \
+        goto done;                                                                           \
+    cmd = &instructions[mProgramCounter];                                                    \
+    LOG_IF(DEBUG_BYTE_CODE).session(mByteCode.getContext())                                  \
+        << mByteCode.instructionAsString(mProgramCounter) << " stack={" << stackToString(mStack) << "}";
+
+#ifdef APL_BYTE_CODE_COMPUTED_GOTO
+#define OPCODE(name) case BC_OPCODE_##name: op_##name
+#define NEXT_INSTRUCTION()                                                                   \
+    mProgramCounter++;                                                                       \
+    if (THREADED) {                                                                          \
+        FETCH_INSTRUCTION()                                                                  \
+        goto *DISPATCH_TABLE[cmd->type];                                                     \
+    }                                                                                        \
+    continue
+#else
+#define OPCODE(name) case BC_OPCODE_##name
+#define NEXT_INSTRUCTION()                                                                   \
+    mProgramCounter++;                                                                       \
+    continue
+#endif
+
+template<bool THREADED>
+void
+ByteCodeEvaluator::run()
+{
+    const auto *instructions = mByteCode.mInstructions.data();
     const auto &data = mByteCode.mData;
-    auto number_of_commands = instructions.size();
+    const int len = mByteCode.mInstructions.size();
+    const ByteCodeInstruction *cmd = nullptr;
+
+#ifdef APL_BYTE_CODE_COMPUTED_GOTO
+    // This must match ByteCodeOpcode
+    static const void *DISPATCH_TABLE[] = {
+        &&op_NOP,
+        &&op_CALL_FUNCTION,
+        &&op_LOAD_CONSTANT,
+        &&op_LOAD_IMMEDIATE,
+        &&op_LOAD_DATA,
+        &&op_LOAD_BOUND_SYMBOL,
+        &&op_ATTRIBUTE_ACCESS,
+        &&op_ARRAY_ACCESS,
+        &&op_UNARY_PLUS,
+        &&op_UNARY_MINUS,
+        &&op_UNARY_NOT,
+        &&op_BINARY_MULTIPLY,
+        &&op_BINARY_DIVIDE,
+        &&op_BINARY_REMAINDER,
+        &&op_BINARY_ADD,
+        &&op_BINARY_SUBTRACT,
+        &&op_COMPARE_OP,
+        &&op_JUMP,
+        &&op_JUMP_IF_FALSE_OR_POP,
+        &&op_JUMP_IF_TRUE_OR_POP,
+        &&op_JUMP_IF_NOT_NULL_OR_POP,
+        &&op_POP_JUMP_IF_FALSE,
+        &&op_MERGE_STRING,
+        &&op_APPEND_ARRAY,
+        &&op_APPEND_MAP,
+        &&op_EVALUATE,
+        &&op_NUMERIC_EXPRESSION,
+    };
+    static_assert(sizeof(DISPATCH_TABLE) / sizeof(DISPATCH_TABLE[0]) == BC_OPCODE_NUMERIC_EXPRESSION + 1,
+                  "Dispatch table must match ByteCodeOpcode");
+#endif
 
     auto pop = [&]() -> Object {
-        auto result = mStack.back();
+        auto result = std::move(mStack.back());
         mStack.pop_back();
         return result;
     };
 
+    // Replace the top two stack entries with the result of a binary operation.  Operands that
+    // are both numbers are combined in place without creating intermediate objects.
+    auto binary = [&](double (*numeric)(double, double), Object (*generic)(const Object&, const Object&)) {
+        auto& b = mStack.back();
+        auto& a = mStack[mStack.size() - 2];
+        if (a.isNumber() && b.isNumber())
+            a = numeric(a.getDouble(), b.getDouble());
+        else
+            a = generic(a, b);
+        mStack.pop_back();
+    };
+
     // For now, we'll consider a program done when it runs off the end of the code
-    for (; mProgramCounter < number_of_commands; mProgramCounter++) {
-        const auto &cmd = instructions.at(mProgramCounter);
-        LOG_IF(DEBUG_BYTE_CODE).session(mByteCode.getContext()) << mByteCode.instructionAsString(mProgramCounter)
-                                << " stack={" << stackToString(mStack) << "}";
-        switch (cmd.type) {
-            case BC_OPCODE_NOP:
-                break;
-
-            case BC_OPCODE_CALL_FUNCTION: {
-                auto argCount = cmd.value;
+    for (;;) {
+        FETCH_INSTRUCTION()
+
+        switch (cmd->type) {
+            OPCODE(NOP):
+                NEXT_INSTRUCTION();
+
+            OPCODE(CALL_FUNCTION): {
+                auto argCount = cmd->value;
                 std::vector<Object> args(argCount);  // Reserve enough space
                 while (argCount > 0)
                     args[--argCount] = pop();
@@ -80,157 +180,144 @@ ByteCodeEvaluator::advance()
                     mStack.emplace_back(Object::NULL_OBJECT());
                 }
             }
-                break;
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_LOAD_CONSTANT:
-                mStack.emplace_back(getConstant(static_cast<ByteCodeConstant>(cmd.value)));
-                break;
+            OPCODE(LOAD_CONSTANT):
+                mStack.emplace_back(getConstant(static_cast<ByteCodeConstant>(cmd->value)));
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_LOAD_IMMEDIATE:
-                mStack.emplace_back(cmd.value);
-                break;
+            OPCODE(LOAD_IMMEDIATE):
+                mStack.emplace_back(cmd->value);
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_LOAD_DATA:
-                mStack.emplace_back(data.at(cmd.value));
-                break;
+            OPCODE(LOAD_DATA):
+                mStack.emplace_back(data[cmd->value]);
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_LOAD_BOUND_SYMBOL:
-                assert(data.at(cmd.value).is<BoundSymbol>());
-                mStack.emplace_back(data.at(cmd.value).eval());
+            OPCODE(LOAD_BOUND_SYMBOL): {
+                const auto& symbol = data[cmd->value];
+                assert(symbol.is<BoundSymbol>());
+                mStack.emplace_back(symbol.eval());
                 if (mSymbols != nullptr)
-                    mSymbols->emplace(data.at(cmd.value).get<BoundSymbol>());
-                break;
+                    mSymbols->emplace(symbol.get<BoundSymbol>());
+            }
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_ATTRIBUTE_ACCESS:
-                mStack.emplace_back(CalcFieldAccess(pop(), data.at(cmd.value)));
-                break;
+            OPCODE(ATTRIBUTE_ACCESS):
+                mStack.back() = CalcFieldAccess(mStack.back(), data[cmd->value]);
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_ARRAY_ACCESS: {
+            OPCODE(ARRAY_ACCESS): {
                 auto b = pop();
-                auto a = pop();
-                mStack.emplace_back(CalcArrayAccess(a, b));
+                mStack.back() = CalcArrayAccess(mStack.back(), b);
             }
-                break;
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_UNARY_PLUS:
-                mStack.emplace_back(CalculateUnaryPlus(pop()));
-                break;
+            OPCODE(UNARY_PLUS):
+                mStack.back() = CalculateUnaryPlus(mStack.back());
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_UNARY_MINUS:
-                mStack.emplace_back(CalculateUnaryMinus(pop()));
-                break;
+            OPCODE(UNARY_MINUS):
+                if (mStack.back().isNumber())
+                    mStack.back() = -mStack.back().getDouble();
+                else
+                    mStack.back() = CalculateUnaryMinus(mStack.back());
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_UNARY_NOT:
-                mStack.emplace_back(CalculateUnaryNot(pop()));
-                break;
+            OPCODE(UNARY_NOT):
+                mStack.back() = CalculateUnaryNot(mStack.back());
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_BINARY_MULTIPLY: {
-                auto b = pop();
-                auto a = pop();
-                mStack.emplace_back(CalculateMultiply(a, b));
-            }
-                break;
+            OPCODE(BINARY_MULTIPLY):
+                binary([](double a, double b) { return a * b; }, CalculateMultiply);
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_BINARY_DIVIDE: {
-                auto b = pop();
-                auto a = pop();
-                mStack.emplace_back(CalculateDivide(a, b));
-            }
-                break;
+            OPCODE(BINARY_DIVIDE):
+                binary([](double a, double b) { return a / b; }, CalculateDivide);
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_BINARY_REMAINDER: {
-                auto b = pop();
-                auto a = pop();
-                mStack.emplace_back(CalculateRemainder(a, b));
-            }
-                break;
+            OPCODE(BINARY_REMAINDER):
+                binary([](double a, double b) { return std::fmod(a, b); }, CalculateRemainder);
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_BINARY_ADD: {
-                auto b = pop();
-                auto a = pop();
-                mStack.emplace_back(CalculateAdd(a, b));
-            }
-                break;
+            OPCODE(BINARY_ADD):
+                binary([](double a, double b) { return a + b; }, CalculateAdd);
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_BINARY_SUBTRACT: {
-                auto b = pop();
-                auto a = pop();
-                mStack.emplace_back(CalculateSubtract(a, b));
-            }
-                break;
+            OPCODE(BINARY_SUBTRACT):
+                binary([](double a, double b) { return a - b; }, CalculateSubtract);
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_COMPARE_OP: {
+            OPCODE(COMPARE_OP): {
                 auto b = pop();
-                auto a = pop();
-                mStack.emplace_back(CompareOp(static_cast<ByteCodeComparison>(cmd.value), a, b)
-                                        ? Object::TRUE_OBJECT() : Object::FALSE_OBJECT());
+                auto& a = mStack.back();
+                a = CompareOp(static_cast<ByteCodeComparison>(cmd->value), a, b)
+                        ? Object::TRUE_OBJECT() : Object::FALSE_OBJECT();
             }
-                break;
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_JUMP:
-                assert(cmd.value != -1);
-                mProgramCounter += cmd.value;
-                break;
+            OPCODE(JUMP):
+                assert(cmd->value != -1);
+                mProgramCounter += cmd->value;
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_JUMP_IF_FALSE_OR_POP:
-                assert(cmd.value != -1);
+            OPCODE(JUMP_IF_FALSE_OR_POP):
+                assert(cmd->value != -1);
                 if (!mStack.back().truthy())
-                    mProgramCounter += cmd.value;
+                    mProgramCounter += cmd->value;
                 else
                     mStack.pop_back();
-                break;
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_JUMP_IF_TRUE_OR_POP:
-                assert(cmd.value != -1);
+            OPCODE(JUMP_IF_TRUE_OR_POP):
+                assert(cmd->value != -1);
                 if (mStack.back().truthy())
-                    mProgramCounter += cmd.value;
+                    mProgramCounter += cmd->value;
                 else
                     mStack.pop_back();
-                break;
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_JUMP_IF_NOT_NULL_OR_POP:
-                assert(cmd.value != -1);
+            OPCODE(JUMP_IF_NOT_NULL_OR_POP):
+                assert(cmd->value != -1);
                 if (!mStack.back().isNull())
-                    mProgramCounter += cmd.value;
+                    mProgramCounter += cmd->value;
                 else
                     mStack.pop_back();
-                break;
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_POP_JUMP_IF_FALSE:
-                assert(cmd.value != -1);
+            OPCODE(POP_JUMP_IF_FALSE):
+                assert(cmd->value != -1);
                 if (!pop().truthy())
-                    mProgramCounter += cmd.value;
-                break;
+                    mProgramCounter += cmd->value;
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_MERGE_STRING: {
+            OPCODE(MERGE_STRING): {
                 auto result = pop();
-                for (int i = 1; i < cmd.value; i++)
+                for (int i = 1; i < cmd->value; i++)
                     result = MergeOp(pop(), result);
                 mStack.emplace_back(std::move(result));
             }
-                break;
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_APPEND_ARRAY: {
+            OPCODE(APPEND_ARRAY): {
                 auto b = pop();
-                auto a = pop();
+                auto& a = mStack.back();
                 assert(a.isArray());
                 a.getMutableArray().push_back(std::move(b));
-                mStack.emplace_back(std::move(a));
             }
-                break;
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_APPEND_MAP: {
+            OPCODE(APPEND_MAP): {
                 auto c = pop();
                 auto b = pop();
-                auto a = pop();
+                auto& a = mStack.back();
                 assert(a.isMap());
                 a.getMutableMap().emplace(b.asString(), std::move(c));
-                mStack.emplace_back(std::move(a));
             }
-                break;
+                NEXT_INSTRUCTION();
 
-            case BC_OPCODE_EVALUATE: {
-                auto result = pop();
+            OPCODE(EVALUATE): {
+                auto& result = mStack.back();
                 auto context = mByteCode.getContext();
                 if (context) {
                     if (mEvaluationDepth >= kEvaluationDepthLimit)
@@ -239,16 +326,26 @@ ByteCodeEvaluator::advance()
                     else
                         result = evaluateInternal(*context, result, mSymbols, mEvaluationDepth + 1);
                 }
-                mStack.emplace_back(result);
             }
-                break;
+                NEXT_INSTRUCTION();
+
+            OPCODE(NUMERIC_EXPRESSION):
+                mStack.emplace_back(mByteCode.mNumericExpressions[cmd->value].evaluate(data, mSymbols));
+                NEXT_INSTRUCTION();
         }
+
+        // Unknown opcode
+        mProgramCounter++;
     }
 
-    // If we get to this point, the program has finished executing.
-    mState = DONE;
+done:
+    return;
 }
 
+#undef OPCODE
+#undef NEXT_INSTRUCTION
+#undef FETCH_INSTRUCTION
+
 Object
 ByteCodeEvaluator::getResult() const
 {
@@ -71,6 +71,25 @@ findBasicBlocks(const std::vector<ByteCodeInstruction>& commands)
     return result;
 }
 
+/**
+ * Move an item from the byte code data into a new operand list, re-using a matching operand if
+ * one has already been stored.
+ * @return The index of the item in the new operand list
+ */
+int
+ByteCodeOptimizer::storeOperand(std::vector<Object>& operands, int index)
+{
+    auto& object = mByteCode.mData.at(index);
+
+    // If the value is already in an operand, use that one
+    auto it = std::find(operands.begin(), operands.end(), object);
+    if (it != operands.end())
+        return static_cast<int>(std::distance(operands.begin(), it));
+
+    operands.emplace_back(std::move(object));
+    return static_cast<int>(operands.size() - 1);
+}
+
 void
 ByteCodeOptimizer::simplifyOperands()
 {
@@ -80,18 +99,12 @@ ByteCodeOptimizer::simplifyOperands()
         switch (cmd.type) {
             case BC_OPCODE_LOAD_DATA:
             case BC_OPCODE_ATTRIBUTE_ACCESS:
-            case BC_OPCODE_LOAD_BOUND_SYMBOL: {
-                auto& object = mByteCode.mData.at(cmd.value);
-
-                // If the value is already in an operand, use that one
-                auto it = std::find(operands.begin(), operands.end(), object);
-                if (it != operands.end())
-                    cmd.value = static_cast<bciValueType>(std::distance(operands.begin(), it));
-                else {
-                    cmd.value = static_cast<bciValueType>(operands.size());
-                    operands.emplace_back(std::move(object));
-                }
-            }
+            case BC_OPCODE_LOAD_BOUND_SYMBOL:
+                cmd.value = static_cast<bciValueType>(storeOperand(operands, cmd.value));
+                break;
+            case BC_OPCODE_NUMERIC_EXPRESSION:
+                for (auto& index : mByteCode.mNumericExpressions.at(cmd.value).symbols)
+                    index = storeOperand(operands, index);
                 break;
             default:
                 break;
@@ -472,6 +485,220 @@ ByteCodeOptimizer::simplifyOperations()
     instructions = output;
 }
 
+/**
+ * Convert a run of numeric loads and arithmetic operations into a NumericExpression.
+ * @param start The first instruction in the run
+ * @param end One past the last instruction in the run
+ */
+NumericExpression
+ByteCodeOptimizer::buildNumericExpression(int start, int end) const
+{
+    const auto& data = mByteCode.mData;
+    NumericExpression expression;
+
+    auto add = [&](NumericExpression::Operation operation, int index) {
+        expression.steps.emplace_back(NumericExpression::Step{operation, index});
+    };
+
+    for (int pc = start; pc < end; pc++) {
+        const auto& cmd = mByteCode.mInstructions.at(pc);
+        switch (cmd.type) {
+            case BC_OPCODE_LOAD_IMMEDIATE:
+                add(NumericExpression::LOAD_NUMBER, static_cast<int>(expression.numbers.size()));
+                expression.numbers.emplace_back(cmd.value);
+                break;
+            case BC_OPCODE_LOAD_DATA:
+                add(NumericExpression::LOAD_NUMBER, static_cast<int>(expression.numbers.size()));
+                expression.numbers.emplace_back(data.at(cmd.value).getDouble());
+                break;
+            case BC_OPCODE_LOAD_BOUND_SYMBOL: {
+                // Each distinct symbol is only evaluated once
+                auto it = std::find_if(expression.symbols.begin(), expression.symbols.end(),
+                                       [&](int index) { return data.at(index) == data.at(cmd.value); });
+                auto slot = static_cast<int>(std::distance(expression.symbols.begin(), it));
+                if (it == expression.symbols.end())
+                    expression.symbols.emplace_back(cmd.value);
+                add(NumericExpression::LOAD_SYMBOL, slot);
+            }
+                break;
+            case BC_OPCODE_UNARY_PLUS: add(NumericExpression::PLUS, 0); break;
+            case BC_OPCODE_UNARY_MINUS: add(NumericExpression::MINUS, 0); break;
+            case BC_OPCODE_BINARY_MULTIPLY: add(NumericExpression::MULTIPLY, 0); break;
+            case BC_OPCODE_BINARY_DIVIDE: add(NumericExpression::DIVIDE, 0); break;
+            case BC_OPCODE_BINARY_REMAINDER: add(NumericExpression::REMAINDER, 0); break;
+            case BC_OPCODE_BINARY_ADD: add(NumericExpression::ADD, 0); break;
+            case BC_OPCODE_BINARY_SUBTRACT: add(NumericExpression::SUBTRACT, 0); break;
+            default:
+                assert(false);
+                break;
+        }
+    }
+
+    return expression;
+}
+
+/**
+ * Numeric specialization
+ *
+ * Replace each arithmetic sub-expression whose operands are numeric constants or bound symbols
+ * that currently hold numbers with a single NUMERIC_EXPRESSION instruction.  The sub-expression
+ * is evaluated on raw doubles; the NumericExpression falls back to generic Object arithmetic if
+ * a symbol changes type.  For example:
+ *
+ *   LOAD_BOUND_SYMBOL(a) LOAD_DATA(0.5) BINARY_MULTIPLY LOAD_IMMEDIATE(2)
+ *   LOAD_BOUND_SYMBOL(b) BINARY_MULTIPLY BINARY_SUBTRACT  -> NUMERIC_EXPRESSION(a 0.5 * 2 b * -)
+ *
+ * Only sub-expressions that reference at least one symbol and perform at least one operation are
+ * replaced; everything else has already been folded or is cheaper to leave alone.
+ */
+void
+ByteCodeOptimizer::specializeNumeric()
+{
+    auto& instructions = mByteCode.mInstructions;
+    const auto& data = mByteCode.mData;
+    const auto len = static_cast<int>(instructions.size());
+
+    auto isNumericLoad = [&](const ByteCodeInstruction& cmd) {
+        switch (cmd.type) {
+            case BC_OPCODE_LOAD_IMMEDIATE:
+                return true;
+            case BC_OPCODE_LOAD_DATA:
+                return data.at(cmd.value).isNumber();
+            case BC_OPCODE_LOAD_BOUND_SYMBOL:
+                return data.at(cmd.value).eval().isNumber();
+            default:
+                return false;
+        }
+    };
+
+    // A sub-expression under construction.  Sub-expressions are contiguous, so each one runs from
+    // its start to the start of the next one (or to the end of the run).
+    struct Candidate {
+        int start;
+        int depth;      // Stack depth needed to evaluate the sub-expression
+        bool hasSymbol;
+        bool hasOperation;
+    };
+
+    auto blocks = findBasicBlocks(instructions);
+    std::vector<std::pair<int, int>> segments;   // [start, end) ranges to replace
+    std::vector<Candidate> candidates;
+
+    auto flush = [&](int end) {
+        for (size_t i = 0; i < candidates.size(); i++) {
+            const auto& c = candidates.at(i);
+            if (c.hasSymbol && c.hasOperation && static_cast<size_t>(c.depth) <= NumericExpression::MAX_DEPTH)
+                segments.emplace_back(c.start, i + 1 < candidates.size() ? candidates.at(i + 1).start : end);
+        }
+        candidates.clear();
+    };
+
+    for (int pc = 0; pc < len; pc++) {
+        const auto& cmd = instructions.at(pc);
+        if (blocks.count(pc))   // Sub-expressions may not span a jump target
+            flush(pc);
+
+        switch (cmd.type) {
+            case BC_OPCODE_LOAD_IMMEDIATE:
+            case BC_OPCODE_LOAD_DATA:
+            case BC_OPCODE_LOAD_BOUND_SYMBOL:
+                if (isNumericLoad(cmd))
+                    candidates.emplace_back(Candidate{pc, 1, cmd.type == BC_OPCODE_LOAD_BOUND_SYMBOL, false});
+                else
+                    flush(pc);
+                break;
+
+            case BC_OPCODE_UNARY_PLUS:
+            case BC_OPCODE_UNARY_MINUS:
+                if (candidates.empty())
+                    break;
+                candidates.back().hasOperation = true;
+                break;
+
+            case BC_OPCODE_BINARY_MULTIPLY:
+            case BC_OPCODE_BINARY_DIVIDE:
+            case BC_OPCODE_BINARY_REMAINDER:
+            case BC_OPCODE_BINARY_ADD:
+            case BC_OPCODE_BINARY_SUBTRACT:
+                if (candidates.size() < 2) {   // The left operand was calculated before this run
+                    flush(pc);
+                    break;
+                }
+                {
+                    auto rhs = candidates.back();
+                    candidates.pop_back();
+                    auto& lhs = candidates.back();
+                    lhs.depth = std::max(lhs.depth, rhs.depth + 1);
+                    lhs.hasSymbol = lhs.hasSymbol || rhs.hasSymbol;
+                    lhs.hasOperation = true;
+                }
+                break;
+
+            default:
+                flush(pc);
+                break;
+        }
+    }
+    flush(len);
+
+    if (segments.empty())
+        return;
+
+    // Rewrite the instructions, tracking where each old instruction moved to so jumps can be fixed
+    std::vector<ByteCodeInstruction> output;
+    std::vector<int> newLocation(len + 1, -1);
+    auto segment = segments.begin();
+
+    for (int pc = 0; pc < len; pc++) {
+        newLocation[pc] = static_cast<int>(output.size());
+        if (segment == segments.end() || pc != segment->first) {
+            output.emplace_back(instructions.at(pc));
+            continue;
+        }
+
+        auto expression = buildNumericExpression(segment->first, segment->second);
+        if (expression.symbols.size() > NumericExpression::MAX_SYMBOLS) {
+            // Too many distinct symbols to evaluate in place; keep the generic instructions
+            for ( ; pc < segment->second; pc++) {
+                newLocation[pc] = static_cast<int>(output.size());
+                output.emplace_back(instructions.at(pc));
+            }
+        }
+        else {
+            output.emplace_back(ByteCodeInstruction{BC_OPCODE_NUMERIC_EXPRESSION,
+                                                    static_cast<bciValueType>(mByteCode.mNumericExpressions.size())});
+            mByteCode.mNumericExpressions.emplace_back(std::move(expression));
+            pc = segment->second;
+        }
+
+        pc--;   // The loop increment moves to the first instruction after the segment
+        segment++;
+    }
+    newLocation[len] = static_cast<int>(output.size());
+
+    // Jump targets are never inside a replaced segment, so each one has a new location
+    for (int pc = 0; pc < len; pc++) {
+        const auto& cmd = instructions.at(pc);
+        switch (cmd.type) {
+            case BC_OPCODE_JUMP:
+            case BC_OPCODE_JUMP_IF_FALSE_OR_POP:
+            case BC_OPCODE_JUMP_IF_TRUE_OR_POP:
+            case BC_OPCODE_JUMP_IF_NOT_NULL_OR_POP:
+            case BC_OPCODE_POP_JUMP_IF_FALSE: {
+                auto target = newLocation.at(pc + cmd.value + 1);
+                assert(target >= 0);
+                auto location = newLocation.at(pc);
+                output.at(location).value = target - location - 1;
+            }
+                break;
+            default:
+                break;
+        }
+    }
+
+    instructions = output;
+}
+
 ByteCodeOptimizer::ByteCodeOptimizer(ByteCode &byteCode)
     : mByteCode(byteCode)
 {
@@ -483,6 +710,7 @@ ByteCodeOptimizer::optimize(ByteCode& byteCode)
     if (!byteCode.mInstructions.empty()) {
         ByteCodeOptimizer bco(byteCode);
         bco.simplifyOperations();
+        bco.specializeNumeric();
         bco.simplifyOperands();
     }
 }
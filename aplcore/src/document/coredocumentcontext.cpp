@@ -281,6 +281,8 @@ CoreDocumentContext::init(const Metrics& metrics,
 
     auto env = mContent->getEnvironment(config);
     mCore->lang(env.language).layoutDirection(env.layoutDirection);
+    if (config.experimentalFeatureEnabled(RootConfig::kExperimentalFeaturePooledAllocation))
+        mCore->objectPool(std::make_shared<ObjectPool>());
 
     mContext = Context::createRootEvaluationContext(metrics, mCore);
     mContext->putSystemWriteable(ELAPSED_TIME, config.getTimeManager()->currentTime());
@@ -390,7 +392,7 @@ rapidjson::Value
 CoreDocumentContext::serializeVisualContext(rapidjson::Document::AllocatorType& allocator)
 {
     clearVisualContextDirty();
-    return mCore->mTop->serializeVisualContext(allocator);
+    return mCore->mTop->serializeDocumentVisualContext(allocator);
 }
 
 bool
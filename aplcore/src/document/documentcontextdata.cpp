@@ -15,6 +15,7 @@
 
 #include "apl/document/documentcontextdata.h"
 
+#include "apl/datagrammar/bytecodecache.h"
 #include "apl/engine/keyboardmanager.h"
 #include "apl/engine/layoutmanager.h"
 #include "apl/engine/sharedcontextdata.h"
@@ -54,6 +55,7 @@ DocumentContextData::DocumentContextData(
       mDataManager(new LiveDataManager()),
       mExtensionManager(new ExtensionManager(extensions, config, session)),
       mUniqueIdManager(new UIDManager(sharedContext->uidGenerator(), session)),
+      mByteCodeCache(new datagrammar::ByteCodeCache()),
       mSession(session)
 {}
 
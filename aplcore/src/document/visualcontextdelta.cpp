@@ -0,0 +1,148 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/document/visualcontextdelta.h"
+
+namespace apl {
+
+static const char *CHILDREN = "children";
+static const char *UID = "uid";
+
+/**
+ * @return The uid of a visual context entry or nullptr if it does not have one.
+ */
+static const rapidjson::Value *
+uidOf(const rapidjson::Value& entry)
+{
+    if (!entry.IsObject())
+        return nullptr;
+
+    auto it = entry.FindMember(UID);
+    return it != entry.MemberEnd() && it->value.IsString() ? &it->value : nullptr;
+}
+
+/**
+ * Copy a visual context entry, replacing the children with the list of their uids.
+ */
+template<typename Value, typename Allocator>
+static Value
+flatten(const rapidjson::Value& entry, Allocator& allocator)
+{
+    Value result(rapidjson::kObjectType);
+    for (const auto& m : entry.GetObject()) {
+        if (m.name == CHILDREN && m.value.IsArray()) {
+            Value uids(rapidjson::kArrayType);
+            for (const auto& child : m.value.GetArray()) {
+                auto uid = uidOf(child);
+                if (uid)
+                    uids.PushBack(Value(*uid, allocator), allocator);
+            }
+            result.AddMember(Value(m.name, allocator), uids, allocator);
+        } else {
+            result.AddMember(Value(m.name, allocator), Value(m.value, allocator), allocator);
+        }
+    }
+    return result;
+}
+
+/**
+ * @return True if the entry matches a flattened copy of a previous entry.
+ */
+template<typename Value>
+static bool
+sameEntry(const rapidjson::Value& entry, const Value& stored)
+{
+    if (entry.MemberCount() != stored.MemberCount())
+        return false;
+
+    for (const auto& m : entry.GetObject()) {
+        auto it = stored.FindMember(m.name);
+        if (it == stored.MemberEnd())
+            return false;
+
+        if (m.name == CHILDREN && m.value.IsArray()) {
+            auto uids = it->value.Begin();
+            for (const auto& child : m.value.GetArray()) {
+                auto uid = uidOf(child);
+                if (!uid)
+                    continue;
+                if (uids == it->value.End() || *uids != *uid)
+                    return false;
+                uids++;
+            }
+            if (uids != it->value.End())
+                return false;
+        } else if (m.value != it->value) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+rapidjson::Value
+VisualContextDelta::update(const rapidjson::Value& visualContext,
+                           rapidjson::Document::AllocatorType& allocator)
+{
+    mGeneration++;
+
+    rapidjson::Value changed(rapidjson::kArrayType);
+    visit(visualContext, changed, allocator);
+
+    // Anything not visited has left the visual context
+    rapidjson::Value removed(rapidjson::kArrayType);
+    for (auto it = mEntries.begin(); it != mEntries.end();) {
+        if (it->second.generation != mGeneration) {
+            removed.PushBack(rapidjson::Value(it->first.c_str(), allocator), allocator);
+            it = mEntries.erase(it);
+        } else {
+            it++;
+        }
+    }
+
+    rapidjson::Value result(rapidjson::kObjectType);
+    result.AddMember("changed", changed, allocator);
+    result.AddMember("removed", removed, allocator);
+    return result;
+}
+
+void
+VisualContextDelta::visit(const rapidjson::Value& entry, rapidjson::Value& changed,
+                          rapidjson::Document::AllocatorType& allocator)
+{
+    auto uid = uidOf(entry);
+    if (!uid)
+        return;
+
+    auto key = std::string(uid->GetString(), uid->GetStringLength());
+    auto it = mEntries.find(key);
+    if (it == mEntries.end()) {
+        it = mEntries.emplace(key, Entry{flatten<StoredValue>(entry, mStoredAllocator), mGeneration}).first;
+        changed.PushBack(rapidjson::Value(it->second.value, allocator), allocator);
+    } else {
+        it->second.generation = mGeneration;
+        if (!sameEntry(entry, it->second.value)) {
+            it->second.value = flatten<StoredValue>(entry, mStoredAllocator);
+            changed.PushBack(rapidjson::Value(it->second.value, allocator), allocator);
+        }
+    }
+
+    auto children = entry.FindMember(CHILDREN);
+    if (children != entry.MemberEnd() && children->value.IsArray())
+        for (const auto& child : children->value.GetArray())
+            visit(child, changed, allocator);
+}
+
+} // namespace apl
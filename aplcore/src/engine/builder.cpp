@@ -61,7 +61,6 @@ namespace apl {
 const bool DEBUG_BUILDER = false;
 
 const char* WHEN_FIELD = "when";
-const char* ITEM_INDEX = "__itemIndex";
 
 static const std::map<std::string, MakeComponentFunc> sComponentMap = {
     {"Container",              ContainerComponent::create},
@@ -182,7 +181,7 @@ Builder::populateSingleChildLayout(const ContextPtr& context,
     if (CoreDocumentContext::cast(context->documentContext())
             ->content()
             ->reactiveConditionalInflation())
-        context->putConstant(REBUILD_ITEMS, std::make_shared<ObjectArray>(items));
+        context->putConstant(REBUILD_ITEMS, makePooled<ObjectArray>(context->objectPool(), items));
 
     layout->appendChild(child, useDirtyFlag);
 }
@@ -240,7 +239,8 @@ Builder::populateLayoutComponent(const ContextPtr& context,
         if (CoreDocumentContext::cast(context->documentContext())
                 ->content()
                 ->reactiveConditionalInflation())
-            layout->getContext()->putConstant(REBUILD_FIRST_ITEMS, std::make_shared<ObjectArray>(firstItems));
+            layout->getContext()->putConstant(REBUILD_FIRST_ITEMS,
+                                              makePooled<ObjectArray>(context->objectPool(), firstItems));
 
         if (child && child->isValid()) {
             hasFirstItem = true;
@@ -314,7 +314,8 @@ Builder::populateLayoutComponent(const ContextPtr& context,
             if (CoreDocumentContext::cast(context->documentContext())
                     ->content()
                     ->reactiveConditionalInflation())
-                layout->getContext()->putConstant(REBUILD_ITEMS, std::make_shared<ObjectArray>(items));
+                layout->getContext()->putConstant(REBUILD_ITEMS,
+                                              makePooled<ObjectArray>(context->objectPool(), items));
         }
     }
 
@@ -330,7 +331,8 @@ Builder::populateLayoutComponent(const ContextPtr& context,
         if (CoreDocumentContext::cast(context->documentContext())
                 ->content()
                 ->reactiveConditionalInflation())
-            layout->getContext()->putConstant(REBUILD_LAST_ITEMS, std::make_shared<ObjectArray>(lastItems));
+            layout->getContext()->putConstant(REBUILD_LAST_ITEMS,
+                                              makePooled<ObjectArray>(context->objectPool(), lastItems));
 
         if (child && child->isValid()) {
             hasLastItem = true;
@@ -433,6 +435,9 @@ Builder::expandSingleComponent(const ContextPtr& context,
             } else if (component->multiChild()) {
                 populateLayoutComponent(expanded, item, component, path, true, useDirtyFlag);
             }
+
+            if (parent && parent->virtualizesChildren() && (component->singleChild() || component->multiChild()))
+                expanded->putConstant(REBUILD_VIRTUAL_ITEM, item);
         } else {
             expanded->putConstant("_item", item);
         }
@@ -560,7 +565,7 @@ Builder::expandSingleComponentFromArray(const ContextPtr& context,
 
         if (propertyAsBoolean(*context, item, WHEN_FIELD, true)) {
             if (old) {
-                auto oldItemIndex = context->opt(ITEM_INDEX).getInteger();
+                auto oldItemIndex = context->opt(REBUILD_ITEM_INDEX).getInteger();
                 if (oldItemIndex == index) {
                     // See if same definition "root"
                     auto oldPathString = old->getPathObject().toString();
@@ -582,8 +587,8 @@ Builder::expandSingleComponentFromArray(const ContextPtr& context,
 
             if (result != nullptr && result != old) {
                 // Record index of selected item
-                context->remove(ITEM_INDEX);
-                context->putSystemWriteable(ITEM_INDEX, index);
+                context->remove(REBUILD_ITEM_INDEX);
+                context->putSystemWriteable(REBUILD_ITEM_INDEX, index);
             }
             break;
         }
@@ -157,11 +157,17 @@ Context::createRootEvaluationContext(const Metrics& metrics, const ContextDataPt
     return contextPtr;
 }
 
+ContextPtr
+Context::createFromParent(const ContextPtr& parent)
+{
+    return makePooled<Context>(parent->mCore->objectPool(), parent);
+}
+
 ContextPtr
 Context::createClean(const ContextPtr& other)
 {
     auto context = other->top();
-    return std::make_shared<Context>(context);
+    return makePooled<Context>(context->mCore->objectPool(), context);
 }
 
 DocumentContextDataPtr documentContextData(const ContextDataPtr& data) {
@@ -213,6 +219,14 @@ Context::Context( const Metrics& metrics, const ContextDataPtr& core )
     : mCore(core)
 {
     assert(mCore);
+
+    // Every document attached to a root shares one symbol table; free-standing contexts get their own
+    if (mCore->fullContext() && documentContextData(mCore)->getShared())
+        mSymbolTable = documentContextData(mCore)->getShared()->symbolTable();
+    else
+        mSymbolTable = std::make_shared<SymbolTable>();
+    mSymbols = mSymbolTable.get();
+
     init(metrics, core);
 }
 
@@ -496,6 +510,12 @@ Context::session() const
     return mCore->session();
 }
 
+const ObjectPoolPtr&
+Context::objectPool() const
+{
+    return mCore->objectPool();
+}
+
 const YogaConfig&
 Context::ygconfig() const
 {
@@ -536,6 +556,15 @@ Context::documentContext() const
     return documentContextData(mCore)->documentContext();
 }
 
+datagrammar::ByteCodeCache*
+Context::byteCodeCache() const
+{
+    if (!mCore->fullContext())
+        return nullptr;
+
+    return &documentContextData(mCore)->byteCodeCache();
+}
+
 sg::TextLayoutCache&
 Context::textLayoutCache() const
 {
@@ -562,7 +591,7 @@ Context::serialize(rapidjson::Document::AllocatorType& allocator)
 {
     rapidjson::Value out(rapidjson::kArrayType);
 
-    for (const auto& m : mMap) {
+    for (const auto& m : *this) {
         rapidjson::Value entry(rapidjson::kObjectType);
         entry.AddMember("name", rapidjson::StringRef(m.first.c_str()), allocator);
         entry.AddMember("prov",
@@ -583,7 +612,7 @@ Context::serialize(rapidjson::Document::AllocatorType& allocator)
 streamer&
 operator<<(streamer& os, const Context& context)
 {
-    for (const auto & it : context.mMap) {
+    for (const auto & it : context) {
         os << it.first << ": " << it.second << "\n";
     }
 
@@ -597,11 +626,11 @@ operator<<(streamer& os, const Context& context)
 bool
 Context::userUpdateAndRecalculate(const std::string& key, const Object& value, bool useDirtyFlag)
 {
-    auto it = mMap.find(key);
-    if (it != mMap.end()) {
-        if (it->second.isUserWriteable()) {
+    auto object = findLocal(mSymbols->find(key));
+    if (object != nullptr) {
+        if (object->isUserWriteable()) {
             removeUpstream(key);  // Break any dependency chain
-            if (it->second.set(value)) { // If the value changes, recalculate downstream values
+            if (object->set(value)) { // If the value changes, recalculate downstream values
                 enqueueDownstream(key);
                 dependantManager().processDependencies(useDirtyFlag);
             }
@@ -621,13 +650,13 @@ Context::userUpdateAndRecalculate(const std::string& key, const Object& value, b
 bool
 Context::systemUpdateAndRecalculate(const std::string& key, const Object& value, bool useDirtyFlag)
 {
-    auto it = mMap.find(key);
-    if (it == mMap.end())
+    auto object = findLocal(mSymbols->find(key));
+    if (object == nullptr)
         return false;
 
-    if (it->second.isMutable()) {
+    if (object->isMutable()) {
         removeUpstream(key);  // Break any dependency chain
-        if (it->second.set(value)) { // If the value changes, recalculate downstream values
+        if (object->set(value)) { // If the value changes, recalculate downstream values
             enqueueDownstream(key);
             dependantManager().processDependencies(useDirtyFlag);
         }
@@ -36,6 +36,7 @@
 #include "apl/graphic/graphic.h"
 #include "apl/livedata/livedatamanager.h"
 #include "apl/media/mediamanager.h"
+#include "apl/time/framebudget.h"
 #include "apl/time/sequencer.h"
 #include "apl/time/timemanager.h"
 #include "apl/touch/pointermanager.h"
@@ -153,20 +154,64 @@ CoreRootContext::init(const Metrics& metrics,
 void
 CoreRootContext::clearPending() const
 {
+    assert(mTopDocument && mShared);
+
+    // An explicit call applies everything, including changes deferred by a budgeted call
+    mTopDocument->mCore->dataManager().resumeDeferred();
+    mShared->documentRegistrar().forEach([](const CoreDocumentContextPtr& document) {
+        document->mCore->dataManager().resumeDeferred();
+    });
+
     clearPendingInternal(false);
 }
 
+bool
+CoreRootContext::clearPending(apl_duration_t budget) const
+{
+    FrameBudget frame(budget);
+    clearPendingInternal(false, &frame);
+
+    mClearPendingStats.flushed = frame.units();
+    mClearPendingStats.deferred = deferredDataUpdates();
+    mClearPendingStats.elapsed = frame.elapsed();
+    return mClearPendingStats.deferred > 0;
+}
+
+ClearPendingStats
+CoreRootContext::getClearPendingStats() const
+{
+    return mClearPendingStats;
+}
+
+size_t
+CoreRootContext::deferredDataUpdates() const
+{
+    auto deferred = mTopDocument->mCore->dataManager().deferred();
+    mShared->documentRegistrar().forEach([&](const CoreDocumentContextPtr& document) {
+        deferred += document->mCore->dataManager().deferred();
+    });
+    return deferred;
+}
+
 void
-CoreRootContext::clearPendingInternal(bool first) const
+CoreRootContext::clearPendingInternal(bool first, FrameBudget *budget) const
 {
     assert(mTopDocument && mShared);
 
     APL_TRACE_BLOCK("RootContext:clearPending");
-    // Flush any dynamic data changes, for all documents
-    mTopDocument->mCore->dataManager().flushDirty();
-    mShared->documentRegistrar().forEach([](const CoreDocumentContextPtr& document) {
-        return document->mCore->dataManager().flushDirty();
-    });
+    // Flush any dynamic data changes, for all documents.  With a frame budget only part of the
+    // data may be flushed; everything below still runs so that the applied changes are complete.
+    if (budget) {
+        mTopDocument->mCore->dataManager().flushDirty(*budget);
+        mShared->documentRegistrar().forEach([&](const CoreDocumentContextPtr& document) {
+            document->mCore->dataManager().flushDirty(*budget);
+        });
+    } else {
+        mTopDocument->mCore->dataManager().flushDirty();
+        mShared->documentRegistrar().forEach([](const CoreDocumentContextPtr& document) {
+            return document->mCore->dataManager().flushDirty();
+        });
+    }
 
     // Make sure any pending events have executed
     mTimeManager->runPending();
@@ -194,7 +239,7 @@ bool
 CoreRootContext::hasEvent() const
 {
     assert(mShared);
-    clearPending();
+    clearPendingInternal(false);
 
     return !mShared->eventManager().empty();
 }
@@ -203,7 +248,7 @@ Event
 CoreRootContext::popEvent()
 {
     assert(mShared);
-    clearPending();
+    clearPendingInternal(false);
 
     if (!mShared->eventManager().empty()) {
         return mShared->eventManager().pop();
@@ -218,7 +263,7 @@ bool
 CoreRootContext::isDirty() const
 {
     assert(mTopDocument);
-    clearPending();
+    clearPendingInternal(false);
     return !mShared->dirtyComponents().empty();
 }
 
@@ -226,10 +271,21 @@ const std::set<ComponentPtr>&
 CoreRootContext::getDirty()
 {
     assert(mTopDocument);
-    clearPending();
+    clearPendingInternal(false);
     return mShared->dirtyComponents().getAll();
 }
 
+void
+CoreRootContext::getDirtyProperties(DirtyPropertyBuffer& buffer)
+{
+    assert(mTopDocument);
+    clearPendingInternal(false);
+    buffer.clear();
+    for (const auto& component : mShared->dirtyComponents().getAll())
+        for (auto key : component->getDirty())
+            buffer.append(*component, key, component->getCalculated(key));
+}
+
 void
 CoreRootContext::clearDirty()
 {
@@ -483,7 +539,7 @@ bool
 CoreRootContext::screenLock() const
 {
     assert(mShared);
-    clearPending();
+    clearPendingInternal(false);
     return mShared->screenLock();
 }
 
@@ -751,10 +807,14 @@ CoreRootContext::getSceneGraph()
     if (mShared->layoutManager().needsLayout())
         mShared->layoutManager().layout(true, false);
 
-    if (!mSceneGraph)
+    if (!mSceneGraph) {
         mSceneGraph = sg::SceneGraph::create();
+        if (getRootConfig().experimentalFeatureEnabled(RootConfig::kExperimentalFeatureSceneGraphPool))
+            mSceneGraph->setObjectPool(std::make_shared<ObjectPool>());
+    }
 
     mSceneGraph->setViewportSize(mViewportSize);
+    sg::BuilderPoolScope poolScope(mSceneGraph->getObjectPool());
 
     if (mSceneGraph->getLayer()) {
         mSceneGraph->updates().clear();
@@ -14,6 +14,8 @@
  *
  */
 
+#include <algorithm>
+
 #include "apl/engine/dependant.h"
 #include "apl/engine/dependantmanager.h"
 #include "apl/utils/log.h"
@@ -23,33 +25,35 @@ namespace apl {
 const bool DEBUG_DEPENDANT_MANAGER = false;
 
 /**
- * We enqueue dependencies into the list sorted in topological order.
- * For now we store them in normal order in a vector - which means we are generally
- * adding to the _back_ of the vector, but popping elements from the _front.  Arguably
- * we could store them in reverse order (since popping from the back is fast), but that
- * would mean most add operations are in the front.  Or we could try a dequeue or linked-list
- * approach.  We'll keep it simple until there is time to do performance measurements.
+ * Heap comparison.  The standard heap algorithms build a max-heap, so we invert the
+ * topological comparison to keep the lowest sort order at the front.
+ */
+static bool
+laterInOrder(const DependantPtr& lhs, const DependantPtr& rhs)
+{
+    return *rhs < *lhs;
+}
+
+/**
+ * We enqueue dependencies into a binary heap keyed on topological sort order.  Dependants
+ * are normally enqueued in increasing sort order (a fan-out walks the downstream list in
+ * creation order), which makes the heap push effectively constant time.  Duplicate
+ * entries are rejected using the intrusive "queued" flag on the dependant rather than by
+ * searching the queue.
  */
 void
 DependantManager::enqueueDependency(const DependantPtr& dependant)
 {
     assert(dependant);
-    LOG_IF(DEBUG_DEPENDANT_MANAGER) << "Enqueue dependant: " << dependant->toDebugString();
-
-    // Find the first element in the queue that is greater-than or equal-to dependant
-    auto it = std::lower_bound(mProcessList.begin(),
-                               mProcessList.end(),
-                               dependant,
-                               [](const DependantPtr& lhs,
-                                  const DependantPtr& rhs){
-                                   return *lhs < *rhs;
-                               });
 
-    // Check if it is already in the queue
-    if (it != mProcessList.end() && *it == dependant)
+    if (dependant->mQueued)
         return;
 
-    mProcessList.insert(it, dependant);
+    LOG_IF(DEBUG_DEPENDANT_MANAGER) << "Enqueue dependant: " << dependant->toDebugString();
+
+    dependant->mQueued = true;
+    mProcessList.emplace_back(dependant);
+    std::push_heap(mProcessList.begin(), mProcessList.end(), laterInOrder);
 }
 
 void
@@ -57,12 +61,14 @@ DependantManager::processDependencies(bool useDirtyFlag)
 {
     while (!mProcessList.empty()) {
         // Pop the dependency off the front
-        auto dependant = mProcessList.front();
-        LOG_IF(DEBUG_DEPENDANT_MANAGER) << "Processing dependant: " << dependant->toDebugString();
-        mProcessList.erase(mProcessList.begin());
+        std::pop_heap(mProcessList.begin(), mProcessList.end(), laterInOrder);
+        auto dependant = std::move(mProcessList.back());
+        mProcessList.pop_back();
+        dependant->mQueued = false;
 
+        LOG_IF(DEBUG_DEPENDANT_MANAGER) << "Processing dependant: " << dependant->toDebugString();
         dependant->recalculate(useDirtyFlag);
     }
 }
 
-} // namespace apl
\ No newline at end of file
+} // namespace apl
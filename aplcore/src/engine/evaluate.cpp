@@ -52,8 +52,11 @@ parseDataBindingNested(const Context& context, const Object& object, bool optimi
     if (object.isString()) {
         return parseDataBinding(context, object.getString(), optimize);
     }
+    else if (object.isStaticJson()) {   // Nothing to parse; keep the view of the JSON DOM
+        return object;
+    }
     else if (object.isTrueMap()) {
-        auto result = std::make_shared<std::map<std::string, Object>>();
+        auto result = std::make_shared<ObjectMap>();
         for (const auto &m : object.getMap())
             result->emplace(m.first, parseDataBindingNested(context, m.second, optimize));
         return { result };
@@ -76,8 +79,11 @@ applyDataBindingNested(const Context& context, // NOLINT(misc-no-recursion)
     if (object.is<datagrammar::ByteCode>())
         return resourceLookup(context, object.get<datagrammar::ByteCode>()->evaluate(symbols, depth));
 
+    if (object.isStaticJson())
+        return object;
+
     if (object.isTrueMap()) {
-        auto result = std::make_shared<std::map<std::string, Object>>();
+        auto result = std::make_shared<ObjectMap>();
         for (const auto& m : object.getMap())
             result->emplace(m.first, applyDataBindingNested(context, m.second, symbols, depth));
         return { result };
@@ -85,12 +91,13 @@ applyDataBindingNested(const Context& context, // NOLINT(misc-no-recursion)
 
     if (object.isArray()) {  // Embedded data-bound strings are inserted in-line: E.g., [ 1, "${b}" ]
         std::vector<Object> v;
+        v.reserve(object.size());
         for (auto index = 0 ; index < object.size() ; index++) {
             auto item = object.at(index);
             auto itemEvaluated = applyDataBindingNested(context, item, symbols, depth);
             if (item.is<datagrammar::ByteCode>() && itemEvaluated.isArray()) {  // Insert the results into the array
-                for (const auto& n : itemEvaluated.getArray())
-                    v.push_back(n);
+                for (std::uint64_t i = 0 ; i < itemEvaluated.size() ; i++)  // Avoids materializing JSON arrays
+                    v.push_back(itemEvaluated.at(i));
             } else {
                 v.push_back(itemEvaluated);
             }
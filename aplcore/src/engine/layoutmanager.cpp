@@ -18,8 +18,10 @@
 #include "apl/component/corecomponent.h"
 #include "apl/content/configurationchange.h"
 #include "apl/document/coredocumentcontext.h"
+#include "apl/content/rootconfig.h"
 #include "apl/engine/corerootcontext.h"
 #include "apl/livedata/layoutrebuilder.h"
+#include "apl/scenegraph/textlayoutcache.h"
 #include "apl/utils/tracing.h"
 #include "apl/yoga/yoganode.h"
 #include "apl/yoga/yogaproperties.h"
@@ -33,7 +35,11 @@ yogaNodeDirtiedCallback(CoreComponent* component)
 {
     assert(component);
     LOG_IF(DEBUG_LAYOUT_MANAGER).session(*component) << "dirty top node";
-    component->getContext()->layoutManager().requestLayout(component->shared_from_corecomponent(), false);
+
+    // The text measurement pre-pass re-dirties nodes of the top node it is about to lay out
+    auto& layoutManager = component->getContext()->layoutManager();
+    if (!layoutManager.isRecordingTextMeasurements())
+        layoutManager.requestLayout(component->shared_from_corecomponent(), false);
 }
 
 LayoutManager::LayoutManager(const CoreRootContext& coreRootContext, ViewportSize size)
@@ -46,6 +52,8 @@ void
 LayoutManager::terminate()
 {
     mTerminated = true;
+    for (const auto& m : mPendingLayout)
+        m->mCoreFlags.clear(CoreComponent::kCoreComponentFlagLayoutPending);
     mPendingLayout.clear();
 }
 
@@ -76,7 +84,7 @@ LayoutManager::firstLayout()
 
     auto top = CoreComponent::cast(mRoot.topComponent());
     setAsTopNode(top);
-    mPendingLayout.emplace(top);
+    schedule(top);
     layout(false, true);
 }
 
@@ -127,24 +135,35 @@ LayoutManager::layout(bool useDirtyFlag, bool first)
 
     APL_TRACE_BLOCK("LayoutManager:layout");
 
-    std::set<CoreComponentPtr> laidOut;
+    mStats = LayoutStats();
+
+    std::vector<CoreComponentPtr> laidOut;
+    std::vector<CoreComponentPtr> dirty;
+    laidOut.reserve(mPendingLayout.size());
 
     mInLayout = true;
     while (needsLayout()) {
         LOG_IF(DEBUG_LAYOUT_MANAGER) << "Laying out " << mPendingLayout.size() << " component(s)";
 
-        // Copy the pending components into a vector and sort them from top to bottom
-        std::vector<CoreComponentPtr> dirty(mPendingLayout.begin(), mPendingLayout.end());
+        // Take the pending components and sort them from top to bottom
+        dirty.clear();
+        dirty.swap(mPendingLayout);
+        for (const auto& m : dirty)
+            m->mCoreFlags.clear(CoreComponent::kCoreComponentFlagLayoutPending);
         std::sort(dirty.begin(), dirty.end(), compareComponents);
-        mPendingLayout.clear();
 
+        mStats.topNodes += dirty.size();
         for (const auto& m : dirty) {
             layoutComponent(m, useDirtyFlag, first);
-            laidOut.emplace(m);
+            laidOut.emplace_back(m);
         }
     }
     mInLayout = false;
 
+    // A top node may have been laid out more than once (for example, when auto-sizing)
+    std::sort(laidOut.begin(), laidOut.end());
+    laidOut.erase(std::unique(laidOut.begin(), laidOut.end()), laidOut.end());
+
     // Post-process all of the layouts.  This may result in scroll commands or other "jumping around"
     // actions, which can toggle more pending layouts.
     auto postProcess = mPostProcess;
@@ -291,7 +310,15 @@ LayoutManager::layoutComponent(const CoreComponentPtr& component, bool useDirtyF
     // Layout the component if it has a dirty Yoga node OR if the cached size doesn't match the target size
     // The top-level component may get laid out multiple times if it auto sizes.
     if (node.isDirty() || size != component->getLayoutSize()) {
+        mStats.calculated++;
         component->preLayoutProcessing(useDirtyFlag);
+
+        // Holds the pre-measured layouts until the text components have picked them up from the weak cache
+        std::vector<sg::TextLayoutPtr> prepared;
+        if (node.isDirty() &&
+            component->getRootConfig().experimentalFeatureEnabled(RootConfig::kExperimentalFeatureTextMeasurePrePass))
+            prepared = prepareTextMeasurements(component, overallWidth, overallHeight);
+
         APL_TRACE_BEGIN("LayoutManager:YGNodeCalculateLayout");
 
         node.calculateLayout(overallWidth, overallHeight, component->getLayoutDirection());
@@ -362,6 +389,69 @@ LayoutManager::layoutComponent(const CoreComponentPtr& component, bool useDirtyF
 }
 
 
+/**
+ * Run Yoga over the component with text measurement recording turned on.  Text components that miss
+ * the text layout cache record their request and return a placeholder size.  The recorded requests are
+ * laid out as one batch and stored in the cache; the text nodes are then marked dirty so that the real
+ * layout pass discards the placeholder sizes.
+ *
+ * @return The new text layouts.  The caller must hold these until the real layout has run.
+ */
+std::vector<sg::TextLayoutPtr>
+LayoutManager::prepareTextMeasurements(const CoreComponentPtr& component, float width, float height)
+{
+    APL_TRACE_BLOCK("LayoutManager:prepareTextMeasurements");
+
+    std::vector<sg::TextLayoutPtr> result;
+
+    mRecordingTextMeasurements = true;
+    component->getNode().calculateLayout(width, height, component->getLayoutDirection());
+
+    if (!mRecordedMeasurements.empty()) {
+        std::vector<TextMeasureRequest> keys;
+        std::vector<TextLayoutBatchEntry> batch;
+        keys.reserve(mRecordedMeasurements.size());
+        batch.reserve(mRecordedMeasurements.size());
+        for (auto& m : mRecordedMeasurements) {
+            keys.emplace_back(m.first);
+            batch.emplace_back(std::move(m.second));
+        }
+        mRecordedMeasurements.clear();
+
+        LOG_IF(DEBUG_LAYOUT_MANAGER) << "Batch measuring " << batch.size() << " text layout(s)";
+        mStats.batched += batch.size();
+        component->getContext()->measure()->layoutBatch(batch);
+
+        auto& cache = component->getContext()->textLayoutCache();
+        result.reserve(batch.size());
+        for (size_t i = 0; i < batch.size(); i++) {
+            const auto& layout = batch.at(i).layout;
+            if (layout && !cache.find(keys.at(i))) {
+                cache.insert(keys.at(i), layout);
+                result.emplace_back(layout);
+            }
+        }
+    }
+
+    // Discard the placeholder sizes.  This happens while still recording so the top node is not re-queued.
+    for (const auto& m : mRecordedComponents)
+        m->getNode().markDirty();
+    mRecordedComponents.clear();
+    mRecordingTextMeasurements = false;
+
+    return result;
+}
+
+void
+LayoutManager::recordTextMeasurement(CoreComponent& component,
+                                     const TextMeasureRequest& key,
+                                     TextLayoutBatchEntry&& entry)
+{
+    assert(mRecordingTextMeasurements);
+    mRecordedMeasurements.emplace(key, std::move(entry));
+    mRecordedComponents.emplace_back(&component);
+}
+
 void
 LayoutManager::requestLayout(const CoreComponentPtr& component, bool force)
 {
@@ -372,7 +462,7 @@ LayoutManager::requestLayout(const CoreComponentPtr& component, bool force)
         return;
 
     assert(isTopNode(component));
-    mPendingLayout.emplace(component);
+    schedule(component);
     if (force)
         component->setLayoutSize({});
 }
@@ -381,7 +471,21 @@ LayoutManager::requestLayout(const CoreComponentPtr& component, bool force)
 void
 LayoutManager::remove(const CoreComponentPtr& component)
 {
-    mPendingLayout.erase(component);
+    if (!component->mCoreFlags.isSet(CoreComponent::kCoreComponentFlagLayoutPending))
+        return;
+
+    component->mCoreFlags.clear(CoreComponent::kCoreComponentFlagLayoutPending);
+    mPendingLayout.erase(std::find(mPendingLayout.begin(), mPendingLayout.end(), component));
+}
+
+void
+LayoutManager::schedule(const CoreComponentPtr& component)
+{
+    if (component->mCoreFlags.isSet(CoreComponent::kCoreComponentFlagLayoutPending))
+        return;
+
+    component->mCoreFlags.set(CoreComponent::kCoreComponentFlagLayoutPending);
+    mPendingLayout.emplace_back(component);
 }
 
 
@@ -418,7 +522,7 @@ LayoutManager::ensure(const CoreComponentPtr& component)
         if (!child->getNode().hasOwner()) {
             result = true;
             if (child->getNode().hasDirtiedFunc()) {    // This child has a dirtied_ method; it should not be attached
-                mPendingLayout.emplace(child);       // Schedule this child for layout.  It will only run if it is needed
+                schedule(child);                     // Schedule this child for layout.  It will only run if it is needed
                 if (attachedYogaNodeNeedsLayout) {   // If a child node was attached, force the layout
                     child->setLayoutSize({});
                     attachedYogaNodeNeedsLayout = false;
@@ -435,7 +539,7 @@ LayoutManager::ensure(const CoreComponentPtr& component)
 
     // If there is a dangling node that was attached, force a layout pass on the top node.
     if (attachedYogaNodeNeedsLayout) {
-        mPendingLayout.emplace(child);
+        schedule(child);
         child->setLayoutSize({});
     }
 
@@ -36,6 +36,13 @@ namespace apl {
 
 static const bool DEBUG_YG_PRINT_TREE = false;
 
+static size_t
+textLayoutCacheBudget(const RootConfig& config)
+{
+    auto budget = config.getProperty(RootProperty::kTextLayoutCacheBudget).getInteger();
+    return budget > 0 ? static_cast<size_t>(budget) : 0;
+}
+
 SharedContextData::SharedContextData(const CoreRootContextPtr& root,
                                      const Metrics& metrics,
                                      const RootConfig& config)
@@ -57,8 +64,9 @@ SharedContextData::SharedContextData(const CoreRootContextPtr& root,
       mMediaManager(config.getMediaManager()),
       mMediaPlayerFactory(config.getMediaPlayerFactory()),
       mYogaConfig(metrics, DEBUG_YG_PRINT_TREE),
+      mSymbolTable(std::make_shared<SymbolTable>()),
       mTextMeasurement(config.getMeasure()),
-      mTextLayoutCache(new sg::TextLayoutCache()),
+      mTextLayoutCache(new sg::TextLayoutCache(textLayoutCacheBudget(config))),
       mTextPropertiesCache(new sg::TextPropertiesCache())
 {
 }
@@ -68,8 +76,9 @@ SharedContextData::SharedContextData(const RootConfig& config)
       mUniqueIdGenerator(std::make_unique<UIDGenerator>()),
       mDependantManager(std::make_unique<DependantManager>()),
       mYogaConfig(),
+      mSymbolTable(std::make_shared<SymbolTable>()),
       mTextMeasurement(config.getMeasure()),
-      mTextLayoutCache(new sg::TextLayoutCache()),
+      mTextLayoutCache(new sg::TextLayoutCache(textLayoutCacheBudget(config))),
       mTextPropertiesCache(new sg::TextPropertiesCache())
 {}
 
@@ -100,7 +100,7 @@ VisibilityManager::processVisibilityChanges()
 
         it->second = VisibilityState{visibleRegionPercentage, cumulativeOpacity};
 
-        auto visibilityOpt = std::make_shared<std::map<std::string, Object>>();
+        auto visibilityOpt = std::make_shared<ObjectMap>();
         visibilityOpt->emplace("visibleRegionPercentage", visibleRegionPercentage);
         visibilityOpt->emplace("cumulativeOpacity", cumulativeOpacity);
 
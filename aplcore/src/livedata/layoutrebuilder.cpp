@@ -19,6 +19,7 @@
 #include "apl/content/content.h"
 #include "apl/document/coredocumentcontext.h"
 #include "apl/engine/builder.h"
+#include "apl/engine/evaluate.h"
 #include "apl/livedata/livearraychange.h"
 #include "apl/livedata/livearrayobject.h"
 #include "apl/utils/constants.h"
@@ -27,6 +28,9 @@ namespace apl {
 
 const std::string COMPONENT_REBUILDER_TOKEN = "_token";
 
+// The most children held for reuse for each "item" of a recycling layout
+static const size_t RECYCLE_POOL_LIMIT = 32;
+
 static const bool DEBUG_WALKER = false;
 
 /**
@@ -39,8 +43,8 @@ public:
      * @param layout The layout
      * @param hasFirstItem True if a "firstItem" property was specified that needs to be skipped.
      */
-    ChildWalker(const CoreComponentPtr& layout, bool hasFirstItem)
-        : mLayout(layout), mIndex(hasFirstItem ? 1 : 0)
+    ChildWalker(LayoutRebuilder& rebuilder, const CoreComponentPtr& layout, bool hasFirstItem)
+        : mRebuilder(rebuilder), mLayout(layout), mIndex(hasFirstItem ? 1 : 0)
     {
         LOG_IF(DEBUG_WALKER).session(layout) << "mIndex=" << mIndex << " total=" << mLayout->getChildCount();
     }
@@ -56,7 +60,7 @@ public:
             lastIndex -= 1;
 
         for (int i = mIndex ; i < lastIndex ; i++)
-            mLayout->removeChildAt(mIndex, true);
+            mRebuilder.removeChild(mLayout, mIndex);
     }
 
     /**
@@ -79,7 +83,7 @@ public:
                 LOG_IF(DEBUG_WALKER).session(mLayout) << " found data index of " << index << " but it didn't match";
             }
             LOG_IF(DEBUG_WALKER).session(mLayout) << " removing child at index " << mIndex;
-            mLayout->removeChildAt(mIndex, true);
+            mRebuilder.removeChild(mLayout, mIndex);
         }
 
         LOG(LogLevel::kError).session(mLayout) << "Failed to find child with dataIndex of " << oldIndex;
@@ -96,6 +100,7 @@ public:
     }
 
 private:
+    LayoutRebuilder& mRebuilder;
     CoreComponentPtr mLayout;
     int mIndex;
 };
@@ -244,7 +249,7 @@ LayoutRebuilder::rebuild()
     // If array is replaced - just clean out everything except first and last item before rebuilding
     // to preserve order of operations (maintaining scroll positions/pager pages/etc).
     if (array->isReplaced()) {
-        auto walker = ChildWalker(layout, mHasFirstItem);
+        auto walker = ChildWalker(*this, layout, mHasFirstItem);
         walker.finish(mHasLastItem);
     }
 
@@ -252,12 +257,16 @@ LayoutRebuilder::rebuild()
     // wrong location.  We'll walk through the new list and the old list, deleting and inserting
     // items as appropriate.
 
-    auto walker = ChildWalker(layout, mHasFirstItem);
+    auto walker = ChildWalker(*this, layout, mHasFirstItem);
 
     auto old = mOld.lock();  // Can be nullptr, so not checking
     int ordinal = 1;
     int index = 0;
 
+    auto reactiveHandling = CoreDocumentContext::cast(mContext->documentContext())
+                                ->content()
+                                ->reactiveConditionalInflation();
+
     // Walk the list of new items
     for (int newIndex = 0 ; newIndex < array->size() ; newIndex++) {
         const auto& data = array->at(newIndex);
@@ -265,25 +274,24 @@ LayoutRebuilder::rebuild()
         auto oldIndex = p.first;
         auto needsRefresh = p.second;
 
-        auto reactiveHandling = CoreDocumentContext::cast(mContext->documentContext())
-                                    ->content()
-                                    ->reactiveConditionalInflation();
-
         if (oldIndex == -1 || (reactiveHandling && !walker.advanceUntil(oldIndex))) {  // Insert a new child - this one doesn't exist
             auto childContext = buildBaseChildContext(array, newIndex, index);
 
             if (mNumbered)
                 childContext->putConstant(COMPONENT_ORDINAL, ordinal);
 
-            auto child = Builder(old).expandSingleComponentFromArray(
-                childContext,
-                mItems,
-                Properties(),
-                layout,
-                mChildPath,
-                layout->shouldBeFullyInflated(index),
-                true);
-            Builder::registerRebuildDependencyIfRequired(layout, childContext, mItems, child != nullptr, {COMPONENT_DATA});
+            auto child = reuseChild(array, childContext, newIndex, index, ordinal);
+            if (!child) {
+                child = Builder(old).expandSingleComponentFromArray(
+                    childContext,
+                    mItems,
+                    Properties(),
+                    layout,
+                    mChildPath,
+                    layout->shouldBeFullyInflated(index),
+                    true);
+                Builder::registerRebuildDependencyIfRequired(layout, childContext, mItems, child != nullptr, {COMPONENT_DATA});
+            }
             if (child && child->isValid()) {
                 layout->insertChild(child, index + (mHasFirstItem ? 1 : 0), true);
                 index++;
@@ -351,6 +359,88 @@ LayoutRebuilder::rebuild()
     layout->getLayoutRoot()->processLayoutChanges(true, false);
 }
 
+/**
+ * Remove a child from the layout.  If the layout recycles its items the child is detached and held
+ * for reuse, otherwise it is released.
+ */
+void
+LayoutRebuilder::removeChild(const CoreComponentPtr& layout, size_t index)
+{
+    auto child = layout->getCoreChildAt(index);
+    if (layout->getCalculated(kPropertyRecycleItems).truthy()) {
+        auto childContext = findToken(child, mRebuilderToken);
+        auto itemIndex = childContext ? childContext->opt(REBUILD_ITEM_INDEX) : Object::NULL_OBJECT();
+        if (itemIndex.isNumber()) {
+            auto& pool = mRecyclePool[itemIndex.getInteger()];
+            if (pool.size() < RECYCLE_POOL_LIMIT) {
+                layout->removeChild(child, true);
+                child->mParent = nullptr;
+                pool.emplace_back(child);
+                return;
+            }
+        }
+    }
+
+    layout->removeChildAt(index, true);
+}
+
+/**
+ * Find a recycled child built from the same "item" that would be selected for new data and rebind
+ * it to that data.  The data-binding context of the child is updated in place, so only the
+ * dependants of the changed values are recalculated.
+ * @return The recycled child or nullptr if there isn't one.
+ */
+CoreComponentPtr
+LayoutRebuilder::reuseChild(const LiveArrayObjectPtr& array, const ContextPtr& childContext,
+                            size_t dataIndex, size_t insertIndex, int ordinal)
+{
+    if (mRecyclePool.empty())
+        return nullptr;
+
+    for (int itemIndex = 0; itemIndex < mItems.size(); itemIndex++) {
+        const auto& item = mItems.at(itemIndex);
+        if (!item.isMap() || !propertyAsBoolean(*childContext, item, "when", true))
+            continue;
+
+        auto it = mRecyclePool.find(itemIndex);
+        if (it == mRecyclePool.end() || it->second.empty())
+            return nullptr;
+
+        auto child = it->second.back();
+        it->second.pop_back();
+
+        auto context = findToken(child, mRebuilderToken);
+        context->systemUpdateAndRecalculate(COMPONENT_INDEX, insertIndex, true);
+        context->systemUpdateAndRecalculate(COMPONENT_DATA, array->at(dataIndex), true);
+        context->systemUpdateAndRecalculate(COMPONENT_LENGTH, array->size(), true);
+        context->systemUpdateAndRecalculate(COMPONENT_DATA_INDEX, dataIndex, true);
+        if (mNumbered)
+            context->systemUpdateAndRecalculate(COMPONENT_ORDINAL, ordinal, true);
+        return child;
+    }
+
+    return nullptr;
+}
+
+void
+LayoutRebuilder::clearRecyclePool()
+{
+    for (const auto& m : mRecyclePool)
+        for (const auto& child : m.second)
+            child->release();
+
+    mRecyclePool.clear();
+}
+
+size_t
+LayoutRebuilder::recyclePoolSize() const
+{
+    size_t result = 0;
+    for (const auto& m : mRecyclePool)
+        result += m.second.size();
+    return result;
+}
+
 void
 LayoutRebuilder::notifyItemOnScreen(int idx)
 {
@@ -396,6 +486,31 @@ LayoutRebuilder::inflateIfRequired(const CoreComponentPtr& child)
         Builder(mOld.lock()).populateLayoutComponent(ctx, item, child, child->getPathObject(), true, true);
     }
     ctx->remove("_item");
+
+    auto layout = mLayout.lock();
+    if (layout && layout->virtualizesChildren() && (child->singleChild() || child->multiChild()))
+        ctx->putConstant(REBUILD_VIRTUAL_ITEM, item);
+}
+
+bool
+LayoutRebuilder::deflate(const CoreComponentPtr& child, bool useDirtyFlag)
+{
+    auto ctx = child->getContext();
+    auto item = ctx->opt(REBUILD_VIRTUAL_ITEM);
+    if (item.isNull() || child->getChildCount() == 0 || child->mRebuilder)
+        return false;
+
+    // Hold the current size so that the siblings don't move while this child is a placeholder
+    const auto& bounds = child->getCalculated(kPropertyBounds).get<Rect>();
+    child->getNode().setWidth(bounds.getWidth());
+    child->getNode().setHeight(bounds.getHeight());
+
+    while (child->getChildCount() > 0)
+        child->removeChildAt(child->getChildCount() - 1, useDirtyFlag);
+
+    ctx->remove(REBUILD_VIRTUAL_ITEM);
+    ctx->putConstant("_item", item);
+    return true;
 }
 
 } // namespace apl
@@ -0,0 +1,137 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "apl/livedata/livearraymapping.h"
+
+namespace apl {
+
+void
+LiveArrayMapping::build(const std::vector<LiveArrayChange>& changes, size_type newSize)
+{
+    mRuns.clear();
+
+    // Walk backwards from the current size to find the size the array had before the changes
+    mOldSize = newSize;
+    for (auto it = changes.rbegin(); it != changes.rend(); it++) {
+        if (it->command() == LiveArrayChange::INSERT)
+            mOldSize = mOldSize > it->count() ? mOldSize - it->count() : 0;
+        else if (it->command() == LiveArrayChange::REMOVE)
+            mOldSize += it->count();
+    }
+
+    if (mOldSize > 0)
+        mRuns.push_back({0, mOldSize, 0, false});
+
+    // Replay the changes forwards.  Run lengths are maintained here; starting offsets are
+    // assigned once at the end.
+    for (const auto& change : changes) {
+        auto position = change.position();
+        auto count = change.count();
+        switch (change.command()) {
+            case LiveArrayChange::INSERT:
+                mRuns.insert(mRuns.begin() + splitAt(position), Run{0, count, -1, false});
+                break;
+            case LiveArrayChange::REMOVE: {
+                auto first = splitAt(position);
+                auto last = splitAt(position + count);
+                mRuns.erase(mRuns.begin() + first, mRuns.begin() + last);
+                break;
+            }
+            case LiveArrayChange::UPDATE: {
+                auto first = splitAt(position);
+                auto last = splitAt(position + count);
+                for (auto i = first; i < last; i++)
+                    mRuns[i].updated = true;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    // Drop empty runs, merge neighbours that continue each other and assign starting offsets
+    size_t out = 0;
+    size_type offset = 0;
+    for (const auto& run : mRuns) {
+        if (run.length == 0)
+            continue;
+
+        if (out > 0) {
+            auto& last = mRuns[out - 1];
+            auto merge = run.oldStart == -1
+                             ? last.oldStart == -1
+                             : last.oldStart != -1 && last.updated == run.updated &&
+                                   last.oldStart + static_cast<int>(last.length) == run.oldStart;
+            if (merge) {
+                last.length += run.length;
+                offset += run.length;
+                continue;
+            }
+        }
+
+        mRuns[out] = run;
+        mRuns[out].newStart = offset;
+        offset += run.length;
+        out++;
+    }
+    mRuns.resize(out);
+}
+
+/**
+ * Split the run containing a position so that a run starts exactly at that position.
+ * @return The index of the run starting at the position, or the number of runs if the position
+ *         is at or past the end of the array.
+ */
+size_t
+LiveArrayMapping::splitAt(size_type position)
+{
+    size_type offset = 0;
+    for (size_t i = 0; i < mRuns.size(); i++) {
+        if (offset == position)
+            return i;
+
+        auto& run = mRuns[i];
+        if (position < offset + run.length) {
+            auto head = position - offset;
+            Run tail{0, run.length - head, run.oldStart == -1 ? -1 : run.oldStart + static_cast<int>(head),
+                     run.updated};
+            run.length = head;
+            mRuns.insert(mRuns.begin() + i + 1, tail);
+            return i + 1;
+        }
+        offset += run.length;
+    }
+
+    return mRuns.size();
+}
+
+std::pair<int, bool>
+LiveArrayMapping::newToOld(size_type index) const
+{
+    auto it = std::upper_bound(mRuns.begin(), mRuns.end(), index,
+                               [](size_type value, const Run& run) { return value < run.newStart; });
+    if (it == mRuns.begin())
+        return {-1, false};
+
+    const auto& run = *(it - 1);
+    if (index >= run.newStart + run.length || run.oldStart == -1)
+        return {-1, false};
+
+    return {run.oldStart + static_cast<int>(index - run.newStart), run.updated};
+}
+
+} // namespace apl
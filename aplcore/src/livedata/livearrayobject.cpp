@@ -84,6 +84,7 @@ LiveArrayObject::handleArrayMessage(const LiveArrayChange& change)
         mChanges.push_back(change);
     }
 
+    mMappingValid = false;
     markDirty();
 }
 
@@ -91,6 +92,7 @@ void
 LiveArrayObject::flush() {
     LiveDataObject::flush();
     mChanges.clear();
+    mMappingValid = false;
 }
 
 /**
@@ -105,33 +107,12 @@ LiveArrayObject::newToOld(ObjectArray::size_type index)
     if (mReplaced)
         return {-1, false};
 
-    bool changed = false;
-
-    for (auto it = mChanges.rbegin() ; it != mChanges.rend() ; it++) {
-        auto cmd = it->command();
-        auto position = it->position();
-        auto count = it->count();
-        switch (cmd) {
-            case LiveArrayChange::REMOVE:
-                if (index >= position)
-                    index += count;
-                break;
-            case LiveArrayChange::UPDATE:
-                if (index >= position && index < position + count)
-                    changed = true;
-                break;
-            case LiveArrayChange::INSERT:
-                if (index >= position + count)
-                    index -= count;
-                else if (index >= position)
-                    return {-1, false};
-                break;
-            default:
-                break;
-        }
+    if (!mMappingValid) {
+        mMapping.build(mChanges, size());
+        mMappingValid = true;
     }
 
-    return { index, changed };
+    return mMapping.newToOld(index);
 }
 
 std::shared_ptr<LiveDataObject>
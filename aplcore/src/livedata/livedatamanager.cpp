@@ -15,19 +15,64 @@
 
 #include "apl/livedata/livedatamanager.h"
 #include "apl/livedata/livedataobject.h"
+#include "apl/time/framebudget.h"
 
 namespace apl {
 
 void
 LiveDataManager::flushDirty()
 {
+    // Queue the dependants of every changed object before recalculating any of them so that a
+    // dependant bound to several changed objects is only recalculated once.
     for (const auto& m : mDirty)
         m->preFlush();
 
-    for (const auto& m : mDirty)
+    for (const auto& m : mDirty) {
         m->flush();
+        mDeferred.erase(m);
+    }
 
     mDirty.clear();
 }
 
+size_t
+LiveDataManager::flushDirty(FrameBudget& budget)
+{
+    // Deferred trackers were changed earlier, so they sort ahead of anything newly dirty
+    std::vector<std::shared_ptr<LiveDataObject>> work(mDeferred.begin(), mDeferred.end());
+    for (const auto& m : mDirty)
+        if (!mDeferred.count(m))
+            work.emplace_back(m);
+
+    mDirty.clear();
+    mDeferred.clear();
+
+    // Each tracker is flushed as a whole (dependants and any rebuild included) so that the
+    // components bound to it are never left half updated.
+    size_t flushed = 0;
+    for (const auto& m : work) {
+        if (!mTrackers.count(m))  // Removed by an earlier flush in this loop
+            continue;
+
+        if (budget.expired()) {
+            mDeferred.emplace(m);
+            continue;
+        }
+
+        m->preFlush();
+        m->flush();
+        budget.recordUnit();
+        flushed++;
+    }
+
+    return flushed;
+}
+
+void
+LiveDataManager::resumeDeferred()
+{
+    mDirty.insert(mDeferred.begin(), mDeferred.end());
+    mDeferred.clear();
+}
+
 } // namespace apl
\ No newline at end of file
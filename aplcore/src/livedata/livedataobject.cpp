@@ -55,14 +55,23 @@ LiveDataObject::markDirty()
 }
 
 void
-LiveDataObject::flush()
+LiveDataObject::preFlush()
 {
-    auto context = mContext.lock();
+    mMaxWatcherTokenBeforeFlush = mWatcherToken;
     mIsFlushing = true;
-    if (context) {
+
+    auto context = mContext.lock();
+    if (context)
         context->enqueueDownstream(mKey);
+}
+
+void
+LiveDataObject::flush()
+{
+    // Dependants were queued in preFlush().  Only the first flush in a cycle does any work here.
+    auto context = mContext.lock();
+    if (context)
         context->dependantManager().processDependencies(true);
-    }
 
     // Make a copy to ensure sane iteration because it's possible that calling a callback will add more callbacks
     std::map<int, FlushCallback> flushCallbacksCopy{mFlushCallbacks};
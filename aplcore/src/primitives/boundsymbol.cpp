@@ -18,18 +18,25 @@
 
 namespace apl {
 
+BoundSymbol::BoundSymbol(const ContextPtr& context, std::string name)
+    : mContext(context),
+      mName(std::move(name)),
+      mAtom(context ? context->symbols().intern(mName) : SymbolTable::NO_ATOM)
+{
+}
+
 bool
 BoundSymbol::empty() const
 {
     auto context = mContext.lock();
-    return context ? context->opt(mName).empty() : true;
+    return context ? context->opt(mAtom).empty() : true;
 }
 
 bool
 BoundSymbol::truthy() const
 {
     auto context = mContext.lock();
-    return context ? context->opt(mName).truthy() : false;
+    return context ? context->opt(mAtom).truthy() : false;
 }
 
 rapidjson::Value
@@ -43,7 +50,7 @@ Object
 BoundSymbol::eval() const
 {
     auto context = mContext.lock();
-    return context ? context->opt(mName) : Object::NULL_OBJECT();
+    return context ? context->opt(mAtom) : Object::NULL_OBJECT();
 }
 
 std::string
@@ -15,6 +15,7 @@
 
 #include "apl/primitives/object.h"
 
+#include <cstring>
 #include <stack>
 
 #include "apl/content/sharedjsondata.h"
@@ -78,6 +79,9 @@ Object::Object(const Object& object) noexcept
         case StorageType::kStorageTypeValue:
             mU.value = object.mU.value;
             break;
+        case StorageType::kStorageTypeInline:
+            std::memcpy(mU.inlined, object.mU.inlined, sizeof(mU.inlined));
+            break;
         case StorageType::kStorageTypeString:
             new(&mU.string) std::string(object.mU.string);
             break;
@@ -96,6 +100,9 @@ Object::Object(Object&& object) noexcept
         case StorageType::kStorageTypeValue:
             mU.value = object.mU.value;
             break;
+        case StorageType::kStorageTypeInline:
+            std::memcpy(mU.inlined, object.mU.inlined, sizeof(mU.inlined));
+            break;
         case StorageType::kStorageTypeString:
             new(&mU.string) std::string(std::move(object.mU.string));
             break;
@@ -117,6 +124,9 @@ Object& Object::operator=(const Object& rhs) noexcept
             case StorageType::kStorageTypeValue:
                 mU.value = rhs.mU.value;
                 break;
+            case StorageType::kStorageTypeInline:
+                std::memcpy(mU.inlined, rhs.mU.inlined, sizeof(mU.inlined));
+                break;
             case StorageType::kStorageTypeString:
                 mU.string = rhs.mU.string;
                 break;
@@ -129,7 +139,8 @@ Object& Object::operator=(const Object& rhs) noexcept
         // Delete the old item
         switch(mType->storageType()) {
             case StorageType::kStorageTypeEmpty: // FALL_THROUGH
-            case StorageType::kStorageTypeValue:
+            case StorageType::kStorageTypeValue: // FALL_THROUGH
+            case StorageType::kStorageTypeInline:
                 break;
             case StorageType::kStorageTypeString:
                 mU.string.~basic_string<char>();
@@ -147,6 +158,9 @@ Object& Object::operator=(const Object& rhs) noexcept
             case StorageType::kStorageTypeValue:
                 mU.value = rhs.mU.value;
                 break;
+            case StorageType::kStorageTypeInline:
+                std::memcpy(mU.inlined, rhs.mU.inlined, sizeof(mU.inlined));
+                break;
             case StorageType::kStorageTypeString:
                 new(&mU.string) std::string(rhs.mU.string);
                 break;
@@ -168,6 +182,9 @@ Object& Object::operator=(Object&& rhs) noexcept
             case StorageType::kStorageTypeValue:
                 mU.value = rhs.mU.value;
                 break;
+            case StorageType::kStorageTypeInline:
+                std::memcpy(mU.inlined, rhs.mU.inlined, sizeof(mU.inlined));
+                break;
             case StorageType::kStorageTypeString:
                 mU.string = std::move(rhs.mU.string);
                 break;
@@ -180,7 +197,8 @@ Object& Object::operator=(Object&& rhs) noexcept
         // Delete the old item
         switch(mType->storageType()) {
             case StorageType::kStorageTypeEmpty: // FALL_THROUGH
-            case StorageType::kStorageTypeValue:
+            case StorageType::kStorageTypeValue: // FALL_THROUGH
+            case StorageType::kStorageTypeInline:
                 break;
             case StorageType::kStorageTypeString:
                 mU.string.~basic_string<char>();
@@ -198,6 +216,9 @@ Object& Object::operator=(Object&& rhs) noexcept
             case StorageType::kStorageTypeValue:
                 mU.value = rhs.mU.value;
                 break;
+            case StorageType::kStorageTypeInline:
+                std::memcpy(mU.inlined, rhs.mU.inlined, sizeof(mU.inlined));
+                break;
             case StorageType::kStorageTypeString:
                 new(&mU.string) std::string(std::move(rhs.mU.string));
                 break;
@@ -217,7 +238,8 @@ Object::~Object()
     LOG_IF(OBJECT_DEBUG) << "  --- Destroying " << *this;
     switch(mType->storageType()) {
         case StorageType::kStorageTypeEmpty: // FALL_THROUGH
-        case StorageType::kStorageTypeValue:
+        case StorageType::kStorageTypeValue: // FALL_THROUGH
+        case StorageType::kStorageTypeInline:
             break;
         case StorageType::kStorageTypeString:
             mU.string.~basic_string<char>();
@@ -504,6 +526,8 @@ bool Object::empty() const { return mType->empty(mU); }
 
 bool Object::isMutable() const { return mType->isMutable(mU); }
 
+bool Object::isStaticJson() const { return mType->isStaticJson(mU); }
+
 Object Object::eval() const { return mType->isEvaluable() ? mType->eval(mU) : *this; }
 
 /**
@@ -28,16 +28,36 @@
 namespace apl {
 namespace sg {
 
+static thread_local const ObjectPoolPtr *sBuilderPool = nullptr;
+
+static const ObjectPoolPtr&
+builderPool()
+{
+    static const ObjectPoolPtr NO_POOL;
+    return sBuilderPool ? *sBuilderPool : NO_POOL;
+}
+
+BuilderPoolScope::BuilderPoolScope(const ObjectPoolPtr& pool)
+    : mPrevious(sBuilderPool)
+{
+    sBuilderPool = &pool;
+}
+
+BuilderPoolScope::~BuilderPoolScope()
+{
+    sBuilderPool = mPrevious;
+}
+
 LayerPtr
 layer(const std::string& name, Rect bounds, float opacity, Transform2D transform)
 {
-    return std::make_shared<Layer>(name, bounds, opacity, std::move(transform));
+    return makePooled<Layer>(builderPool(), name, bounds, opacity, std::move(transform));
 }
 
 NodePtr
 transform(Transform2D transform, const NodePtr& child)
 {
-    auto node = std::make_shared<TransformNode>();
+    auto node = makePooled<TransformNode>(builderPool());
     node->setTransform(transform);
     node->setChild(child);
     return node;
@@ -58,13 +78,13 @@ transform(const Object& object, const NodePtr& child)
 NodePtr
 transform()
 {
-    return std::make_shared<TransformNode>();
+    return makePooled<TransformNode>(builderPool());
 }
 
 NodePtr
 clip(PathPtr path, const NodePtr& child)
 {
-    auto node = std::make_shared<ClipNode>();
+    auto node = makePooled<ClipNode>(builderPool());
     node->setPath(std::move(path));
     node->setChild(child);
     return node;
@@ -74,7 +94,7 @@ clip(PathPtr path, const NodePtr& child)
 NodePtr
 opacity(float opacity, const NodePtr& child)
 {
-    auto node = std::make_shared<OpacityNode>();
+    auto node = makePooled<OpacityNode>(builderPool());
     node->setOpacity(opacity);
     node->setChild(child);
     return node;
@@ -90,7 +110,7 @@ NodePtr
 image(FilterPtr image, Rect target, Rect source)
 {
     // Note that the image may be null
-    auto node = std::make_shared<ImageNode>();
+    auto node = makePooled<ImageNode>(builderPool());
     node->setImage(std::move(image));
     node->setTarget(std::move(target));
     node->setSource(std::move(source));
@@ -101,7 +121,7 @@ NodePtr
 video(MediaPlayerPtr player, Rect target, VideoScale scale)
 {
     assert(player);
-    auto node = std::make_shared<VideoNode>();
+    auto node = makePooled<VideoNode>(builderPool());
     node->setMediaPlayer(std::move(player));
     node->setTarget(std::move(target));
     node->setScale(scale);
@@ -112,7 +132,7 @@ NodePtr
 shadowNode(ShadowPtr shadow, const NodePtr& child)
 {
     // No assert. nullptr shadow is a valid case.
-    auto node = std::make_shared<ShadowNode>();
+    auto node = makePooled<ShadowNode>(builderPool());
     if (shadow) node->setShadow(std::move(shadow));
     node->setChild(child);
     return node;
@@ -123,7 +143,7 @@ draw(PathPtr path, PathOpPtr op)
 {
     assert(path);
     assert(op);
-    auto node = std::make_shared<DrawNode>();
+    auto node = makePooled<DrawNode>(builderPool());
     node->setPath(std::move(path));
     node->setOp(std::move(op));
     return node;
@@ -134,7 +154,7 @@ text(TextLayoutPtr textLayout, PathOpPtr op)
 {
     assert(textLayout);
     assert(op);
-    auto node = std::make_shared<TextNode>();
+    auto node = makePooled<TextNode>(builderPool());
     node->setTextLayout(std::move(textLayout));
     node->setOp(std::move(op));
     return node;
@@ -145,7 +165,7 @@ text(TextLayoutPtr textLayout, PathOpPtr op, Range range)
 {
     assert(textLayout);
     assert(op);
-    auto node = std::make_shared<TextNode>();
+    auto node = makePooled<TextNode>(builderPool());
     node->setTextLayout(std::move(textLayout));
     node->setOp(std::move(op));
     node->setRange(range);
@@ -157,7 +177,7 @@ editText(EditTextPtr editText, EditTextBoxPtr editTextBox,
          EditTextConfigPtr editTextConfig, const std::string& text)
 {
     assert(editText);
-    auto node = std::make_shared<EditTextNode>();
+    auto node = makePooled<EditTextNode>(builderPool());
     node->setEditText(std::move(editText));
     node->setEditTextBox(std::move(editTextBox));
     node->setEditTextConfig(std::move(editTextConfig));
@@ -168,7 +188,7 @@ editText(EditTextPtr editText, EditTextBoxPtr editTextBox,
 PathPtr
 path(apl::Rect rect)
 {
-    auto path = std::make_shared<RectPath>();
+    auto path = makePooled<RectPath>(builderPool());
     path->setRect(rect);
     return path;
 }
@@ -176,7 +196,7 @@ path(apl::Rect rect)
 PathPtr
 path(apl::Rect rect, float radius)
 {
-    auto path = std::make_shared<RoundedRectPath>();
+    auto path = makePooled<RoundedRectPath>(builderPool());
     path->setRoundedRect(RoundedRect{rect, radius});
     return path;
 }
@@ -185,7 +205,7 @@ path(apl::Rect rect, float radius)
 PathPtr
 path(Rect rect, Radii radii)
 {
-    auto path = std::make_shared<RoundedRectPath>();
+    auto path = makePooled<RoundedRectPath>(builderPool());
     path->setRoundedRect(RoundedRect{rect, radii});
     return path;
 }
@@ -193,7 +213,7 @@ path(Rect rect, Radii radii)
 PathPtr
 path(RoundedRect roundedRect)
 {
-    auto path = std::make_shared<RoundedRectPath>();
+    auto path = makePooled<RoundedRectPath>(builderPool());
     path->setRoundedRect(roundedRect);
     return path;
 }
@@ -201,7 +221,7 @@ path(RoundedRect roundedRect)
 PathPtr
 path(RoundedRect roundedRect, float inset)
 {
-    auto path = std::make_shared<FramePath>();
+    auto path = makePooled<FramePath>(builderPool());
     path->setRoundedRect(std::move(roundedRect));
     path->setInset(inset);
     return path;
@@ -216,7 +236,7 @@ path(const std::string& path)
 PaintPtr
 paint(Color color, float opacity)
 {
-    auto paint = std::make_shared<ColorPaint>();
+    auto paint = makePooled<ColorPaint>(builderPool());
     paint->setColor(color);
     paint->setOpacity(opacity);
     return paint;
@@ -231,7 +251,7 @@ paint(const Gradient& gradient, float opacity, Transform2D transform)
 
     switch (gradient.getType()) {
         case Gradient::LINEAR: {
-            auto paint = std::make_shared<LinearGradientPaint>();
+            auto paint = makePooled<LinearGradientPaint>(builderPool());
             paint->setOpacity(opacity);
             paint->setTransform(std::move(transform));
             paint->setPoints(gradient.getInputRange());
@@ -250,7 +270,7 @@ paint(const Gradient& gradient, float opacity, Transform2D transform)
         }
 
         case Gradient::RADIAL: {
-            auto paint = std::make_shared<RadialGradientPaint>();
+            auto paint = makePooled<RadialGradientPaint>(builderPool());
             paint->setOpacity(opacity);
             paint->setTransform(transform);
             paint->setPoints(gradient.getInputRange());
@@ -266,7 +286,7 @@ paint(const Gradient& gradient, float opacity, Transform2D transform)
         }
     }
 
-    return std::make_shared<ColorPaint>();
+    return makePooled<ColorPaint>(builderPool());
 }
 
 PaintPtr
@@ -274,7 +294,7 @@ paint(const GraphicPatternPtr& pattern, float opacity, Transform2D transform)
 {
     assert(pattern);
 
-    auto paint = std::make_shared<PatternPaint>();
+    auto paint = makePooled<PatternPaint>(builderPool());
     paint->setOpacity(opacity);
     paint->setTransform(transform);
     paint->setSize(Size{
@@ -307,13 +327,13 @@ paint(const Object& object, float opacity, Transform2D transform)
     if (object.is<GraphicPattern>())
         return paint(object.get<GraphicPattern>(), opacity, transform);
 
-    return std::make_shared<ColorPaint>();
+    return makePooled<ColorPaint>(builderPool());
 }
 
 PathOpPtr
 fill(PaintPtr paint, FillType fillType)
 {
-    auto op = std::make_shared<FillPathOp>();
+    auto op = makePooled<FillPathOp>(builderPool());
     op->paint = std::move(paint);
     op->fillType = fillType;
     return op;
@@ -328,7 +348,7 @@ shadow(Color color, Point offset, float radius)
     if (color == Color::TRANSPARENT || (offset.empty() && radius <= 0.0))
         return nullptr;
 
-    auto shadow = std::make_shared<Shadow>();
+    auto shadow = makePooled<Shadow>(builderPool());
     shadow->setColor(color);
     shadow->setOffset(offset);
     shadow->setRadius(radius);
@@ -350,7 +370,7 @@ accessibility(CoreComponent& component)
         return nullptr;
 
     auto weak = std::weak_ptr<CoreComponent>(component.shared_from_corecomponent());
-    auto acc = std::make_shared<Accessibility>([weak](const std::string& name) {
+    auto acc = makePooled<Accessibility>(builderPool(), [weak](const std::string& name) {
         auto strong = weak.lock();
         if (strong)
             strong->update(kUpdateAccessibilityAction, name);
@@ -375,7 +395,7 @@ accessibility(CoreComponent& component)
 FilterPtr
 filter(MediaObjectPtr mediaObject)
 {
-    auto result = std::make_shared<MediaObjectFilter>();
+    auto result = makePooled<MediaObjectFilter>(builderPool());
     result->mediaObject = std::move(mediaObject);
     return result;
 }
@@ -390,7 +410,7 @@ blend(FilterPtr back, FilterPtr front, BlendMode blendMode)
     if (!back || !back->visible())
         return front;
 
-    auto result = std::make_shared<BlendFilter>();
+    auto result = makePooled<BlendFilter>(builderPool());
     result->back = std::move(back);
     result->front = std::move(front);
     result->blendMode = blendMode;
@@ -403,7 +423,7 @@ blur(FilterPtr filter, float radius)
     if (radius <= 0 || !filter)
         return filter;
 
-    auto result = std::make_shared<BlurFilter>();
+    auto result = makePooled<BlurFilter>(builderPool());
     result->filter = std::move(filter);
     result->radius = radius;
     return result;
@@ -418,7 +438,7 @@ grayscale(FilterPtr filter, float amount)
     if (amount > 1.0)
         amount = 1.0;
 
-    auto result = std::make_shared<GrayscaleFilter>();
+    auto result = makePooled<GrayscaleFilter>(builderPool());
     result->filter = std::move(filter);
     result->amount = amount;
     return result;
@@ -430,7 +450,7 @@ noise(FilterPtr filter, NoiseFilterKind kind, bool useColor, float sigma )
     if (sigma <= 0.0 || !filter)
         return filter;
 
-    auto result = std::make_shared<NoiseFilter>();
+    auto result = makePooled<NoiseFilter>(builderPool());
     result->filter = std::move(filter);
     result->kind = kind;
     result->useColor = useColor;
@@ -444,7 +464,7 @@ saturate(FilterPtr filter, float amount)
     if (amount < 0 || !filter)
         return filter;
 
-    auto result = std::make_shared<SaturateFilter>();
+    auto result = makePooled<SaturateFilter>(builderPool());
     result->filter = std::move(filter);
     result->amount = amount;
     return result;
@@ -453,7 +473,7 @@ saturate(FilterPtr filter, float amount)
 FilterPtr
 solid(PaintPtr paint)
 {
-    auto result = std::make_shared<SolidFilter>();
+    auto result = makePooled<SolidFilter>(builderPool());
     result->paint = std::move(paint);
     return result;
 }
@@ -462,7 +482,7 @@ solid(PaintPtr paint)
 
 stroke::stroke(sg::PaintPtr paint)
 {
-    mStroke = std::make_shared<StrokePathOp>();
+    mStroke = makePooled<StrokePathOp>(builderPool());
     mStroke->paint = paint;
 }
 
@@ -0,0 +1,657 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "apl/scenegraph/scenegraphstream.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "apl/content/packedjson.h"
+#include "apl/scenegraph/accessibility.h"
+#include "apl/scenegraph/layer.h"
+#include "apl/scenegraph/node.h"
+#include "apl/scenegraph/path.h"
+#include "apl/scenegraph/scenegraph.h"
+#include "apl/scenegraph/shadow.h"
+
+namespace apl {
+namespace sg {
+
+namespace {
+
+const char STREAM_MAGIC[4] = {'A', 'P', 'L', 'S'};
+const size_t STREAM_HEADER_SIZE = 28;
+const size_t STREAM_COUNT_OFFSET = 24;
+const size_t STREAM_TOP_OFFSET = 12;
+
+const std::uint8_t kFrameReset = 1u << 0;
+
+enum RecordType : std::uint8_t {
+    kRecordCreate = 1,
+    kRecordUpdate = 2,
+    kRecordRemove = 3
+};
+
+const std::uint16_t kPropertyBounds = Layer::kFlagPositionChanged | Layer::kFlagSizeChanged;
+const std::uint16_t kPropertyAll = (Layer::kFlagInteractionChanged << 1) - 1;
+
+void
+writeU8(std::string& out, std::uint8_t value)
+{
+    out.push_back(static_cast<char>(value));
+}
+
+void
+writeU16(std::string& out, std::uint16_t value)
+{
+    out.push_back(static_cast<char>(value & 0xff));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+void
+writeU32(std::string& out, std::uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+void
+patchU32(std::string& out, size_t offset, std::uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+        out[offset + i] = static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+void
+writeFloat(std::string& out, float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU32(out, bits);
+}
+
+void
+writePoint(std::string& out, const Point& point)
+{
+    writeFloat(out, point.getX());
+    writeFloat(out, point.getY());
+}
+
+/**
+ * Bounds-checked little-endian reader.  Once a read fails every later read fails too.
+ */
+class Reader {
+public:
+    Reader(const char *data, size_t length)
+        : mData(reinterpret_cast<const std::uint8_t*>(data)), mLength(length) {}
+
+    bool ok() const { return mOk; }
+    bool atEnd() const { return mOffset == mLength; }
+    size_t offset() const { return mOffset; }
+
+    const char *take(size_t length) {
+        if (!mOk || mLength - mOffset < length) {
+            mOk = false;
+            return nullptr;
+        }
+        auto result = reinterpret_cast<const char*>(mData + mOffset);
+        mOffset += length;
+        return result;
+    }
+
+    std::uint8_t u8() {
+        auto p = take(1);
+        return p ? static_cast<std::uint8_t>(*p) : 0;
+    }
+
+    std::uint16_t u16() {
+        auto p = reinterpret_cast<const std::uint8_t*>(take(2));
+        return p ? static_cast<std::uint16_t>(p[0] | (p[1] << 8)) : 0;
+    }
+
+    std::uint32_t u32() {
+        auto p = reinterpret_cast<const std::uint8_t*>(take(4));
+        if (!p)
+            return 0;
+        return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+               (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+    }
+
+    float f32() {
+        auto bits = u32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    Point point() {
+        auto x = f32();
+        auto y = f32();
+        return {x, y};
+    }
+
+    void string(std::string& out) {
+        auto length = u32();
+        auto p = take(length);
+        if (p)
+            out.assign(p, length);
+    }
+
+private:
+    const std::uint8_t *mData;
+    size_t mLength;
+    size_t mOffset = 0;
+    bool mOk = true;
+};
+
+} // namespace
+
+/****************************************************************************/
+
+void
+SceneGraphEncoder::reset()
+{
+    mLayers.clear();
+    mById.clear();
+    mPending.clear();
+    mDetached.clear();
+    mTop = nullptr;
+    mNeedsReset = true;
+}
+
+void
+SceneGraphEncoder::encode(SceneGraph& sceneGraph, std::string& out)
+{
+    mOut = &out;
+    mRecords = 0;
+    mFrame++;
+
+    auto top = sceneGraph.getLayer();
+    if (top != mTop) {
+        reset();
+        mTop = top;
+    }
+
+    out.clear();
+    out.append(STREAM_MAGIC, sizeof(STREAM_MAGIC));
+    writeU8(out, VERSION);
+    writeU8(out, mNeedsReset ? kFrameReset : 0);
+    writeU16(out, 0);
+    writeU32(out, mFrame);
+    writeU32(out, 0);   // Top layer
+    writePoint(out, Point(sceneGraph.getViewportSize().getWidth(), sceneGraph.getViewportSize().getHeight()));
+    writeU32(out, 0);   // Record count
+
+    if (mNeedsReset) {
+        mNeedsReset = false;
+        if (mTop)
+            track(mTop);
+    } else {
+        sceneGraph.updates().mapChanged([&](const LayerPtr& layer) {
+            // Layers that are not attached to the tree, or were just attached, are written in full
+            auto it = mLayers.find(layer.get());
+            if (it == mLayers.end() || it->second.pending)
+                return;
+
+            std::uint16_t mask = 0;
+            for (std::uint16_t bit = 1; bit != 0 && bit <= kPropertyAll; bit <<= 1)
+                if (layer->isFlagSet(bit))
+                    mask |= bit;
+
+            if (mask)
+                writeUpdate(it->second, mask);
+        });
+    }
+
+    // Newly attached layers.  Writing a layer may attach more.
+    while (!mPending.empty()) {
+        auto ptr = mPending.back();
+        mPending.pop_back();
+        auto it = mLayers.find(ptr);
+        if (it != mLayers.end() && it->second.pending)
+            writeCreate(it->second);
+    }
+
+    // Layers dropped from a child list and not attached anywhere else
+    for (auto id : mDetached) {
+        auto it = mById.find(id);
+        if (it != mById.end() && it->second != mTop.get() && mLayers.at(it->second).parent == 0)
+            remove(id);
+    }
+    mDetached.clear();
+
+    if (mTop)
+        patchU32(out, STREAM_TOP_OFFSET, mLayers.at(mTop.get()).id);
+    patchU32(out, STREAM_COUNT_OFFSET, mRecords);
+
+    mAllocator.Clear();
+    mOut = nullptr;
+}
+
+std::uint32_t
+SceneGraphEncoder::track(const LayerPtr& layer)
+{
+    auto it = mLayers.find(layer.get());
+    if (it != mLayers.end())
+        return it->second.id;
+
+    auto id = mNextId++;
+    Tracked tracked;
+    tracked.layer = layer;
+    tracked.id = id;
+    mLayers.emplace(layer.get(), std::move(tracked));
+    mById.emplace(id, layer.get());
+    mPending.emplace_back(layer.get());
+    return id;
+}
+
+void
+SceneGraphEncoder::writeCreate(Tracked& tracked)
+{
+    writeU8(*mOut, kRecordCreate);
+    writeU32(*mOut, tracked.id);
+    const auto& name = tracked.layer->getName();
+    writeU32(*mOut, static_cast<std::uint32_t>(name.size()));
+    mOut->append(name);
+
+    tracked.pending = false;
+    writeProperties(tracked, kPropertyAll);
+    mRecords++;
+}
+
+void
+SceneGraphEncoder::writeUpdate(Tracked& tracked, std::uint16_t mask)
+{
+    writeU8(*mOut, kRecordUpdate);
+    writeU32(*mOut, tracked.id);
+    writeProperties(tracked, mask);
+    mRecords++;
+}
+
+void
+SceneGraphEncoder::writeProperties(Tracked& tracked, std::uint16_t mask)
+{
+    auto& out = *mOut;
+    const auto& layer = *tracked.layer;
+
+    writeU16(out, mask);
+    writeU8(out, layer.getInteraction());
+    writeU8(out, layer.getCharacteristic());
+
+    if (mask & Layer::kFlagOpacityChanged)
+        writeFloat(out, layer.getOpacity());
+
+    if (mask & kPropertyBounds) {
+        auto bounds = layer.getBounds();
+        writeFloat(out, bounds.getX());
+        writeFloat(out, bounds.getY());
+        writeFloat(out, bounds.getWidth());
+        writeFloat(out, bounds.getHeight());
+    }
+
+    if (mask & Layer::kFlagTransformChanged)
+        for (const auto& m : layer.getTransform().get())
+            writeFloat(out, m);
+
+    if (mask & Layer::kFlagChildOffsetChanged)
+        writePoint(out, layer.getChildOffset());
+
+    if (mask & Layer::kFlagOutlineChanged) {
+        if (layer.getOutline())
+            writeBlob(layer.getOutline()->serialize(mAllocator));
+        else
+            writeEmptyBlob();
+    }
+
+    if (mask & Layer::kFlagRedrawContent) {
+        writePoint(out, layer.getContentOffset());
+        if (layer.content()) {
+            auto content = rapidjson::Value(rapidjson::kArrayType);
+            for (auto node = layer.content(); node; node = node->next())
+                content.PushBack(node->serialize(mAllocator), mAllocator);
+            writeBlob(content);
+        } else {
+            writeEmptyBlob();
+        }
+    }
+
+    if (mask & Layer::kFlagRedrawShadow) {
+        if (layer.getShadow())
+            writeBlob(layer.getShadow()->serialize(mAllocator));
+        else
+            writeEmptyBlob();
+    }
+
+    if (mask & Layer::kFlagChildrenChanged)
+        writeChildren(tracked);
+
+    if (mask & Layer::kFlagChildClipChanged) {
+        if (layer.getChildClip())
+            writeBlob(layer.getChildClip()->serialize(mAllocator));
+        else
+            writeEmptyBlob();
+    }
+
+    if (mask & Layer::kFlagAccessibilityChanged) {
+        if (layer.getAccessibility())
+            writeBlob(layer.getAccessibility()->serialize(mAllocator));
+        else
+            writeEmptyBlob();
+    }
+}
+
+void
+SceneGraphEncoder::writeChildren(Tracked& tracked)
+{
+    auto previous = std::move(tracked.children);
+    tracked.children.clear();
+
+    for (const auto& child : tracked.layer->children()) {
+        auto id = track(child);
+        mLayers.at(child.get()).parent = tracked.id;
+        tracked.children.emplace_back(id);
+    }
+
+    // Children that are no longer attached here are candidates for removal
+    for (auto id : previous) {
+        if (std::find(tracked.children.begin(), tracked.children.end(), id) != tracked.children.end())
+            continue;
+
+        auto it = mById.find(id);
+        if (it == mById.end())
+            continue;
+
+        auto& child = mLayers.at(it->second);
+        if (child.parent == tracked.id) {
+            child.parent = 0;
+            mDetached.emplace_back(id);
+        }
+    }
+
+    writeU32(*mOut, static_cast<std::uint32_t>(tracked.children.size()));
+    for (auto id : tracked.children)
+        writeU32(*mOut, id);
+}
+
+void
+SceneGraphEncoder::writeBlob(const rapidjson::Value& value)
+{
+    auto packed = PackedJson::pack(value);
+    writeU32(*mOut, static_cast<std::uint32_t>(packed.size()));
+    mOut->append(packed);
+}
+
+void
+SceneGraphEncoder::writeEmptyBlob()
+{
+    writeU32(*mOut, 0);
+}
+
+void
+SceneGraphEncoder::remove(std::uint32_t id) // NOLINT(misc-no-recursion)
+{
+    auto it = mById.find(id);
+    if (it == mById.end())
+        return;
+
+    auto ptr = it->second;
+    auto children = std::move(mLayers.at(ptr).children);
+    mLayers.erase(ptr);
+    mById.erase(it);
+
+    writeU8(*mOut, kRecordRemove);
+    writeU32(*mOut, id);
+    mRecords++;
+
+    // Children that were not moved to another parent leave with their parent
+    for (auto child : children) {
+        auto childIt = mById.find(child);
+        if (childIt != mById.end() && mLayers.at(childIt->second).parent == id)
+            remove(child);
+    }
+}
+
+/****************************************************************************/
+
+void
+SceneGraphDecoder::reset()
+{
+    mLayers.clear();
+    mFrame = 0;
+    mTopLayer = 0;
+    mViewportSize = {};
+    mError.clear();
+}
+
+const SceneGraphDecoder::LayerState *
+SceneGraphDecoder::getLayer(std::uint32_t id) const
+{
+    auto it = mLayers.find(id);
+    return it != mLayers.end() ? &it->second : nullptr;
+}
+
+bool
+SceneGraphDecoder::decode(const char *data, size_t length)
+{
+    mError.clear();
+
+    Reader reader(data, length);
+    auto magic = reader.take(sizeof(STREAM_MAGIC));
+    if (!magic || std::memcmp(magic, STREAM_MAGIC, sizeof(STREAM_MAGIC)) != 0 || length < STREAM_HEADER_SIZE) {
+        mError = "Not a scene graph stream";
+        return false;
+    }
+
+    auto version = reader.u8();
+    if (version != SceneGraphEncoder::VERSION) {
+        mError = "Unsupported scene graph stream version " + std::to_string(version);
+        return false;
+    }
+
+    auto flags = reader.u8();
+    reader.u16();
+    auto frame = reader.u32();
+    auto top = reader.u32();
+    auto viewport = reader.point();
+    auto count = reader.u32();
+
+    if (flags & kFrameReset)
+        mLayers.clear();
+
+    std::vector<std::uint32_t> touched;
+    for (std::uint32_t i = 0; i < count && reader.ok(); i++) {
+        auto type = reader.u8();
+        auto id = reader.u32();
+        if (!reader.ok())
+            break;
+
+        LayerState *state = nullptr;
+        switch (type) {
+            case kRecordCreate: {
+                if (id == 0) {
+                    mError = "Invalid layer id 0";
+                    return false;
+                }
+                state = &mLayers[id];
+                *state = LayerState();
+                reader.string(state->name);
+                break;
+            }
+            case kRecordUpdate: {
+                auto it = mLayers.find(id);
+                if (it == mLayers.end()) {
+                    mError = "Update for unknown layer " + std::to_string(id);
+                    return false;
+                }
+                state = &it->second;
+                break;
+            }
+            case kRecordRemove:
+                if (mLayers.erase(id) == 0) {
+                    mError = "Remove for unknown layer " + std::to_string(id);
+                    return false;
+                }
+                continue;
+            default:
+                mError = "Unknown record type " + std::to_string(type);
+                return false;
+        }
+
+        touched.emplace_back(id);
+
+        auto mask = reader.u16();
+        state->interaction = reader.u8();
+        state->characteristics = reader.u8();
+
+        if (mask & Layer::kFlagOpacityChanged)
+            state->opacity = reader.f32();
+
+        if (mask & kPropertyBounds) {
+            auto x = reader.f32();
+            auto y = reader.f32();
+            auto width = reader.f32();
+            auto height = reader.f32();
+            state->bounds = Rect(x, y, width, height);
+        }
+
+        if (mask & Layer::kFlagTransformChanged) {
+            std::array<float, 6> values;
+            for (auto& m : values)
+                m = reader.f32();
+            state->transform = Transform2D(std::move(values));
+        }
+
+        if (mask & Layer::kFlagChildOffsetChanged)
+            state->childOffset = reader.point();
+
+        if (mask & Layer::kFlagOutlineChanged)
+            reader.string(state->outline);
+
+        if (mask & Layer::kFlagRedrawContent) {
+            state->contentOffset = reader.point();
+            reader.string(state->content);
+        }
+
+        if (mask & Layer::kFlagRedrawShadow)
+            reader.string(state->shadow);
+
+        if (mask & Layer::kFlagChildrenChanged) {
+            auto childCount = reader.u32();
+            if (childCount > (length - reader.offset()) / 4) {
+                mError = "Malformed scene graph stream at offset " + std::to_string(reader.offset());
+                return false;
+            }
+            state->children.resize(childCount);
+            for (auto& child : state->children)
+                child = reader.u32();
+        }
+
+        if (mask & Layer::kFlagChildClipChanged)
+            reader.string(state->childClip);
+
+        if (mask & Layer::kFlagAccessibilityChanged)
+            reader.string(state->accessibility);
+    }
+
+    if (!reader.ok() || !reader.atEnd()) {
+        mError = "Malformed scene graph stream at offset " + std::to_string(reader.offset());
+        return false;
+    }
+
+    if (top != 0 && !mLayers.count(top)) {
+        mError = "Missing top layer " + std::to_string(top);
+        return false;
+    }
+
+    for (auto id : touched) {
+        auto it = mLayers.find(id);
+        if (it == mLayers.end())
+            continue;
+        for (auto child : it->second.children) {
+            if (!mLayers.count(child)) {
+                mError = "Layer " + std::to_string(id) + " has unknown child " + std::to_string(child);
+                return false;
+            }
+        }
+    }
+
+    mFrame = frame;
+    mTopLayer = top;
+    mViewportSize = Size(viewport.getX(), viewport.getY());
+    return true;
+}
+
+/**
+ * Expand a packed blob and copy it into the allocator
+ */
+static rapidjson::Value
+unpackBlob(const std::string& blob, rapidjson::Document::AllocatorType& allocator)
+{
+    auto json = PackedJson::unpack(blob.data(), blob.size(), nullptr);
+    if (!json)
+        return rapidjson::Value();
+    return rapidjson::Value(json.get(), allocator);
+}
+
+rapidjson::Value
+SceneGraphDecoder::serialize(rapidjson::Document::AllocatorType& allocator) const
+{
+    if (mTopLayer)
+        return serializeLayer(mTopLayer, allocator);
+
+    return rapidjson::Value(rapidjson::kObjectType);
+}
+
+rapidjson::Value
+SceneGraphDecoder::serializeLayer(std::uint32_t id, rapidjson::Document::AllocatorType& allocator) const // NOLINT(misc-no-recursion)
+{
+    // Keep this in sync with Layer::serialize
+    const auto& state = mLayers.at(id);
+    auto out = rapidjson::Value(rapidjson::kObjectType);
+
+    out.AddMember("name", rapidjson::Value(state.name.c_str(), allocator), allocator);
+    out.AddMember("opacity", state.opacity, allocator);
+    out.AddMember("bounds", state.bounds.serialize(allocator), allocator);
+    out.AddMember("transform", state.transform.serialize(allocator), allocator);
+    out.AddMember("childOffset", state.childOffset.serialize(allocator), allocator);
+    out.AddMember("contentOffset", state.contentOffset.serialize(allocator), allocator);
+
+    if (!state.accessibility.empty())
+        out.AddMember("accessibility", unpackBlob(state.accessibility, allocator), allocator);
+    if (!state.outline.empty())
+        out.AddMember("outline", unpackBlob(state.outline, allocator), allocator);
+    if (!state.childClip.empty())
+        out.AddMember("childClip", unpackBlob(state.childClip, allocator), allocator);
+    if (!state.shadow.empty())
+        out.AddMember("shadow", unpackBlob(state.shadow, allocator), allocator);
+    if (!state.content.empty())
+        out.AddMember("content", unpackBlob(state.content, allocator), allocator);
+
+    if (!state.children.empty()) {
+        auto childrenArray = rapidjson::Value(rapidjson::kArrayType);
+        for (auto child : state.children)
+            childrenArray.PushBack(serializeLayer(child, allocator), allocator);
+        out.AddMember("children", childrenArray, allocator);
+    }
+
+    out.AddMember("interaction", state.interaction, allocator);
+    out.AddMember("characteristics", state.characteristics, allocator);
+
+    return out;
+}
+
+} // namespace sg
+} // namespace apl
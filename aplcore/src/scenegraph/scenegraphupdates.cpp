@@ -14,7 +14,6 @@
  */
 
 #include <algorithm>
-#include <set>
 
 #include "apl/scenegraph/scenegraph.h"
 #include "apl/scenegraph/layer.h"
@@ -23,6 +22,13 @@
 namespace apl {
 namespace sg {
 
+static void
+sortUnique(std::vector<LayerPtr>& layers)
+{
+    std::sort(layers.begin(), layers.end());
+    layers.erase(std::unique(layers.begin(), layers.end()), layers.end());
+}
+
 void
 SceneGraphUpdates::clear()
 {
@@ -35,6 +41,7 @@ SceneGraphUpdates::clear()
     mCreated.clear();
 
     mResize.clear();
+    mNormalized = true;
 }
 
 void
@@ -43,32 +50,48 @@ SceneGraphUpdates::changed(const LayerPtr& layer)
     if (!layer->anyFlagSet())
         return;
 
-    // Don't add it to the changed set if it is in the created set
-    auto it = mCreated.find(layer);
-    if (it == mCreated.end())
-        mChanged.emplace(layer);
+    // Created layers are removed from the changed list when it is normalized
+    mChanged.emplace_back(layer);
+    mNormalized = false;
 }
 
 void
 SceneGraphUpdates::created(const LayerPtr& layer)
 {
-    // Remove it from the
-    auto it = mChanged.find(layer);
-    if (it != mChanged.end())
-        mChanged.erase(it);
-
-    mCreated.emplace(layer);
+    mCreated.emplace_back(layer);
+    mNormalized = false;
 }
 
 void
 SceneGraphUpdates::resize(const LayerPtr& layer)
 {
-    mResize.emplace(layer);
+    mResize.emplace_back(layer);
+}
+
+void
+SceneGraphUpdates::normalize()
+{
+    if (mNormalized)
+        return;
+
+    sortUnique(mCreated);
+    sortUnique(mChanged);
+
+    // Don't report a layer as changed if it was created in this frame
+    if (!mCreated.empty()) {
+        auto it = std::remove_if(mChanged.begin(), mChanged.end(), [&](const LayerPtr& layer) {
+            return std::binary_search(mCreated.begin(), mCreated.end(), layer);
+        });
+        mChanged.erase(it, mChanged.end());
+    }
+
+    mNormalized = true;
 }
 
 void
 SceneGraphUpdates::mapChanged(const std::function<void(const LayerPtr&)>& func)
 {
+    normalize();
     for (const auto& m : mChanged)
         func(m);
 }
@@ -76,6 +99,7 @@ SceneGraphUpdates::mapChanged(const std::function<void(const LayerPtr&)>& func)
 void
 SceneGraphUpdates::fixCreatedFlags()
 {
+    normalize();
     for (const auto& m : mCreated)
         m->clearFlags();
 }
@@ -83,6 +107,7 @@ SceneGraphUpdates::fixCreatedFlags()
 void
 SceneGraphUpdates::processResize()
 {
+    sortUnique(mResize);
     for (const auto& m : mResize) {
         Rect bb = sg::Node::calculateBoundingBox(m->content());
         if (m->setBounds(bb)) {
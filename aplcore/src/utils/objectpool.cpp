@@ -0,0 +1,113 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+#include "apl/utils/objectpool.h"
+
+namespace apl {
+
+const size_t ObjectPool::GRANULARITY = alignof(std::max_align_t) > 16 ? alignof(std::max_align_t) : 16;
+const size_t ObjectPool::MAX_POOLED_SIZE = 512;
+const size_t ObjectPool::CHUNK_SIZE = 32 * 1024;
+
+ObjectPool::~ObjectPool()
+{
+    for (auto chunk : mChunks)
+        ::operator delete(chunk);
+}
+
+void *
+ObjectPool::allocate(size_t bytes)
+{
+    if (bytes > MAX_POOLED_SIZE) {
+        mStats.oversized++;
+        return ::operator new(bytes);
+    }
+
+    auto index = sizeClass(bytes);
+    auto blockSize = index * GRANULARITY;
+
+    mStats.allocations++;
+    mStats.bytesInUse += blockSize;
+    if (mStats.bytesInUse > mStats.peakBytesInUse)
+        mStats.peakBytesInUse = mStats.bytesInUse;
+
+    if (index < mFreeLists.size() && mFreeLists[index]) {
+        auto node = mFreeLists[index];
+        mFreeLists[index] = node->next;
+        mStats.reused++;
+        return node;
+    }
+
+    return carve(blockSize);
+}
+
+void
+ObjectPool::deallocate(void *ptr, size_t bytes)
+{
+    if (!ptr)
+        return;
+
+    if (bytes > MAX_POOLED_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto index = sizeClass(bytes);
+    if (index >= mFreeLists.size())
+        mFreeLists.resize(index + 1, nullptr);
+
+    auto node = static_cast<FreeNode *>(ptr);
+    node->next = mFreeLists[index];
+    mFreeLists[index] = node;
+
+    assert(mStats.bytesInUse >= index * GRANULARITY);
+    mStats.deallocations++;
+    mStats.bytesInUse -= index * GRANULARITY;
+}
+
+void *
+ObjectPool::carve(size_t bytes)
+{
+    if (mCursor == nullptr || static_cast<size_t>(mEnd - mCursor) < bytes) {
+        // Hand the unused tail of the current chunk to the free lists before moving on
+        while (mCursor && static_cast<size_t>(mEnd - mCursor) >= GRANULARITY) {
+            auto remaining = static_cast<size_t>(mEnd - mCursor);
+            auto tail = std::min(remaining, MAX_POOLED_SIZE) / GRANULARITY * GRANULARITY;
+            auto index = sizeClass(tail);
+            if (index >= mFreeLists.size())
+                mFreeLists.resize(index + 1, nullptr);
+            auto node = reinterpret_cast<FreeNode *>(mCursor);
+            node->next = mFreeLists[index];
+            mFreeLists[index] = node;
+            mCursor += tail;
+        }
+
+        auto chunk = static_cast<char *>(::operator new(CHUNK_SIZE));
+        mChunks.push_back(chunk);
+        mStats.reservedBytes += CHUNK_SIZE;
+        mCursor = chunk;
+        mEnd = chunk + CHUNK_SIZE;
+    }
+
+    auto result = mCursor;
+    mCursor += bytes;
+    return result;
+}
+
+} // namespace apl
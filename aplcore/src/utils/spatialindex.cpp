@@ -0,0 +1,192 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "apl/utils/spatialindex.h"
+
+namespace apl {
+
+void
+SpatialIndex::build(std::vector<Rect>&& boxes)
+{
+    mBoxes = std::move(boxes);
+    mCellStart.clear();
+    mEntries.clear();
+    mLarge.clear();
+    mStamp.assign(mBoxes.size(), 0);
+    mQuery = 0;
+
+    // The grid covers the union of the non-empty rectangles
+    size_t count = 0;
+    float left = 0, top = 0, right = 0, bottom = 0;
+    for (const auto& box : mBoxes) {
+        if (box.empty())
+            continue;
+
+        if (count++ == 0) {
+            left = box.getLeft();
+            top = box.getTop();
+            right = box.getRight();
+            bottom = box.getBottom();
+        } else {
+            left = std::min(left, box.getLeft());
+            top = std::min(top, box.getTop());
+            right = std::max(right, box.getRight());
+            bottom = std::max(bottom, box.getBottom());
+        }
+    }
+
+    if (count == 0) {
+        mBounds = Rect();
+        mColumns = mRows = 0;
+        return;
+    }
+
+    // Aim for about one rectangle per cell, with cells roughly square
+    mBounds = Rect(left, top, right - left, bottom - top);
+    auto width = std::max(right - left, 1.0f);
+    auto height = std::max(bottom - top, 1.0f);
+    auto columns = std::ceil(std::sqrt(static_cast<float>(count) * width / height));
+    mColumns = std::max(1, std::min(static_cast<int>(columns), static_cast<int>(count)));
+    mRows = std::max(1, static_cast<int>(std::ceil(static_cast<float>(count) / static_cast<float>(mColumns))));
+    mCellWidth = width / static_cast<float>(mColumns);
+    mCellHeight = height / static_cast<float>(mRows);
+
+    // Two passes: count the entries in each cell, then fill them in
+    auto cells = static_cast<size_t>(mColumns * mRows);
+    mCellStart.assign(cells + 1, 0);
+
+    int c0, c1, r0, r1;
+    for (const auto& box : mBoxes) {
+        if (box.empty() || isLarge(box))
+            continue;
+
+        cellRange(box, c0, c1, r0, r1);
+        for (int r = r0; r <= r1; r++)
+            for (int c = c0; c <= c1; c++)
+                mCellStart[c + r * mColumns + 1]++;
+    }
+
+    for (size_t i = 1; i <= cells; i++)
+        mCellStart[i] += mCellStart[i - 1];
+
+    mEntries.resize(mCellStart[cells]);
+    std::vector<uint32_t> fill(mCellStart.begin(), mCellStart.end() - 1);
+    for (size_t i = 0; i < mBoxes.size(); i++) {
+        const auto& box = mBoxes[i];
+        if (box.empty())
+            continue;
+
+        if (isLarge(box)) {
+            mLarge.push_back(static_cast<uint32_t>(i));
+            continue;
+        }
+
+        cellRange(box, c0, c1, r0, r1);
+        for (int r = r0; r <= r1; r++)
+            for (int c = c0; c <= c1; c++)
+                mEntries[fill[c + r * mColumns]++] = static_cast<uint32_t>(i);
+    }
+}
+
+void
+SpatialIndex::clear()
+{
+    mBoxes.clear();
+    mBounds = Rect();
+    mColumns = mRows = 0;
+    mCellStart.clear();
+    mEntries.clear();
+    mLarge.clear();
+    mStamp.clear();
+}
+
+void
+SpatialIndex::findIntersecting(const Rect& region, std::vector<size_t>& result) const
+{
+    result.clear();
+    if (mColumns == 0 || mBounds.intersect(region).empty())
+        return;
+
+    // A rectangle can be stored in several cells; the stamp reports each one once
+    if (++mQuery == 0) {
+        std::fill(mStamp.begin(), mStamp.end(), 0);
+        mQuery = 1;
+    }
+
+    int c0, c1, r0, r1;
+    cellRange(region, c0, c1, r0, r1);
+    for (int r = r0; r <= r1; r++)
+        for (int c = c0; c <= c1; c++) {
+            auto cell = c + r * mColumns;
+            for (auto i = mCellStart[cell]; i < mCellStart[cell + 1]; i++)
+                report(mEntries[i], region, result);
+        }
+
+    for (auto index : mLarge)
+        report(index, region, result);
+
+    std::sort(result.begin(), result.end());
+}
+
+void
+SpatialIndex::report(uint32_t index, const Rect& region, std::vector<size_t>& result) const
+{
+    if (mStamp[index] == mQuery)
+        return;
+
+    mStamp[index] = mQuery;
+    if (!region.intersect(mBoxes[index]).empty())
+        result.push_back(index);
+}
+
+bool
+SpatialIndex::isLarge(const Rect& box) const
+{
+    int c0, c1, r0, r1;
+    cellRange(box, c0, c1, r0, r1);
+    return static_cast<size_t>((c1 - c0 + 1) * (r1 - r0 + 1)) > MAX_CELLS_PER_BOX;
+}
+
+void
+SpatialIndex::cellRange(const Rect& rect, int& c0, int& c1, int& r0, int& r1) const
+{
+    c0 = column(rect.getLeft());
+    c1 = column(rect.getRight());
+    r0 = row(rect.getTop());
+    r1 = row(rect.getBottom());
+}
+
+int
+SpatialIndex::column(float x) const
+{
+    auto c = std::floor((x - mBounds.getLeft()) / mCellWidth);
+    if (!(c > 0))   // Also catches NaN
+        return 0;
+    return c < static_cast<float>(mColumns - 1) ? static_cast<int>(c) : mColumns - 1;
+}
+
+int
+SpatialIndex::row(float y) const
+{
+    auto r = std::floor((y - mBounds.getTop()) / mCellHeight);
+    if (!(r > 0))
+        return 0;
+    return r < static_cast<float>(mRows - 1) ? static_cast<int>(r) : mRows - 1;
+}
+
+} // namespace apl
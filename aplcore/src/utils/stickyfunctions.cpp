@@ -59,6 +59,8 @@ updateStickyOffset(const CoreComponentPtr &component) {
     component->setCalculated(kPropertyBounds, std::move(b));
     component->setDirty(kPropertyBounds);
     component->setStickyOffset(offset);
+    if (auto parent = CoreComponent::cast(component->getParent()))
+        parent->markChildIndexStale();
 }
 
 static Point
@@ -114,6 +114,18 @@ YogaNode::isDirty() const
     return YGNodeIsDirty(TO_YOGA_NODE(mNode));
 }
 
+bool
+YogaNode::hasNewLayout() const
+{
+    return YGNodeGetHasNewLayout(TO_YOGA_NODE(mNode));
+}
+
+void
+YogaNode::setHasNewLayout(bool hasNewLayout)
+{
+    YGNodeSetHasNewLayout(TO_YOGA_NODE(mNode), hasNewLayout);
+}
+
 void
 YogaNode::setDirtiedFunc(DirtiedFunc dirtiedFunc)
 {
@@ -13,6 +13,9 @@
  * permissions and limitations under the License.
  */
 
+#include <chrono>
+#include <functional>
+
 #include "../testeventloop.h"
 #include "apl/utils/searchvisitor.h"
 
@@ -480,3 +483,234 @@ TEST_F(FindComponentAtPosition, AbsolutePositionedPager)
     foundComponent = visitor.getResult();
     ASSERT_EQ(tw->getUniqueId(), foundComponent->getUniqueId());
 }
+
+static const char *MANY_CHILDREN = R"({
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "items": {
+      "type": "Container",
+      "width": 800,
+      "height": 800,
+      "items": [
+        {
+          "type": "Container",
+          "id": "GRID",
+          "width": 800,
+          "height": 400,
+          "direction": "row",
+          "wrap": "wrap",
+          "data": "${Array.range(200)}",
+          "items": {
+            "type": "TouchWrapper",
+            "id": "item${index}",
+            "width": 40,
+            "height": 40,
+            "transform": [ { "rotate": "${index % 7 == 0 ? 30 : 0}" }, { "scale": "${index % 11 == 0 ? 1.5 : 1}" } ],
+            "item": {
+              "type": "Frame",
+              "width": "100%",
+              "height": "100%"
+            }
+          }
+        },
+        {
+          "type": "Sequence",
+          "id": "SEQUENCE",
+          "position": "absolute",
+          "top": 400,
+          "width": 800,
+          "height": 400,
+          "data": "${Array.range(100)}",
+          "items": {
+            "type": "TouchWrapper",
+            "id": "row${index}",
+            "width": "100%",
+            "height": 30,
+            "item": {
+              "type": "Text",
+              "text": "${index}"
+            }
+          }
+        },
+        {
+          "type": "Frame",
+          "id": "OVERLAY",
+          "position": "absolute",
+          "left": 300,
+          "top": 100,
+          "width": 100,
+          "height": 100
+        }
+      ]
+    }
+  }
+})";
+
+/**
+ * Describe a component by the nearest ancestor with an id and the path of child indexes from it
+ */
+static std::string
+describe(const ComponentPtr& component)
+{
+    if (!component)
+        return "";
+    if (!component->getId().empty())
+        return component->getId();
+
+    auto parent = component->getParent();
+    if (!parent)
+        return "top";
+
+    size_t index = 0;
+    while (parent->getChildAt(index) != component)
+        index++;
+    return describe(parent) + "/" + std::to_string(index);
+}
+
+/**
+ * Hit test a grid of points and describe the component found at each point
+ */
+static std::vector<std::string>
+hitTest(const CoreComponentPtr& top)
+{
+    std::vector<std::string> result;
+    for (float y = -5; y < 810; y += 7)
+        for (float x = -5; x < 810; x += 7)
+            result.emplace_back(describe(top->findComponentAtPosition(Point(x, y))));
+    return result;
+}
+
+TEST_F(FindComponentAtPosition, SpatialIndex)
+{
+    // Each step changes the layout; the hit test results must match those without the index
+    std::vector<std::function<void()>> steps = {
+        [&]() {},
+        [&]() {
+            root->findComponentById("SEQUENCE")->update(kUpdateScrollPosition, 500);
+        },
+        [&]() {
+            executeCommand("SetValue", {{"componentId", "item1"},
+                                        {"property", "transform"},
+                                        {"value", JsonData(R"([{"translateX": 45}])").get()}}, true);
+        },
+        [&]() {
+            executeCommand("SetValue", {{"componentId", "item3"}, {"property", "display"}, {"value", "none"}}, true);
+        },
+        [&]() {
+            executeCommand("SetValue", {{"componentId", "OVERLAY"}, {"property", "left"}, {"value", 10}}, true);
+        },
+        [&]() {
+            root->findComponentById("SEQUENCE")->update(kUpdateScrollPosition, 0);
+        },
+    };
+
+    std::vector<std::vector<std::string>> expected;
+    loadDocument(MANY_CHILDREN);
+    for (const auto& step : steps) {
+        step();
+        root->clearPending();
+        expected.emplace_back(hitTest(component));
+    }
+
+    config->enableExperimentalFeature(RootConfig::kExperimentalFeatureSpatialIndex);
+    loadDocument(MANY_CHILDREN);
+    for (size_t i = 0; i < steps.size(); i++) {
+        steps[i]();
+        root->clearPending();
+        ASSERT_EQ(expected[i], hitTest(component)) << "step " << i;
+    }
+
+    // The overlay has moved
+    ASSERT_EQ("OVERLAY", describe(component->findComponentAtPosition(Point(50, 150))));
+}
+
+TEST_F(FindComponentAtPosition, SpatialIndexFocus)
+{
+    loadDocument(MANY_CHILDREN);
+    auto grid = CoreComponent::cast(root->findComponentById("GRID"));
+    auto expected = grid->getDisplayedChildCount();
+
+    config->enableExperimentalFeature(RootConfig::kExperimentalFeatureSpatialIndex);
+    loadDocument(MANY_CHILDREN);
+    grid = CoreComponent::cast(root->findComponentById("GRID"));
+    ASSERT_EQ(expected, grid->getDisplayedChildCount());
+    for (size_t i = 0; i < grid->getChildCount(); i++) {
+        auto child = CoreComponent::cast(grid->getChildAt(i));
+        bool displayed = false;
+        for (size_t j = 0; j < grid->getDisplayedChildCount(); j++)
+            displayed |= grid->getDisplayedChildAt(j) == child;
+        ASSERT_EQ(displayed, grid->isDisplayedChild(*child)) << i;
+    }
+
+    // Hiding a child removes it from the displayed children
+    executeCommand("SetValue", {{"componentId", "item0"}, {"property", "display"}, {"value", "none"}}, true);
+    root->clearPending();
+    ASSERT_FALSE(grid->isDisplayedChild(*CoreComponent::cast(root->findComponentById("item0"))));
+    ASSERT_TRUE(grid->isDisplayedChild(*CoreComponent::cast(root->findComponentById("item1"))));
+}
+
+/**
+ * Move a pointer around a document with 2000 components and report the hover and pointer-move
+ * throughput with and without the spatial index.
+ */
+TEST_F(FindComponentAtPosition, PointerMoveBenchmark)
+{
+    const int ROWS = 40;
+    const int COLUMNS = 25;   // Each cell is a TouchWrapper holding a Frame
+    const int MOVES = 2000;
+
+    auto doc = std::string(R"({
+      "type": "APL",
+      "version": "2023.2",
+      "mainTemplate": {
+        "items": {
+          "type": "Container",
+          "width": 1000,
+          "height": 1000,
+          "data": "${Array.range(ROWS)}",
+          "items": {
+            "type": "Container",
+            "direction": "row",
+            "height": 25,
+            "data": "${Array.range(COLUMNS)}",
+            "items": {
+              "type": "TouchWrapper",
+              "width": 40,
+              "height": 25,
+              "item": { "type": "Frame", "width": "100%", "height": "100%" }
+            }
+          }
+        }
+      }
+    })");
+    doc.replace(doc.find("ROWS"), 4, std::to_string(ROWS));
+    doc.replace(doc.find("COLUMNS"), 7, std::to_string(COLUMNS));
+
+    std::vector<std::string> results[2];
+    for (auto indexed : {false, true}) {
+        if (indexed)
+            config->enableExperimentalFeature(RootConfig::kExperimentalFeatureSpatialIndex);
+        loadDocument(doc.c_str());
+        ASSERT_TRUE(component);
+
+        std::vector<ComponentPtr> found;
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < MOVES; i++) {
+            auto point = Point((i * 37) % 1000, (i * 53) % 1000);
+            root->handlePointerEvent(PointerEvent(kPointerMove, point));
+            found.emplace_back(component->findComponentAtPosition(point));
+        }
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+
+        for (const auto& m : found)
+            results[indexed].emplace_back(describe(m));
+
+        std::cout << "[ BENCHMARK] " << ROWS * COLUMNS * 2 << " components, " << MOVES << " pointer moves"
+                  << (indexed ? " with" : " without") << " spatial index: " << us / 1000 << "ms, "
+                  << MOVES * 1000000LL / std::max<long long>(us, 1) << " moves/s" << std::endl;
+    }
+
+    ASSERT_EQ(results[0], results[1]);
+}
@@ -13,12 +13,18 @@
  * permissions and limitations under the License.
  */
 
+#include <chrono>
+#include <functional>
+
 #include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
 
 #include "../testeventloop.h"
 
 #include "apl/component/component.h"
 #include "apl/component/textmeasurement.h"
+#include "apl/document/visualcontextdelta.h"
 #include "apl/primitives/mediastate.h"
 
 using namespace apl;
@@ -2766,4 +2772,249 @@ TEST_F(VisualContextTest, DynamicEntitiesDirect)
     ASSERT_TRUE(visualContext["entities"].IsArray());
     ASSERT_EQ(1, visualContext["entities"].GetArray().Size());
     ASSERT_STREQ("", visualContext["entities"][0].GetString());
-}
\ No newline at end of file
+}
+static const char *CACHED = R"apl({
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Container",
+      "id": "TOP",
+      "width": "100%",
+      "height": "100%",
+      "items": [
+        {
+          "type": "Sequence",
+          "id": "SEQ",
+          "height": 200,
+          "numbered": true,
+          "data": "${Array.range(20)}",
+          "items": {
+            "type": "TouchWrapper",
+            "id": "row${index}",
+            "height": 50,
+            "item": {
+              "type": "Text",
+              "text": "Row ${index}"
+            }
+          }
+        },
+        {
+          "type": "Frame",
+          "id": "FRAME",
+          "width": 100,
+          "height": 100,
+          "entities": [ "frame" ],
+          "item": {
+            "type": "Frame",
+            "id": "INNER",
+            "position": "absolute",
+            "left": 50,
+            "width": 50,
+            "height": 50,
+            "speech": "hello"
+          }
+        },
+        {
+          "type": "TouchWrapper",
+          "id": "TOUCH",
+          "width": 100,
+          "height": 50
+        }
+      ]
+    }
+  }
+})apl";
+
+static std::string
+toString(const rapidjson::Value& value)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    value.Accept(writer);
+    return buffer.GetString();
+}
+
+TEST_F(VisualContextTest, Cached)
+{
+    // Each step changes the document; the cached visual context must match the full serialization
+    std::vector<std::function<void()>> steps = {
+        [&]() {},
+        [&]() { root->findComponentById("SEQ")->update(kUpdateScrollPosition, 120); },
+        [&]() { executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "opacity"}, {"value", 0.5}}, true); },
+        [&]() { executeCommand("SetValue", {{"componentId", "INNER"}, {"property", "transform"},
+                                            {"value", JsonData(R"([{"translateX": -40}])").get()}}, true); },
+        [&]() { executeCommand("SetValue", {{"componentId", "TOUCH"}, {"property", "checked"}, {"value", true}}, true); },
+        [&]() { executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "transform"},
+                                            {"value", JsonData(R"([{"rotate": 45}])").get()}}, true); },
+        [&]() { executeCommand("InsertItem", {{"componentId", "TOP"}, {"at", 1},
+                                              {"item", JsonData(R"({"type": "TouchWrapper", "id": "NEW", "height": 50})").get()}}, true); },
+        [&]() { executeCommand("RemoveItem", {{"componentId", "NEW"}}, true); },
+        [&]() { executeCommand("SetValue", {{"componentId", "INNER"}, {"property", "display"}, {"value", "none"}}, true); },
+        [&]() { executeCommand("SetValue", {{"componentId", "INNER"}, {"property", "display"}, {"value", "normal"}}, true); },
+        [&]() { executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "opacity"}, {"value", 0}}, true); },
+        [&]() { executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "opacity"}, {"value", 1}}, true); },
+        [&]() { root->findComponentById("SEQ")->update(kUpdateScrollPosition, 0); },
+    };
+
+    std::vector<std::string> expected;
+    loadDocument(CACHED);
+    for (const auto& step : steps) {
+        step();
+        root->clearPending();
+        serializeVisualContext();
+        expected.emplace_back(toString(visualContext));
+    }
+
+    config->enableExperimentalFeature(RootConfig::kExperimentalFeatureVisualContextCache);
+    loadDocument(CACHED);
+    for (size_t i = 0; i < steps.size(); i++) {
+        steps[i]();
+        root->clearPending();
+        serializeVisualContext();
+        ASSERT_EQ(expected[i], toString(visualContext)) << "step " << i;
+
+        // Serializing again without changes returns the same result
+        serializeVisualContext();
+        ASSERT_EQ(expected[i], toString(visualContext)) << "step " << i;
+    }
+}
+
+TEST_F(VisualContextTest, Delta)
+{
+    loadDocument(CACHED);
+
+    VisualContextDelta delta;
+    auto result = delta.update(visualContext, vcDoc.GetAllocator());
+    ASSERT_EQ(delta.size(), result["changed"].Size());
+    ASSERT_EQ(0, result["removed"].Size());
+
+    // The children of each changed entry are replaced by their uids
+    auto& top = result["changed"][0];
+    ASSERT_STREQ(component->getUniqueId().c_str(), top["uid"].GetString());
+    ASSERT_TRUE(top["children"][0].IsString());
+
+    // No change
+    serializeVisualContext();
+    result = delta.update(visualContext, vcDoc.GetAllocator());
+    ASSERT_EQ(0, result["changed"].Size());
+    ASSERT_EQ(0, result["removed"].Size());
+
+    // The visibility of the frame and its child changes
+    auto inner = root->findComponentById("INNER")->getUniqueId();
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "opacity"}, {"value", 0.5}}, true);
+    root->clearPending();
+    serializeVisualContext();
+    result = delta.update(visualContext, vcDoc.GetAllocator());
+    ASSERT_EQ(0, result["removed"].Size());
+    ASSERT_EQ(2, result["changed"].Size());
+    ASSERT_STREQ(root->findComponentById("FRAME")->getUniqueId().c_str(), result["changed"][0]["uid"].GetString());
+    ASSERT_STREQ(inner.c_str(), result["changed"][1]["uid"].GetString());
+
+    // The frame and its child leave the visual context; the parent's list of children changes
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "opacity"}, {"value", 0}}, true);
+    root->clearPending();
+    serializeVisualContext();
+    result = delta.update(visualContext, vcDoc.GetAllocator());
+    ASSERT_EQ(2, result["removed"].Size());
+    ASSERT_STREQ(inner.c_str(), result["removed"][1].GetString());
+    ASSERT_EQ(1, result["changed"].Size());
+    ASSERT_STREQ(component->getUniqueId().c_str(), result["changed"][0]["uid"].GetString());
+
+    // Reset reports everything again
+    delta.reset();
+    ASSERT_EQ(0, delta.size());
+    result = delta.update(visualContext, vcDoc.GetAllocator());
+    ASSERT_EQ(delta.size(), result["changed"].Size());
+}
+
+/**
+ * 1000 tagged items: 998 in a static grid and two in a short Sequence.  Each frame scrolls the
+ * Sequence so that one item scrolls into view and the other out of view.  Report the time to
+ * serialize the visual context with and without the cache, and the time to also compute the delta.
+ */
+TEST_F(VisualContextTest, CachedBenchmark)
+{
+    const int ITEMS = 1000;
+    const int FRAMES = 20;
+
+    auto doc = std::string(R"({
+      "type": "APL",
+      "version": "2023.2",
+      "mainTemplate": {
+        "item": {
+          "type": "Container",
+          "width": "100%",
+          "height": "100%",
+          "items": [
+            {
+              "type": "Container",
+              "direction": "row",
+              "wrap": "wrap",
+              "height": 600,
+              "data": "${Array.range(GRID)}",
+              "items": {
+                "type": "TouchWrapper",
+                "width": 20,
+                "height": 20,
+                "item": { "type": "Frame", "width": "100%", "height": "100%" }
+              }
+            },
+            {
+              "type": "Sequence",
+              "id": "SEQ",
+              "height": 100,
+              "data": [ 0, 1 ],
+              "items": {
+                "type": "TouchWrapper",
+                "height": 100,
+                "item": { "type": "Text", "text": "Item ${data}" }
+              }
+            }
+          ]
+        }
+      }
+    })");
+    doc.replace(doc.find("GRID"), 4, std::to_string(ITEMS - 2));
+    metrics.size(1280, 800);
+
+    std::string results[3];
+    for (int mode = 0; mode < 3; mode++) {
+        if (mode == 1)
+            config->enableExperimentalFeature(RootConfig::kExperimentalFeatureVisualContextCache);
+        loadDocument(doc.c_str());
+        ASSERT_TRUE(component);
+
+        VisualContextDelta delta;
+        delta.update(visualContext, vcDoc.GetAllocator());
+
+        auto seq = root->findComponentById("SEQ");
+        size_t changed = 0;
+        std::chrono::steady_clock::duration elapsed{};
+        for (int frame = 0; frame < FRAMES; frame++) {
+            seq->update(kUpdateScrollPosition, frame % 2 ? 0 : 100);
+            root->clearPending();
+            ASSERT_TRUE(root->isVisualContextDirty());
+
+            auto begin = std::chrono::steady_clock::now();
+            rapidjson::Document output;
+            auto context = root->serializeVisualContext(output.GetAllocator());
+            if (mode == 2)
+                changed += delta.update(context, output.GetAllocator())["changed"].Size();
+            elapsed += std::chrono::steady_clock::now() - begin;
+
+            if (frame == FRAMES - 1)
+                results[mode] = toString(context);
+        }
+
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / FRAMES;
+        static const char *MODES[] = {"full", "cached", "cached+delta"};
+        std::cout << "[ BENCHMARK] " << ITEMS << " tagged items, " << MODES[mode] << ": " << us << "us/frame";
+        if (mode == 2)
+            std::cout << ", " << changed / FRAMES << " changed entries/frame";
+        std::cout << std::endl;
+    }
+
+    ASSERT_EQ(results[0], results[1]);
+    ASSERT_EQ(results[0], results[2]);
+}
@@ -0,0 +1,212 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "../testeventloop.h"
+
+#include "apl/content/contentstream.h"
+
+#include "testpackagemanager.h"
+#include "packagegenerator.h"
+
+using namespace apl;
+
+class ContentStreamTest : public DocumentWrapper {
+public:
+    ContentStreamPtr makeStream() {
+        testPackageManager = std::make_shared<TestPackageManager>();
+        config->packageManager(testPackageManager);
+        return ContentStream::create(session, metrics, *config);
+    }
+
+    /**
+     * Feed the document to the stream in small chunks, stopping at the first occurrence of marker.
+     * @return The offset of the first byte that was not appended.
+     */
+    static size_t feedUntil(const ContentStreamPtr& stream, const std::string& doc, const std::string& marker,
+                            size_t from = 0, size_t chunkSize = 7) {
+        auto end = marker.empty() ? doc.size() : doc.find(marker, from);
+        for (auto offset = from; offset < end; offset += chunkSize)
+            stream->append(doc.data() + offset, std::min(chunkSize, end - offset));
+        return end;
+    }
+
+    std::shared_ptr<TestPackageManager> testPackageManager;
+};
+
+static const char *STREAMED_DOCUMENT = R"apl({
+    "type": "APL",
+    "version": "2023.2",
+    "description": "Tricky \"string\" with ], } and { inside",
+    "import": [
+        { "name": "A", "version": "1.0" },
+        { "name": "B", "version": "1.0", "source": "b.json" }
+    ],
+    "layouts": {
+        "Tricky": {
+            "item": { "type": "Text", "text": "import" }
+        }
+    },
+    "mainTemplate": {
+        "item": {
+            "type": "Text",
+            "text": "@A"
+        }
+    }
+})apl";
+
+TEST_F(ContentStreamTest, ImportsRequestedBeforeDocumentFinishes)
+{
+    auto stream = makeStream();
+    std::string doc = STREAMED_DOCUMENT;
+
+    // Nothing is requested until the import array is complete
+    auto offset = feedUntil(stream, doc, "],\n    \"layouts\"");
+    ASSERT_EQ(0, testPackageManager->getUnresolvedRequests().size());
+    offset = feedUntil(stream, doc, "\"layouts\"", offset);
+    ASSERT_EQ(2, testPackageManager->getUnresolvedRequests().size());
+    ASSERT_EQ(2, stream->getEarlyRequestCount());
+    ASSERT_EQ("b.json", testPackageManager->get("B:1.0").source());
+
+    // Package A arrives while the document is still downloading; its own import is requested
+    testPackageManager->succeed(testPackageManager->get("A:1.0"),
+                                SharedJsonData(makeTestPackage({"C"}, {{"A", "Hello"}})));
+    ASSERT_EQ(2, testPackageManager->getUnresolvedRequests().size());
+    ASSERT_TRUE(testPackageManager->get("C:1.0").isValid());
+
+    feedUntil(stream, doc, "", offset);
+    ASSERT_TRUE(stream->isComplete());
+    ASSERT_FALSE(stream->isError());
+
+    content = stream->finish();
+    ASSERT_TRUE(content);
+    ASSERT_FALSE(stream->append("{}"));
+
+    bool successCalled = false;
+    content->load([&]() { successCalled = true; }, []() {});
+    ASSERT_FALSE(successCalled);
+
+    // The content did not send any new requests of its own
+    ASSERT_EQ(2, testPackageManager->getUnresolvedRequests().size());
+    ASSERT_EQ(1, testPackageManager->getResolvedRequestCount());
+
+    testPackageManager->succeed(testPackageManager->get("B:1.0"), SharedJsonData(makeTestPackage({}, {})));
+    ASSERT_FALSE(successCalled);
+    testPackageManager->succeed(testPackageManager->get("C:1.0"), SharedJsonData(makeTestPackage({}, {})));
+    ASSERT_TRUE(successCalled);
+    ASSERT_TRUE(content->isReady());
+    ASSERT_EQ(3, testPackageManager->getResolvedRequestCount());
+
+    auto expected = std::vector<std::string>{"C:1.0", "A:1.0", "B:1.0"};
+    ASSERT_EQ(expected, content->getLoadedPackageNames());
+
+    inflate();
+    ASSERT_TRUE(component);
+    ASSERT_TRUE(IsEqual("Hello", component->getCalculated(kPropertyText).asString()));
+}
+
+TEST_F(ContentStreamTest, PackagesAvailableImmediately)
+{
+    auto stream = makeStream();
+    testPackageManager->putPackage("A:1.0", makeTestPackage({"B"}, {}));
+    testPackageManager->putPackage("B:1.0", makeTestPackage({}, {}));
+
+    ASSERT_TRUE(stream->append(makeTestPackage({"A", "B"}, {})));
+    ASSERT_EQ(2, testPackageManager->getResolvedRequestCount());
+
+    content = stream->finish();
+    ASSERT_TRUE(content);
+
+    bool successCalled = false;
+    content->load([&]() { successCalled = true; }, []() {});
+    ASSERT_TRUE(successCalled);
+    ASSERT_TRUE(content->isReady());
+    ASSERT_EQ(2, testPackageManager->getResolvedRequestCount());
+}
+
+TEST_F(ContentStreamTest, ConditionalImportsWaitForContent)
+{
+    const char *DOC = R"apl({
+        "type": "APL",
+        "version": "2023.2",
+        "import": [
+            { "name": "A", "version": "1.0", "when": "${viewport.theme == 'dark'}" },
+            { "name": "B", "version": "${2 - 1}.0" },
+            { "type": "oneOf", "items": [ { "name": "C", "version": "1.0" } ] }
+        ],
+        "mainTemplate": {
+            "item": { "type": "Text" }
+        }
+    })apl";
+
+    auto stream = makeStream();
+    ASSERT_TRUE(stream->append(DOC));
+    ASSERT_EQ(0, stream->getEarlyRequestCount());
+    ASSERT_EQ(0, testPackageManager->getUnresolvedRequests().size());
+
+    content = stream->finish();
+    ASSERT_TRUE(content);
+    content->load([]() {}, []() {});
+    ASSERT_EQ(3, testPackageManager->getUnresolvedRequests().size());
+    ASSERT_TRUE(testPackageManager->get("A:1.0").isValid());
+    ASSERT_TRUE(testPackageManager->get("B:1.0").isValid());
+    ASSERT_TRUE(testPackageManager->get("C:1.0").isValid());
+}
+
+TEST_F(ContentStreamTest, EarlyFailureReachesContent)
+{
+    auto stream = makeStream();
+    stream->append(makeTestPackage({"A"}, {}));
+    ASSERT_EQ(1, stream->getEarlyRequestCount());
+    testPackageManager->fail(testPackageManager->get("A:1.0"));
+
+    content = stream->finish();
+    ASSERT_TRUE(content);
+
+    bool failureCalled = false;
+    content->load([]() {}, [&]() { failureCalled = true; });
+    ASSERT_TRUE(failureCalled);
+    ASSERT_TRUE(content->isError());
+    ASSERT_TRUE(ConsoleMessage());
+}
+
+TEST_F(ContentStreamTest, Malformed)
+{
+    auto stream = makeStream();
+    ASSERT_FALSE(stream->append("[ 1, 2, 3 ]"));
+    ASSERT_TRUE(stream->isError());
+    ASSERT_FALSE(stream->finish());
+    ASSERT_TRUE(ConsoleMessage());
+
+    // A truncated document is reported when the content is built
+    stream = makeStream();
+    ASSERT_TRUE(stream->append(R"({ "type": "APL", "version": "2023.2", "mainTemplate": )"));
+    ASSERT_FALSE(stream->isComplete());
+    ASSERT_FALSE(stream->finish());
+    ASSERT_TRUE(ConsoleMessage());
+}
+
+TEST_F(ContentStreamTest, NoPackageManager)
+{
+    auto stream = ContentStream::create(session, metrics, *config);
+    ASSERT_TRUE(stream->append(makeTestPackage({"A"}, {})));
+    ASSERT_EQ(0, stream->getEarlyRequestCount());
+
+    content = stream->finish();
+    ASSERT_TRUE(content);
+    ASSERT_TRUE(content->isWaiting());
+    auto requested = content->getRequestedPackages();
+    ASSERT_EQ(1, requested.size());
+    ASSERT_EQ("A", requested.begin()->reference().name());
+}
@@ -0,0 +1,236 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <thread>
+
+#include "../testeventloop.h"
+
+#include "apl/content/packagecache.h"
+
+#include "testpackagemanager.h"
+#include "packagegenerator.h"
+
+using namespace apl;
+
+class PackageCacheTest : public DocumentWrapper {
+public:
+    PackagePtr makePackage(const std::string& name, size_t padding = 0) {
+        auto json = R"({"type": "APL", "version": "1.0", "resources": [{"strings": {"pad": ")" +
+                    std::string(padding, 'x') + R"("}}]})";
+        return Package::create(session, name, JsonData(SharedJsonData(json)));
+    }
+};
+
+TEST_F(PackageCacheTest, FindAndInsert)
+{
+    auto cache = PackageCache::create();
+    auto ref = ImportRef("A", "1.0");
+    auto package = makePackage("A:1.0");
+
+    ASSERT_EQ(nullptr, cache->find(ref));
+    cache->insert(ref, package);
+    ASSERT_EQ(package, cache->find(ref));
+
+    // Source and domain are part of the key
+    ASSERT_EQ(nullptr, cache->find(ImportRef("A", "1.1")));
+    ASSERT_EQ(nullptr, cache->find(ImportRef("A", "1.0", "other.json", "", {}, nullptr, nullptr)));
+    ASSERT_EQ(nullptr, cache->find(ImportRef("A", "1.0", "", "domain", {}, nullptr, nullptr)));
+
+    auto stats = cache->getStats();
+    ASSERT_EQ(1, stats.hits);
+    ASSERT_EQ(4, stats.misses);
+    ASSERT_EQ(1, stats.insertions);
+    ASSERT_EQ(1, stats.count);
+    ASSERT_EQ(PackageCache::estimateSize(*package), stats.bytes);
+    ASSERT_DOUBLE_EQ(0.2, stats.hitRate());
+
+    // Replacing an entry does not double-count it
+    cache->insert(ref, package);
+    ASSERT_EQ(1, cache->getStats().count);
+    ASSERT_EQ(PackageCache::estimateSize(*package), cache->getStats().bytes);
+
+    ASSERT_TRUE(cache->remove(ref));
+    ASSERT_FALSE(cache->remove(ref));
+    ASSERT_EQ(0, cache->getStats().count);
+    ASSERT_EQ(0, cache->getStats().bytes);
+}
+
+TEST_F(PackageCacheTest, EvictLeastRecentlyUsed)
+{
+    auto a = makePackage("A:1.0", 1000);
+    auto b = makePackage("B:1.0", 1000);
+    auto c = makePackage("C:1.0", 1000);
+    auto size = PackageCache::estimateSize(*a);
+
+    // Room for two packages
+    auto cache = PackageCache::create(size * 2 + size / 2);
+    cache->insert(ImportRef("A", "1.0"), a);
+    cache->insert(ImportRef("B", "1.0"), b);
+    ASSERT_EQ(a, cache->find(ImportRef("A", "1.0")));
+
+    // B is now the least recently used
+    cache->insert(ImportRef("C", "1.0"), c);
+    ASSERT_EQ(a, cache->find(ImportRef("A", "1.0")));
+    ASSERT_EQ(nullptr, cache->find(ImportRef("B", "1.0")));
+    ASSERT_EQ(c, cache->find(ImportRef("C", "1.0")));
+
+    auto stats = cache->getStats();
+    ASSERT_EQ(1, stats.evictions);
+    ASSERT_EQ(2, stats.count);
+    ASSERT_LE(stats.bytes, cache->getMaxBytes());
+
+    // Evicted packages stay valid for whoever holds them
+    ASSERT_STREQ("1.0", b->json()["version"].GetString());
+
+    // A package larger than the whole budget is not cached and does not flush the cache
+    cache->insert(ImportRef("D", "1.0"), makePackage("D:1.0", size * 3));
+    ASSERT_EQ(nullptr, cache->find(ImportRef("D", "1.0")));
+    ASSERT_EQ(2, cache->getStats().count);
+
+    cache->clear();
+    ASSERT_EQ(0, cache->getStats().count);
+    ASSERT_EQ(0, cache->getStats().bytes);
+    ASSERT_EQ(1, cache->getStats().evictions);
+}
+
+static const char *SHARED_DOC = R"apl({
+    "type": "APL",
+    "version": "1.0",
+    "import": [
+        { "name": "A", "version": "1.0" }
+    ],
+    "mainTemplate": {
+        "item": {
+            "type": "Text",
+            "text": "${@A} ${@B}"
+        }
+    }
+})apl";
+
+TEST_F(PackageCacheTest, SharedBetweenDocuments)
+{
+    auto cache = PackageCache::create();
+    auto packageManager = std::make_shared<TestPackageManager>();
+    packageManager->putPackage("A:1.0", makeTestPackage({"B"}, {{"A", "a"}}));
+    packageManager->putPackage("B:1.0", makeTestPackage({}, {{"B", "b"}}));
+    config->packageManager(packageManager).packageCache(cache);
+
+    content = Content::create(SHARED_DOC, session, metrics, *config);
+    ASSERT_TRUE(content);
+    content->load([]() {}, []() {});
+    ASSERT_TRUE(content->isReady());
+    ASSERT_EQ(2, packageManager->getResolvedRequestCount());
+    ASSERT_EQ(2, cache->getStats().count);
+    ASSERT_EQ(2, cache->getStats().misses);
+
+    // The second document gets both packages without asking the package manager
+    auto second = Content::create(SHARED_DOC, session, metrics, *config);
+    ASSERT_TRUE(second);
+    second->load([]() {}, []() {});
+    ASSERT_TRUE(second->isReady());
+    ASSERT_EQ(2, packageManager->getResolvedRequestCount());
+    ASSERT_EQ(2, cache->getStats().hits);
+    ASSERT_EQ(content->getPackage("A:1.0"), second->getPackage("A:1.0"));
+    ASSERT_EQ(content->getPackage("B:1.0"), second->getPackage("B:1.0"));
+
+    content = second;
+    inflate();
+    ASSERT_TRUE(component);
+    ASSERT_TRUE(IsEqual("a b", component->getCalculated(kPropertyText).asString()));
+}
+
+TEST_F(PackageCacheTest, FailedPackagesAreNotCached)
+{
+    auto cache = PackageCache::create();
+    auto packageManager = std::make_shared<TestPackageManager>();
+    config->packageManager(packageManager).packageCache(cache);
+
+    content = Content::create(SHARED_DOC, session, metrics, *config);
+    content->load([]() {}, []() {});
+    packageManager->fail(packageManager->get("A:1.0"));
+    ASSERT_TRUE(content->isError());
+    ASSERT_TRUE(ConsoleMessage());
+    ASSERT_EQ(0, cache->getStats().count);
+
+    // A loads but its import B does not parse
+    packageManager->putPackage("A:1.0", makeTestPackage({"B"}, {{"A", "a"}}));
+    packageManager->putPackage("B:1.0", "{ not json");
+    auto second = Content::create(SHARED_DOC, session, metrics, *config);
+    second->load([]() {}, []() {});
+    ASSERT_TRUE(second->isError());
+    ASSERT_TRUE(ConsoleMessage());
+    ASSERT_EQ(1, cache->getStats().count);
+    ASSERT_EQ(0, cache->getStats().hits);
+}
+
+TEST_F(PackageCacheTest, ImportPackageCommandUsesCache)
+{
+    auto cache = PackageCache::create();
+    auto packageManager = std::make_shared<TestPackageManager>();
+    packageManager->putPackage("A:1.0", makeTestPackage({}, {{"A", "a"}}));
+    config->packageManager(packageManager).packageCache(cache);
+
+    cache->insert(ImportRef("B", "2.0"), Package::create(session, "B:2.0",
+                                                         JsonData(SharedJsonData(makeTestPackage({}, {{"B", "b"}})))));
+
+    content = Content::create(SHARED_DOC, session, metrics, *config);
+    content->load([]() {}, []() {});
+    inflate();
+    ASSERT_TRUE(component);
+    rootDocument = root->topDocument();
+    ASSERT_EQ(1, packageManager->getResolvedRequestCount());
+
+    auto commands = JsonData(R"([{"type": "ImportPackage", "name": "B", "version": "2.0"}])");
+    rootDocument->executeCommands(commands.get(), false);
+    root->clearPending();
+    ASSERT_EQ(1, packageManager->getResolvedRequestCount());
+    ASSERT_EQ(1, cache->getStats().hits);
+}
+
+TEST_F(PackageCacheTest, ConcurrentAccess)
+{
+    const int THREADS = 4;
+    const int ROUNDS = 500;
+
+    std::vector<PackagePtr> packages;
+    for (int i = 0; i < 8; i++)
+        packages.emplace_back(makePackage(std::to_string(i), 100));
+
+    // Room for about half of the packages so that eviction runs alongside lookups
+    auto cache = PackageCache::create(PackageCache::estimateSize(*packages[0]) * packages.size() / 2);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < ROUNDS; i++) {
+                auto n = (i * (t + 1)) % packages.size();
+                auto ref = ImportRef(std::to_string(n), "1.0");
+                auto found = cache->find(ref);
+                if (!found)
+                    cache->insert(ref, packages[n]);
+                else if (found != packages[n])
+                    std::terminate();
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    auto stats = cache->getStats();
+    ASSERT_EQ(THREADS * ROUNDS, stats.hits + stats.misses);
+    ASSERT_GE(stats.insertions, stats.count + stats.evictions);
+    ASSERT_LE(stats.bytes, cache->getMaxBytes());
+}
@@ -0,0 +1,221 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include "../testeventloop.h"
+
+#include "apl/content/packedjson.h"
+
+#include "testpackagemanager.h"
+
+using namespace apl;
+
+class PackedJsonTest : public DocumentWrapper {};
+
+static const char *ROUND_TRIP = R"({
+    "null": null,
+    "true": true,
+    "false": false,
+    "int": -42,
+    "uint": 42,
+    "zero": 0,
+    "big": 18446744073709551615,
+    "small": -9223372036854775808,
+    "double": 3.25,
+    "negative": -0.5,
+    "string": "Hello \"world\"\n",
+    "unicode": "é中😀",
+    "empty": "",
+    "array": [1, "two", [3], {"four": 4}, []],
+    "object": {"a": {"b": {"c": "deep"}}, "string": "string"}
+})";
+
+TEST_F(PackedJsonTest, RoundTrip)
+{
+    auto json = SharedJsonData(ROUND_TRIP);
+    ASSERT_TRUE(json);
+
+    auto packed = PackedJson::pack(json.get());
+    ASSERT_TRUE(PackedJson::isPacked(packed.data(), packed.size()));
+    ASSERT_FALSE(PackedJson::isPacked(ROUND_TRIP, strlen(ROUND_TRIP)));
+
+    auto result = PackedJson::unpack(std::move(packed));
+    ASSERT_TRUE(result);
+    ASSERT_EQ(json.get(), result.get());
+
+    ASSERT_TRUE(result.get()["int"].IsInt());
+    ASSERT_TRUE(result.get()["big"].IsUint64());
+    ASSERT_TRUE(result.get()["small"].IsInt64());
+    ASSERT_TRUE(result.get()["double"].IsDouble());
+    ASSERT_EQ(std::string("Hello \"world\"\n"), result.get()["string"].GetString());
+
+    // Scalars and empty containers at the top level
+    for (const auto& m : {"null", "17", "-1.5", "\"text\"", "[]", "{}"}) {
+        auto value = SharedJsonData(m);
+        auto unpacked = PackedJson::unpack(PackedJson::pack(value.get()));
+        ASSERT_TRUE(unpacked) << m;
+        ASSERT_EQ(value.get(), unpacked.get()) << m;
+    }
+}
+
+TEST_F(PackedJsonTest, StringsAreSharedNotCopied)
+{
+    auto json = SharedJsonData(R"({"type": "Text", "items": [{"type": "Text"}, {"type": "Text"}]})");
+    auto packed = PackedJson::pack(json.get());
+
+    // "type" and "Text" are each stored once
+    ASSERT_EQ(packed.find("Text"), packed.rfind("Text"));
+    ASSERT_EQ(packed.find("type"), packed.rfind("type"));
+
+    // The unpacked strings point into the packed bytes, which are kept alive by the document
+    auto bytes = std::make_shared<std::string>(packed);
+    std::weak_ptr<std::string> weakBytes = bytes;
+    auto result = PackedJson::unpack(bytes->data(), bytes->size(), bytes);
+    ASSERT_TRUE(result);
+
+    auto text = result.get()["type"].GetString();
+    ASSERT_GE(text, bytes->data());
+    ASSERT_LT(text, bytes->data() + bytes->size());
+
+    bytes.reset();
+    ASSERT_FALSE(weakBytes.expired());
+    ASSERT_EQ(std::string("Text"), result.get()["items"][1]["type"].GetString());
+
+    result = SharedJsonData(std::string("{}"));
+    ASSERT_TRUE(weakBytes.expired());
+}
+
+TEST_F(PackedJsonTest, Malformed)
+{
+    auto packed = PackedJson::pack(SharedJsonData(ROUND_TRIP).get());
+
+    // Every truncation is rejected
+    for (size_t length = 0; length < packed.size(); length++) {
+        auto result = PackedJson::unpack(packed.data(), length, nullptr);
+        ASSERT_FALSE(result) << length;
+        ASSERT_NE(nullptr, result.error());
+    }
+
+    // Trailing garbage
+    auto extended = packed + "x";
+    ASSERT_FALSE(PackedJson::unpack(extended.data(), extended.size(), nullptr));
+
+    // Unknown version
+    auto version = packed;
+    version[4] = 99;
+    ASSERT_FALSE(PackedJson::unpack(version.data(), version.size(), nullptr));
+
+    // Not packed at all
+    ASSERT_FALSE(PackedJson::unpack(ROUND_TRIP, strlen(ROUND_TRIP), nullptr));
+    ASSERT_STREQ("Not a packed package", PackedJson::unpack(std::string(ROUND_TRIP)).error());
+}
+
+static const char *PACKED_DOC = R"apl({
+    "type": "APL",
+    "version": "2023.2",
+    "import": [
+        { "name": "layouts", "version": "1.0" }
+    ],
+    "mainTemplate": {
+        "item": {
+            "type": "Label",
+            "text": "@greeting"
+        }
+    }
+})apl";
+
+static const char *PACKED_LAYOUTS = R"apl({
+    "type": "APL",
+    "version": "2023.2",
+    "resources": [
+        { "strings": { "greeting": "Hello" } }
+    ],
+    "styles": {
+        "labelStyle": { "values": [ { "color": "blue" } ] }
+    },
+    "layouts": {
+        "Label": {
+            "parameters": [ "text" ],
+            "item": { "type": "Text", "style": "labelStyle", "text": "${text}" }
+        }
+    }
+})apl";
+
+TEST_F(PackedJsonTest, PackageManagerReturnsPackedPackage)
+{
+    auto packageManager = std::make_shared<TestPackageManager>();
+    config->packageManager(packageManager);
+    content = Content::create(PACKED_DOC, session, metrics, *config);
+    ASSERT_TRUE(content);
+    content->load([]() {}, []() {});
+
+    auto request = packageManager->get("layouts:1.0");
+    ASSERT_TRUE(request.isValid());
+    packageManager->succeed(request, PackedJson::unpack(PackedJson::pack(SharedJsonData(PACKED_LAYOUTS).get())));
+    ASSERT_TRUE(content->isReady());
+
+    inflate();
+    ASSERT_TRUE(component);
+    ASSERT_TRUE(IsEqual("Hello", component->getCalculated(kPropertyText).asString()));
+    ASSERT_TRUE(IsEqual(Color(Color::BLUE), component->getCalculated(kPropertyColor)));
+}
+
+/**
+ * Cold-load benchmark for a large layouts package: JSON text parsing against unpacking the
+ * pre-compiled form, both followed by building the Package.
+ */
+TEST_F(PackedJsonTest, ColdLoadBenchmark)
+{
+    const int LAYOUTS = 400;
+    const int ROUNDS = 20;
+
+    std::string json = R"({"type": "APL", "version": "2023.2", "layouts": {)";
+    for (int i = 0; i < LAYOUTS; i++) {
+        auto n = std::to_string(i);
+        if (i)
+            json += ",";
+        json += R"("Layout)" + n + R"(": {"parameters": [{"name": "title", "type": "string", "default": "Title )" + n +
+                R"("}, {"name": "width", "type": "dimension", "default": "100%"}], "item": {"type": "Container",)" +
+                R"( "width": "${width}", "items": [{"type": "Text", "text": "${title}", "fontSize": 24,)" +
+                R"( "color": "${viewport.theme == 'dark' ? 'white' : 'black'}"}, {"type": "Image", "source": )" +
+                R"("https://example.com/image)" + n + R"(.png", "scale": "best-fill", "width": 120, "height": 120},)" +
+                R"( {"type": "TouchWrapper", "onPress": [{"type": "SendEvent", "arguments": ["pressed", )" + n +
+                R"(]}], "item": {"type": "Text", "text": "Press me", "opacity": 0.75}}]}})";
+    }
+    json += "}}";
+
+    auto packed = PackedJson::pack(SharedJsonData(json).get());
+    auto bytes = std::make_shared<std::string>(packed);
+
+    auto time = [&](const std::function<SharedJsonData()>& load) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ROUNDS; i++) {
+            auto package = Package::create(session, "layouts:1.0", JsonData(load()));
+            if (!package || !package->json().HasMember("layouts"))
+                return -1L;
+        }
+        return static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now() - start).count() / ROUNDS);
+    };
+
+    auto jsonTime = time([&]() { return SharedJsonData(json); });
+    auto packedTime = time([&]() { return PackedJson::unpack(bytes->data(), bytes->size(), bytes); });
+    ASSERT_LE(0, jsonTime);
+    ASSERT_LE(0, packedTime);
+
+    std::cout << "[ BENCHMARK] " << LAYOUTS << " layouts: JSON " << json.size() / 1024 << "kB " << jsonTime
+              << "us, packed " << packed.size() / 1024 << "kB " << packedTime << "us" << std::endl;
+}
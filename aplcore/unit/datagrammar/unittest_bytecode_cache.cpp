@@ -0,0 +1,121 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "../testeventloop.h"
+
+#include "apl/datagrammar/bytecodecache.h"
+#include "apl/engine/evaluate.h"
+
+using namespace apl;
+
+class ByteCodeCacheTest : public DocumentWrapper {
+public:
+    ByteCodeCacheTest() {
+        context = Context::createTestContext(Metrics().size(1000, 1000), session);
+    }
+
+    datagrammar::ByteCodeCache& cache() { return *context->byteCodeCache(); }
+
+    ContextPtr context;
+};
+
+TEST_F(ByteCodeCacheTest, RebindGlobals)
+{
+    ASSERT_NE(nullptr, context->byteCodeCache());
+
+    // First parse: "a" is not defined
+    auto c1 = Context::createFromParent(context);
+    auto result = parseAndEvaluate(*c1, "${a + 1}");
+    ASSERT_TRUE(IsEqual("1", result.value));  // null + 1 concatenates
+    ASSERT_TRUE(result.symbols.empty());
+    ASSERT_EQ(0, cache().hits());
+    ASSERT_EQ(1, cache().misses());
+
+    // Mutable symbol
+    auto c2 = Context::createFromParent(context);
+    c2->putUserWriteable("a", 5);
+    result = parseAndEvaluate(*c2, "${a + 1}");
+    ASSERT_TRUE(IsEqual(6, result.value));
+    ASSERT_EQ(1, result.symbols.size());
+    ASSERT_EQ(1, cache().hits());
+
+    ASSERT_TRUE(c2->userUpdateAndRecalculate("a", 10, false));
+    ASSERT_TRUE(IsEqual(11, applyDataBinding(*c2, result.expression, nullptr).value));
+
+    // Constant symbol
+    auto c3 = Context::createFromParent(context);
+    c3->putConstant("a", 100);
+    result = parseAndEvaluate(*c3, "${a + 1}");
+    ASSERT_TRUE(IsEqual(101, result.value));
+    ASSERT_TRUE(result.symbols.empty());
+    ASSERT_EQ(2, cache().hits());
+
+    // And back to undefined
+    auto c4 = Context::createFromParent(context);
+    result = parseAndEvaluate(*c4, "${a + 1}");
+    ASSERT_TRUE(IsEqual("1", result.value));
+    ASSERT_EQ(3, cache().hits());
+    ASSERT_EQ(1, cache().misses());
+}
+
+TEST_F(ByteCodeCacheTest, NotCached)
+{
+    // Plain strings never reach the parser
+    ASSERT_TRUE(IsEqual("hello", evaluate(*context, "hello")));
+    ASSERT_EQ(0, cache().misses());
+
+    // Relative dimensions depend on the viewport
+    ASSERT_TRUE(IsEqual(Dimension(100), evaluate(*context, "${10vw}")));
+    ASSERT_TRUE(IsEqual(Dimension(100), evaluate(*context, "${10vw}")));
+    ASSERT_EQ(0, cache().hits());
+    ASSERT_EQ(2, cache().misses());
+
+    // Syntax errors are reported every time
+    evaluate(*context, "${1+}");
+    ASSERT_TRUE(ConsoleMessage());
+    evaluate(*context, "${1+}");
+    ASSERT_TRUE(ConsoleMessage());
+    ASSERT_EQ(0, cache().hits());
+}
+
+static const char *SEQUENCE = R"apl({
+  "type": "APL",
+  "version": "2023.1",
+  "mainTemplate": {
+    "items": {
+      "type": "Sequence",
+      "height": 100,
+      "data": "${Array.range(500)}",
+      "items": {
+        "type": "Text",
+        "height": 10,
+        "text": "Item ${data} of ${length}"
+      }
+    }
+  }
+})apl";
+
+TEST_F(ByteCodeCacheTest, SequenceItems)
+{
+    loadDocument(SEQUENCE);
+    ASSERT_TRUE(component);
+    ASSERT_EQ(500, component->getChildCount());
+    ASSERT_EQ("Item 0 of 500", component->getChildAt(0)->getCalculated(kPropertyText).asString());
+    ASSERT_EQ("Item 499 of 500", component->getChildAt(499)->getCalculated(kPropertyText).asString());
+
+    auto& documentCache = *component->getContext()->byteCodeCache();
+    ASSERT_GE(documentCache.hits(), 499);
+    ASSERT_LT(documentCache.misses(), 10);
+}
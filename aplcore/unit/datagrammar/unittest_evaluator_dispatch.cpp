@@ -0,0 +1,140 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include "../testeventloop.h"
+
+#include "apl/datagrammar/bytecode.h"
+#include "apl/datagrammar/bytecodeassembler.h"
+#include "apl/datagrammar/bytecodeevaluator.h"
+
+using namespace apl;
+using namespace apl::datagrammar;
+
+class EvaluatorDispatchTest : public ::testing::Test {
+public:
+    EvaluatorDispatchTest() {
+        context = Context::createTestContext(Metrics().size(1024, 800), makeDefaultSession());
+        context->putUserWriteable("a", 10);
+        context->putUserWriteable("b", 2.5);
+        context->putUserWriteable("name", "Fred");
+        context->putUserWriteable("width", Dimension(200));
+        context->putUserWriteable("list", ObjectArray{1, 2, 3, 4});
+        context->putUserWriteable("map", std::make_shared<ObjectMap>(ObjectMap{{"x", 1}, {"y", "two"}}));
+    }
+
+    Object run(const ByteCode& byteCode, ByteCodeEvaluator::DispatchMode mode, BoundSymbolSet *symbols) {
+        ByteCodeEvaluator evaluator(byteCode, symbols, 0, mode);
+        evaluator.advance();
+        return evaluator.isDone() ? evaluator.getResult() : Object::NULL_OBJECT();
+    }
+
+    ContextPtr context;
+};
+
+static const std::vector<std::string> EXPRESSIONS = {
+    "${a * 0.5 - 2 * b}",
+    "${(a + b) / 3 % 2}",
+    "${-a + +b}",
+    "${width * 0.5 - 2}",
+    "${a < b || a >= 10 && !false}",
+    "${a == 10 ? 'ten' : 'other'}",
+    "${undefinedValue ?? a}",
+    "${name + ' has ' + list.length + ' items'}",
+    "${Math.min(a, b, 7) + Math.max(list[1], list[3])}",
+    "${map.x + map['y']}",
+    "${[a, b, name][2]}",
+    "${{'k': a, 'm': b}.m}",
+    "Hello ${name}, ${a}x${b} is ${a * b}",
+    "${a / 0}",
+};
+
+TEST_F(EvaluatorDispatchTest, SameResults)
+{
+    for (const auto& m : EXPRESSIONS) {
+        auto parsed = ByteCodeAssembler::parse(*context, m);
+        ASSERT_TRUE(parsed.is<ByteCode>()) << m;
+
+        // Check both the raw and optimized byte code
+        for (int pass = 0 ; pass < 2 ; pass++) {
+            auto byteCode = parsed.get<ByteCode>();
+            if (pass == 1)
+                byteCode->optimize();
+
+            BoundSymbolSet switchSymbols, threadedSymbols;
+            auto expected = run(*byteCode, ByteCodeEvaluator::kDispatchSwitch, &switchSymbols);
+            auto actual = run(*byteCode, ByteCodeEvaluator::kDispatchThreaded, &threadedSymbols);
+            ASSERT_TRUE(IsEqual(expected, actual)) << m << " pass=" << pass;
+            ASSERT_EQ(switchSymbols, threadedSymbols) << m;
+            ASSERT_TRUE(IsEqual(expected, byteCode->eval())) << m;
+        }
+    }
+}
+
+struct StackDepthCase {
+    std::string expression;
+    size_t depth;
+};
+
+static const std::vector<StackDepthCase> STACK_DEPTH_CASES = {
+    {"${a}", 1},
+    {"${a + b}", 2},
+    {"${a + b * 2}", 3},
+    {"${a * b + 2}", 2},
+    {"${Math.min(a, b, 7)}", 4},
+    {"${a ? b : 1 + 2}", 2},
+    {"${a && b || a}", 1},
+    {"${name} ${a}", 3},
+};
+
+TEST_F(EvaluatorDispatchTest, MaxStackDepth)
+{
+    for (const auto& m : STACK_DEPTH_CASES) {
+        auto parsed = ByteCodeAssembler::parse(*context, m.expression);
+        ASSERT_TRUE(parsed.is<ByteCode>()) << m.expression;
+        ASSERT_EQ(m.depth, parsed.get<ByteCode>()->maxStackDepth()) << m.expression;
+    }
+}
+
+/**
+ * Micro-benchmark: evaluate a set of expressions with each dispatch mode.
+ */
+TEST_F(EvaluatorDispatchTest, Benchmark)
+{
+    const int ITERATIONS = 2000;
+
+    std::vector<std::shared_ptr<ByteCode>> programs;
+    for (const auto& m : EXPRESSIONS) {
+        auto parsed = ByteCodeAssembler::parse(*context, m);
+        ASSERT_TRUE(parsed.is<ByteCode>());
+        programs.emplace_back(parsed.get<ByteCode>());
+    }
+
+    auto timeMode = [&](ByteCodeEvaluator::DispatchMode mode) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0 ; i < ITERATIONS ; i++)
+            for (const auto& program : programs)
+                run(*program, mode, nullptr);
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(stop - start).count() / (ITERATIONS * programs.size());
+    };
+
+    auto switchTime = timeMode(ByteCodeEvaluator::kDispatchSwitch);
+    auto threadedTime = timeMode(ByteCodeEvaluator::kDispatchThreaded);
+
+    std::cout << "[ BENCHMARK] ByteCodeEvaluator switch: " << switchTime << " us/eval, threaded: "
+              << threadedTime << " us/eval" << std::endl;
+}
@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <chrono>
+
 #include "../testeventloop.h"
 #include "apl/datagrammar/bytecode.h"
 #include "apl/primitives/boundsymbolset.h"
@@ -188,4 +190,96 @@ TEST_F(OptimizeTest, ShrinkCode)
     auto optimized_length = bc->instructionCount();
 
     ASSERT_TRUE( optimized_length < unoptimized_length );
-}
\ No newline at end of file
+}
+TEST_F(OptimizeTest, NumericSpecialization)
+{
+    context->putUserWriteable("margin", 8);
+    auto width = evaluate(*context, "${viewport.width}").asNumber();
+
+    auto result = parseAndEvaluate(*context, "${viewport.width * 0.5 - 2 * margin}", true);
+    ASSERT_TRUE(IsEqual(width * 0.5 - 16, result.value));
+    ASSERT_EQ(1, result.symbols.size());
+    ASSERT_TRUE(result.expression.is<datagrammar::ByteCode>());
+
+    // The arithmetic collapses into a single specialized instruction
+    auto bc = result.expression.get<datagrammar::ByteCode>();
+    ASSERT_EQ(1, bc->instructionCount());
+    ASSERT_NE(std::string::npos, bc->instructionAsString(0).find("NUMERIC_EXPRESSION"));
+
+    context->userUpdateAndRecalculate("margin", 10, false);
+    ASSERT_TRUE(IsEqual(width * 0.5 - 20, result.expression.eval()));
+}
+
+TEST_F(OptimizeTest, NumericSpecializationPartial)
+{
+    context->putUserWriteable("a", 3);
+    context->putUserWriteable("b", 4);
+    context->putUserWriteable("c", ObjectArray{1, 2, 3});
+
+    // Sub-expressions around non-numeric operations and jumps are specialized independently
+    static std::vector<std::pair<std::string, Object>> TESTS = {
+        {"${c[a - 2] + a * b}", 14},
+        {"${Math.max(a * b, -a, b % a)}", 12},
+        {"${a > 2 ? a * b : b - a}", 12},
+        {"${a < 2 ? a * b : b - a}", 1},
+        {"Value ${a * 2 + b / 2}", "Value 8"},
+        {"${(a + b) * (a - b) * (a * b) + a + a + a}", -75},
+    };
+
+    for (const auto& m : TESTS) {
+        auto unoptimized = parseAndEvaluate(*context, m.first, false);
+        auto result = parseAndEvaluate(*context, m.first, true);
+        ASSERT_TRUE(IsEqual(m.second, unoptimized.value)) << m.first;
+        ASSERT_TRUE(IsEqual(m.second, result.value)) << m.first;
+        ASSERT_EQ(unoptimized.symbols, result.symbols) << m.first;
+    }
+}
+
+TEST_F(OptimizeTest, NumericSpecializationTypeGuard)
+{
+    context->putUserWriteable("a", 10);
+    context->putUserWriteable("b", 2);
+
+    auto result = parseAndEvaluate(*context, "${a * 2 - b}", true);
+    ASSERT_TRUE(IsEqual(18, result.value));
+    auto bc = result.expression.get<datagrammar::ByteCode>();
+    ASSERT_EQ(1, bc->instructionCount());
+
+    // Once a symbol stops being a number the generic arithmetic rules apply
+    context->userUpdateAndRecalculate("a", Dimension(DimensionType::Relative, 10), false);
+    ASSERT_TRUE(IsEqual(Dimension(DimensionType::Relative, 18), result.expression.eval()));
+
+    context->userUpdateAndRecalculate("a", "fish", false);
+    ASSERT_TRUE(result.expression.eval().isNaN());
+
+    context->userUpdateAndRecalculate("a", 1, false);
+    ASSERT_TRUE(IsEqual(0, result.expression.eval()));
+}
+
+/**
+ * Micro-benchmark: repeated evaluation of a numeric expression with and without specialization.
+ */
+TEST_F(OptimizeTest, NumericSpecializationBenchmark)
+{
+    const int ITERATIONS = 20000;
+    context->putUserWriteable("width", 1024);
+    context->putUserWriteable("margin", 8);
+
+    auto generic = parseAndEvaluate(*context, "${width * 0.5 - 2 * margin + width / 3}", false);
+    auto specialized = parseAndEvaluate(*context, "${width * 0.5 - 2 * margin + width / 3}", true);
+    ASSERT_TRUE(IsEqual(generic.value, specialized.value));
+
+    auto time = [&](const Object& expression) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0 ; i < ITERATIONS ; i++)
+            expression.eval();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(stop - start).count() / ITERATIONS;
+    };
+
+    auto genericTime = time(generic.expression);
+    auto specializedTime = time(specialized.expression);
+
+    std::cout << "[ BENCHMARK] Numeric expression generic: " << genericTime << " us/eval, specialized: "
+              << specializedTime << " us/eval" << std::endl;
+}
@@ -121,10 +121,10 @@ dumpHierarchy(const ComponentPtr& component, std::initializer_list<std::string>
 void
 dumpContext(const ContextPtr& context, int indent)
 {
-    for (auto it = context->begin(); it != context->end(); it++) {
-        int upstream = context->countUpstream(it->first);
-        int downstream = context->countDownstream(it->first);
-        auto result = it->first + " := " + it->second.toDebugString();
+    for (const auto& m : *context) {
+        int upstream = context->countUpstream(m.first);
+        int downstream = context->countDownstream(m.first);
+        auto result = m.first + " := " + m.second.toDebugString();
         if (upstream)
             result += "[" + std::to_string(upstream) + " upstream]";
         if (downstream)
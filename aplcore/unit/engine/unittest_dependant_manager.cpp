@@ -0,0 +1,180 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include "../testeventloop.h"
+
+#include "apl/engine/dependantmanager.h"
+#include "apl/engine/typeddependant.h"
+
+using namespace apl;
+
+class DependantManagerTest : public MemoryWrapper {
+protected:
+    void SetUp() override {
+        MemoryWrapper::SetUp();
+        c = Context::createTestContext(Metrics().size(1024, 800), RootConfig());
+    }
+
+    void TearDown() override {
+        c = nullptr;
+        MemoryWrapper::TearDown();
+    }
+
+    ContextPtr c;
+};
+
+/**
+ * A dependant that records when it has been recalculated
+ */
+class RecordingDependant : public Dependant {
+public:
+    RecordingDependant(const ContextPtr& context, std::vector<size_t>& log)
+        : Dependant(Object::NULL_OBJECT(), context, sBindingFunctions.at(kBindingTypeAny), BoundSymbolSet()),
+          mLog(log)
+    {}
+
+    void recalculate(bool useDirtyFlag) override { mLog.push_back(mOrder); }
+
+    size_t order() const { return mOrder; }
+
+private:
+    std::vector<size_t>& mLog;
+};
+
+TEST_F(DependantManagerTest, TopologicalOrder)
+{
+    std::vector<size_t> log;
+    std::vector<std::shared_ptr<RecordingDependant>> dependants;
+    for (int i = 0 ; i < 20 ; i++)
+        dependants.emplace_back(std::make_shared<RecordingDependant>(c, log));
+
+    // Enqueue in a scrambled order
+    auto& manager = c->dependantManager();
+    for (int i = 0 ; i < 20 ; i++)
+        manager.enqueueDependency(dependants.at((i * 7) % 20));
+    ASSERT_EQ(20, manager.pending());
+
+    manager.processDependencies(false);
+    ASSERT_EQ(0, manager.pending());
+    ASSERT_EQ(20, log.size());
+    for (int i = 0 ; i < 20 ; i++)
+        ASSERT_EQ(dependants.at(i)->order(), log.at(i));
+}
+
+TEST_F(DependantManagerTest, Deduplicate)
+{
+    std::vector<size_t> log;
+    auto a = std::make_shared<RecordingDependant>(c, log);
+    auto b = std::make_shared<RecordingDependant>(c, log);
+
+    auto& manager = c->dependantManager();
+    manager.enqueueDependency(b);
+    manager.enqueueDependency(a);
+    manager.enqueueDependency(b);
+    manager.enqueueDependency(a);
+    ASSERT_EQ(2, manager.pending());
+
+    manager.processDependencies(false);
+    ASSERT_EQ(std::vector<size_t>({a->order(), b->order()}), log);
+
+    // Once processed, a dependant may be queued again
+    log.clear();
+    manager.enqueueDependency(a);
+    manager.processDependencies(false);
+    ASSERT_EQ(std::vector<size_t>({a->order()}), log);
+}
+
+static const char *COALESCE = R"apl({
+  "type": "APL",
+  "version": "2023.1",
+  "mainTemplate": {
+    "items": {
+      "type": "Text",
+      "text": "${ArrayA.length + ArrayB.length}"
+    }
+  }
+})apl";
+
+class DependantManagerDocTest : public DocumentWrapper {};
+
+TEST_F(DependantManagerDocTest, CoalesceLiveDataFlush)
+{
+    auto arrayA = LiveArray::create(ObjectArray{1, 2});
+    auto arrayB = LiveArray::create(ObjectArray{3});
+    config->liveData("ArrayA", arrayA);
+    config->liveData("ArrayB", arrayB);
+
+    loadDocument(COALESCE);
+    ASSERT_TRUE(component);
+    ASSERT_EQ("3", component->getCalculated(kPropertyText).asString());
+
+    // Both arrays change in the same frame; the text is recalculated once with both changes applied
+    arrayA->push_back(4);
+    arrayB->push_back(5);
+    root->clearPending();
+
+    ASSERT_EQ("5", component->getCalculated(kPropertyText).asString());
+    ASSERT_TRUE(CheckDirty(component, kPropertyText, kPropertyVisualHash));
+}
+
+/**
+ * Micro-benchmark: a single bound value fanned out to many downstream contexts.
+ */
+static double
+timeFanOut(const ContextPtr& root, int count, int iterations)
+{
+    root->putUserWriteable("source", 0);
+
+    std::vector<ContextPtr> children;
+    children.reserve(count);
+    for (int i = 0 ; i < count ; i++) {
+        auto child = Context::createFromParent(root);
+        auto result = parseAndEvaluate(*child, "${source + 1}");
+        child->putUserWriteable("value", result.value);
+        ContextDependant::create(child, "value", std::move(result.expression), child,
+                                 sBindingFunctions.at(kBindingTypeAny), std::move(result.symbols));
+        children.emplace_back(std::move(child));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 1 ; i <= iterations ; i++)
+        root->userUpdateAndRecalculate("source", i, false);
+    auto stop = std::chrono::steady_clock::now();
+
+    for (const auto& child : children)
+        if (child->opt("value").asInt() != iterations + 1)
+            return -1;
+
+    return std::chrono::duration<double, std::micro>(stop - start).count() / iterations;
+}
+
+TEST_F(DependantManagerTest, FanOutBenchmark)
+{
+    const std::vector<std::pair<int, int>> CASES = {
+        {10, 1000},
+        {1000, 20},
+        {100000, 2},
+    };
+
+    for (const auto& m : CASES) {
+        auto root = Context::createFromParent(c);
+        auto usPerUpdate = timeFanOut(root, m.first, m.second);
+        ASSERT_GE(usPerUpdate, 0) << "fan-out " << m.first;
+        std::cout << "[ BENCHMARK] DependantManager fan-out " << m.first << ": "
+                  << usPerUpdate << " us/update" << std::endl;
+    }
+}
@@ -0,0 +1,205 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include "../testeventloop.h"
+
+#include "apl/engine/dirtypropertybuffer.h"
+
+using namespace apl;
+
+class DirtyPropertyBufferTest : public DocumentWrapper {};
+
+static const char *BASIC = R"apl({
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Container",
+      "items": [
+        {
+          "type": "Frame",
+          "id": "FRAME",
+          "width": 100,
+          "height": 100,
+          "backgroundColor": "red"
+        },
+        {
+          "type": "Text",
+          "id": "TEXT",
+          "text": "Hello"
+        }
+      ]
+    }
+  }
+})apl";
+
+TEST_F(DirtyPropertyBufferTest, Basic)
+{
+    loadDocument(BASIC);
+
+    DirtyPropertyBuffer buffer;
+    root->getDirtyProperties(buffer);
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_EQ(0, buffer.componentCount());
+
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "backgroundColor"}, {"value", "blue"}}, true);
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "opacity"}, {"value", 0.5}}, true);
+    executeCommand("SetValue", {{"componentId", "TEXT"}, {"property", "text"}, {"value", "Goodbye"}}, true);
+
+    root->getDirtyProperties(buffer);
+    ASSERT_EQ(root->getDirty().size(), buffer.componentCount());
+
+    // The records match the dirty properties of each component, grouped by component
+    size_t index = 0;
+    for (const auto& component : root->getDirty()) {
+        for (auto key : component->getDirty()) {
+            const auto& record = buffer.at(index++);
+            ASSERT_EQ(component.get(), record.component);
+            ASSERT_EQ(key, record.key);
+            ASSERT_EQ(&component->getCalculated(key), &record.value());
+        }
+    }
+    ASSERT_EQ(index, buffer.size());
+
+    auto frame = root->findComponentById("FRAME");
+    auto found = 0;
+    for (const auto& record : buffer) {
+        if (record.component == frame.get() && record.key == kPropertyBackgroundColor) {
+            ASSERT_EQ(Color(Color::BLUE), record.value().asColor());
+            found++;
+        }
+        if (record.component == frame.get() && record.key == kPropertyOpacity) {
+            ASSERT_EQ(0.5, record.value().asNumber());
+            found++;
+        }
+    }
+    ASSERT_EQ(2, found);
+
+    // Filling the buffer again replaces the previous records
+    root->clearDirty();
+    root->getDirtyProperties(buffer);
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_EQ(0, buffer.componentCount());
+}
+
+static const char *ANIMATED = R"apl({
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Container",
+      "width": 1000,
+      "height": 1000,
+      "direction": "row",
+      "wrap": "wrap",
+      "data": "${Array.range(COUNT)}",
+      "items": {
+        "type": "Frame",
+        "width": 40,
+        "height": 40,
+        "backgroundColor": "green",
+        "onMount": {
+          "type": "AnimateItem",
+          "duration": 1000,
+          "repeatCount": 100,
+          "value": [
+            { "property": "opacity", "from": 0.2, "to": 1 },
+            { "property": "transform", "from": [ { "rotate": 0 } ], "to": [ { "rotate": 90 } ] }
+          ]
+        }
+      }
+    }
+  }
+})apl";
+
+/**
+ * Animate 500 components and compare the cost of exporting the dirty properties of each frame
+ * through serializeDirty and through a reused DirtyPropertyBuffer.
+ */
+TEST_F(DirtyPropertyBufferTest, AnimationBenchmark)
+{
+    const int COUNT = 500;
+    const int FRAMES = 100;
+
+    auto doc = std::string(ANIMATED);
+    doc.replace(doc.find("COUNT"), 5, std::to_string(COUNT));
+
+    for (auto buffered : {false, true}) {
+        if (buffered) {
+            // Releasing the first document terminates its time manager
+            component = nullptr;
+            context = nullptr;
+            rootDocument = nullptr;
+            root = nullptr;
+            loop = std::make_shared<TestTimeManager>();
+            config->timeManager(loop);
+        }
+        loadDocument(doc.c_str());
+        ASSERT_TRUE(component);
+
+        DirtyPropertyBuffer buffer;
+        size_t records = 0;
+        size_t allocated = 0;
+        size_t capacity = 0;
+        double sum = 0;
+        std::chrono::steady_clock::duration elapsed{};
+        for (int frame = 0; frame < FRAMES; frame++) {
+            advanceTime(16);
+            ASSERT_TRUE(root->isDirty());
+
+            auto begin = std::chrono::steady_clock::now();
+            if (buffered) {
+                root->getDirtyProperties(buffer);
+                for (const auto& record : buffer) {
+                    // Read each value as a view host would
+                    if (record.value().isNumber())
+                        sum += record.value().asNumber();
+                    records++;
+                }
+            } else {
+                rapidjson::Document output;
+                for (const auto& component : root->getDirty()) {
+                    records += component->getDirty().size();
+                    component->serializeDirty(output.GetAllocator());
+                }
+                allocated += output.GetAllocator().Size();
+            }
+            elapsed += std::chrono::steady_clock::now() - begin;
+            root->clearDirty();
+
+            // The buffer reaches its steady state size on the first frame
+            if (buffered && frame == 0)
+                capacity = buffer.capacity();
+        }
+
+        ASSERT_LE(COUNT * 2, records / FRAMES);
+        if (buffered) {
+            ASSERT_LT(0, sum);
+            ASSERT_EQ(capacity, buffer.capacity());
+        }
+
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / FRAMES;
+        std::cout << "[ BENCHMARK] " << COUNT << " animated components, "
+                  << (buffered ? "DirtyPropertyBuffer" : "serializeDirty") << ": " << us << "us/frame, "
+                  << records / FRAMES << " properties/frame";
+        if (buffered)
+            std::cout << ", buffer capacity " << capacity << " records";
+        else
+            std::cout << ", " << allocated / FRAMES << " bytes allocated/frame";
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,245 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include "../testeventloop.h"
+
+#include "apl/engine/layoutmanager.h"
+
+using namespace apl;
+
+class LayoutManagerTest : public DocumentWrapper {
+public:
+    const LayoutManager::LayoutStats& stats() const {
+        return component->getContext()->layoutManager().getLastLayoutStats();
+    }
+
+    /**
+     * Load a document and run one more layout pass.  The first layout pass after inflation also
+     * attaches the cached pages of a Sequence, which would otherwise be counted against the change
+     * under test.
+     */
+    void loadAndSettle(const char *document) {
+        loadDocument(document);
+        ASSERT_TRUE(component);
+        CoreComponent::cast(root->findComponentById("label0"))->setProperty(kPropertyText, "Item -");
+        root->clearPending();
+    }
+
+    static size_t countAttached(const ComponentPtr& comp) {
+        size_t count = 1;
+        for (size_t i = 0; i < comp->getChildCount(); i++) {
+            auto child = CoreComponent::cast(comp->getChildAt(i));
+            if (child->isAttached())
+                count += countAttached(child);
+        }
+        return count;
+    }
+};
+
+static const char *SEQUENCE_1000 = R"apl(
+{
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "items": {
+      "type": "Sequence",
+      "width": "100%",
+      "height": "100%",
+      "data": "${Array.range(1000)}",
+      "items": {
+        "type": "Frame",
+        "width": 200,
+        "borderWidth": 1,
+        "item": {
+          "type": "Container",
+          "width": "100%",
+          "items": [
+            {
+              "type": "Text",
+              "id": "label${data}",
+              "text": "Item ${data}"
+            },
+            {
+              "type": "Frame",
+              "width": 20,
+              "height": 20
+            }
+          ]
+        }
+      }
+    }
+  }
+}
+)apl";
+
+TEST_F(LayoutManagerTest, IncrementalLayout)
+{
+    loadAndSettle(SEQUENCE_1000);
+    ASSERT_EQ(1000, component->getChildCount());
+
+    auto attached = countAttached(component);
+    ASSERT_GT(attached, 8);
+
+    auto label = CoreComponent::cast(root->findComponentById("label3"));
+    ASSERT_TRUE(label);
+    ASSERT_EQ(Rect(0, 0, 198, 10), label->getCalculated(kPropertyBounds).get<Rect>());
+    auto next = component->getChildAt(4);
+    auto nextBounds = next->getCalculated(kPropertyBounds).get<Rect>();
+
+    // Wrap the text onto a second line.  Only the modified item subtree is walked.
+    label->setProperty(kPropertyText, "This item has a much longer label");
+    root->clearPending();
+
+    auto growth = label->getCalculated(kPropertyBounds).get<Rect>().getHeight() - 10;
+    ASSERT_GT(growth, 0);
+    ASSERT_EQ(nextBounds.getY() + growth, next->getCalculated(kPropertyBounds).get<Rect>().getY());
+
+    ASSERT_EQ(1, stats().topNodes);
+    ASSERT_EQ(1, stats().calculated);
+    ASSERT_LT(stats().visited, attached);
+    ASSERT_GE(stats().relaid, 4);  // Text, Container, Frame and at least the following item
+}
+
+TEST_F(LayoutManagerTest, UnchangedSizeIsNotRelaid)
+{
+    loadAndSettle(SEQUENCE_1000);
+
+    // Same length text: the Text is re-measured but no bounds change
+    auto label = CoreComponent::cast(root->findComponentById("label5"));
+    label->setProperty(kPropertyText, "Item X");
+    root->clearPending();
+
+    ASSERT_EQ(1, stats().calculated);
+    ASSERT_EQ(0, stats().relaid);
+    ASSERT_LT(stats().visited, countAttached(component));
+}
+
+/**
+ * Benchmark: a 1000-item Sequence where the text of one item changes each frame.  Reports the
+ * number of components visited and relaid per frame against the number of attached components.
+ */
+TEST_F(LayoutManagerTest, SequenceTextChangeBenchmark)
+{
+    const int FRAMES = 200;
+
+    loadAndSettle(SEQUENCE_1000);
+    auto attached = countAttached(component);
+
+    std::vector<CoreComponentPtr> labels;
+    for (int i = 0; i < 10; i++)
+        labels.emplace_back(CoreComponent::cast(root->findComponentById("label" + std::to_string(i))));
+
+    size_t visited = 0;
+    size_t relaid = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        auto& label = labels.at(frame % labels.size());
+        label->setProperty(kPropertyText, (frame / labels.size()) % 2 ? "Short" : "A label long enough to wrap");
+        root->clearPending();
+        visited += stats().visited;
+        relaid += stats().relaid;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_LT(visited, FRAMES * attached);
+
+    std::cout << "[ BENCHMARK] frames " << FRAMES << " attached " << attached
+              << " visited/frame " << (double)visited / FRAMES
+              << " relaid/frame " << (double)relaid / FRAMES
+              << " time/frame "
+              << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / FRAMES << "us"
+              << std::endl;
+}
+
+static const char *MANY_TEXTS = R"apl(
+{
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "items": {
+      "type": "Container",
+      "width": "100%",
+      "height": "100%",
+      "data": "${Array.range(200)}",
+      "items": {
+        "type": "Text",
+        "text": "Text item number ${data}"
+      }
+    }
+  }
+}
+)apl";
+
+TEST_F(LayoutManagerTest, TextMeasurePrePass)
+{
+    auto measure = std::make_shared<SlowTestMeasurement>(10, std::chrono::microseconds(0), 4);
+    config->measure(measure);
+    config->enableExperimentalFeature(RootConfig::kExperimentalFeatureTextMeasurePrePass);
+
+    loadDocument(MANY_TEXTS);
+    ASSERT_TRUE(component);
+    ASSERT_EQ(200, component->getChildCount());
+
+    // Every text was measured in the batch; the real layout found them all in the cache
+    ASSERT_EQ(200, stats().batched);
+    ASSERT_EQ(200, measure->getBatchedCount());
+    ASSERT_EQ(measure->getBatchedCount(), measure->getLayoutCount());
+
+    for (int i = 0; i < 200; i++)
+        ASSERT_EQ(Rect(0, 10 * i, metrics.getWidth(), 10),
+                  component->getChildAt(i)->getCalculated(kPropertyBounds).get<Rect>()) << i;
+
+    // Changing one text only batches that text
+    auto text = CoreComponent::cast(component->getChildAt(5));
+    text->setProperty(kPropertyText, "Changed");
+    root->clearPending();
+    ASSERT_EQ(1, stats().batched);
+    ASSERT_EQ(201, measure->getBatchedCount());
+    ASSERT_EQ(measure->getBatchedCount(), measure->getLayoutCount());
+}
+
+/**
+ * Benchmark: first layout of 200 Text components with an artificial measurement cost, measured
+ * synchronously from Yoga and through the batched pre-pass.
+ */
+TEST_F(LayoutManagerTest, TextMeasurePrePassBenchmark)
+{
+    const auto COST = std::chrono::microseconds(200);
+    const unsigned int THREADS = 4;
+
+    auto measure = std::make_shared<SlowTestMeasurement>(10, COST, THREADS);
+    config->measure(measure);
+    auto start = std::chrono::steady_clock::now();
+    loadDocument(MANY_TEXTS);
+    auto synchronous = std::chrono::steady_clock::now() - start;
+    ASSERT_TRUE(component);
+    ASSERT_EQ(0, measure->getBatchedCount());
+
+    measure = std::make_shared<SlowTestMeasurement>(10, COST, THREADS);
+    config->measure(measure);
+    config->enableExperimentalFeature(RootConfig::kExperimentalFeatureTextMeasurePrePass);
+    start = std::chrono::steady_clock::now();
+    loadDocument(MANY_TEXTS);
+    auto batched = std::chrono::steady_clock::now() - start;
+    ASSERT_TRUE(component);
+    ASSERT_EQ(200, measure->getBatchedCount());
+
+    std::cout << "[ BENCHMARK] texts 200 cost " << COST.count() << "us threads " << THREADS
+              << " synchronous " << std::chrono::duration_cast<std::chrono::microseconds>(synchronous).count() << "us"
+              << " pre-pass " << std::chrono::duration_cast<std::chrono::microseconds>(batched).count() << "us"
+              << std::endl;
+}
@@ -0,0 +1,122 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <set>
+
+#include "../testeventloop.h"
+
+#include "apl/engine/propertymap.h"
+
+using namespace apl;
+
+class PropertyMapTest : public DocumentWrapper {};
+
+TEST_F(PropertyMapTest, SortedStorage)
+{
+    CalculatedPropertyMap map;
+    ASSERT_EQ(0, map.size());
+    ASSERT_TRUE(map.get(kPropertyOpacity).isNull());
+    ASSERT_EQ(map.end(), map.find(kPropertyOpacity));
+
+    map.set(kPropertyWidth, 100);
+    map.set(kPropertyOpacity, 0.5);
+    map.set(kPropertyHeight, 200);
+    map.set(kPropertyWidth, 150);  // Overwrite an existing value
+    ASSERT_EQ(3, map.size());
+
+    ASSERT_TRUE(IsEqual(150, map.get(kPropertyWidth)));
+    ASSERT_TRUE(IsEqual(200, map[kPropertyHeight]));
+    ASSERT_TRUE(IsEqual(0.5, map.get("opacity")));
+    ASSERT_TRUE(map.get("unknownProperty").isNull());
+    ASSERT_NE(map.end(), map.find(kPropertyHeight));
+
+    // Iteration is in key order
+    std::vector<PropertyKey> keys;
+    for (const auto& m : map)
+        keys.emplace_back(m.first);
+    std::vector<PropertyKey> expected = {kPropertyWidth, kPropertyOpacity, kPropertyHeight};
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, keys);
+
+    map.clear();
+    ASSERT_EQ(0, map.size());
+    ASSERT_TRUE(map.get(kPropertyWidth).isNull());
+}
+
+static const char *MANY_COMPONENTS = R"apl(
+{
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "items": {
+      "type": "Container",
+      "data": "${Array.range(1999)}",
+      "items": {
+        "type": "Text",
+        "text": "Item ${data}",
+        "opacity": "${data % 2 ? 0.5 : 1}"
+      }
+    }
+  }
+}
+)apl";
+
+/**
+ * Memory report: per-component bytes used to store calculated and assigned properties.  The
+ * "node map" figures are what the same entries cost in the previous std::map / std::set storage
+ * (three pointers and a color word per red-black tree node, before allocator overhead).
+ */
+TEST_F(PropertyMapTest, MemoryReport)
+{
+    loadDocument(MANY_COMPONENTS);
+    ASSERT_TRUE(component);
+    ASSERT_EQ(1999, component->getChildCount());
+
+    const size_t NODE_OVERHEAD = 4 * sizeof(void*);
+    size_t count = 0;
+    size_t flatBytes = 0;
+    size_t mapBytes = 0;
+    size_t assignedBytes = 0;
+
+    std::function<void(const ComponentPtr&)> visit = [&](const ComponentPtr& c) {
+        const auto& calculated = c->getCalculated();
+        count++;
+        flatBytes += sizeof(calculated) + calculated.allocatedBytes();
+        mapBytes += sizeof(std::map<PropertyKey, Object>) +
+                    calculated.size() * (NODE_OVERHEAD + sizeof(std::pair<const PropertyKey, Object>));
+
+        auto core = std::static_pointer_cast<CoreComponent>(c);
+        size_t assigned = 0;
+        for (const auto& m : calculated)
+            if (core->hasProperty(m.first))
+                assigned++;
+        assignedBytes += sizeof(std::set<PropertyKey>) +
+                         assigned * (NODE_OVERHEAD + sizeof(PropertyKey));
+
+        for (size_t i = 0 ; i < c->getChildCount() ; i++)
+            visit(c->getChildAt(i));
+    };
+    visit(component);
+
+    ASSERT_EQ(2000, count);
+    ASSERT_LT(flatBytes, mapBytes);
+
+    std::cout << "[ BENCHMARK] " << count << " components, calculated properties: node map "
+              << mapBytes / count << " bytes/component, flat " << flatBytes / count << " bytes/component"
+              << std::endl;
+    std::cout << "[ BENCHMARK] " << count << " components, assigned properties: node set "
+              << assignedBytes / count << " bytes/component, bitset "
+              << sizeof(AssignedPropertySet) << " bytes/component" << std::endl;
+}
@@ -0,0 +1,138 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include "../testeventloop.h"
+
+#include "apl/engine/symboltable.h"
+#include "apl/primitives/boundsymbol.h"
+
+using namespace apl;
+
+class SymbolTableTest : public DocumentWrapper {};
+
+TEST_F(SymbolTableTest, Interning)
+{
+    SymbolTable table;
+    ASSERT_EQ(0, table.size());
+    ASSERT_TRUE(table.find("a") == SymbolTable::NO_ATOM);
+
+    auto a = table.intern("a");
+    auto b = table.intern("b");
+    ASSERT_NE(a, b);
+    ASSERT_EQ(a, table.intern("a"));
+    ASSERT_EQ(b, table.find("b"));
+    ASSERT_EQ(2, table.size());
+    ASSERT_EQ(std::string("a"), table.name(a));
+    ASSERT_EQ(std::string("b"), table.name(b));
+}
+
+TEST_F(SymbolTableTest, ContextLookup)
+{
+    auto top = Context::createTestContext(Metrics(), *config);
+    top->putConstant("a", 1);
+    auto child = Context::createFromParent(top);
+    child->putUserWriteable("b", 2);
+    auto grandchild = Context::createFromParent(child);
+    grandchild->putUserWriteable("a", 3);
+
+    // Every context in the chain shares the same table
+    ASSERT_EQ(&top->symbols(), &grandchild->symbols());
+
+    auto atomA = top->symbols().find("a");
+    auto atomB = top->symbols().find("b");
+    ASSERT_TRUE(IsEqual(3, grandchild->opt(atomA)));
+    ASSERT_TRUE(IsEqual(1, child->opt(atomA)));
+    ASSERT_TRUE(IsEqual(2, grandchild->opt(atomB)));
+    ASSERT_FALSE(top->has(atomB));
+
+    // Names that were never interned are never found
+    ASSERT_TRUE(grandchild->opt("unknown").isNull());
+    ASSERT_FALSE(grandchild->has("unknown"));
+    ASSERT_FALSE(grandchild->has(SymbolTable::Atom(SymbolTable::NO_ATOM)));
+    ASSERT_TRUE(top->symbols().find("unknown") == SymbolTable::NO_ATOM);
+
+    // Lookups by string agree with lookups by atom
+    ASSERT_TRUE(IsEqual(grandchild->opt("a"), grandchild->opt(atomA)));
+    ASSERT_TRUE(grandchild->hasLocal("a"));
+    ASSERT_FALSE(grandchild->hasLocal("b"));
+
+    ASSERT_TRUE(grandchild->userUpdateAndRecalculate("b", 20, false));
+    ASSERT_TRUE(IsEqual(20, child->opt("b")));
+}
+
+TEST_F(SymbolTableTest, BoundSymbol)
+{
+    auto top = Context::createTestContext(Metrics(), *config);
+    auto child = Context::createFromParent(top);
+
+    // Binding a symbol interns its name, so a value added later is still found by atom
+    BoundSymbol symbol(child, "late");
+    ASSERT_TRUE(symbol.eval().isNull());
+    ASSERT_TRUE(symbol.empty());
+    top->putUserWriteable("late", 42);
+    ASSERT_TRUE(IsEqual(42, symbol.eval()));
+    ASSERT_TRUE(symbol.truthy());
+}
+
+/**
+ * Benchmark: resolve names defined at the top of a deep context chain, from the bottom.
+ */
+TEST_F(SymbolTableTest, LookupBenchmark)
+{
+    const int DEPTH = 20;
+    const int NAMES = 16;
+    const int ITERATIONS = 20000;
+
+    auto top = Context::createTestContext(Metrics(), *config);
+    std::vector<std::string> names;
+    for (int i = 0; i < NAMES; i++) {
+        names.emplace_back("variable" + std::to_string(i));
+        top->putUserWriteable(names.back(), i);
+    }
+
+    auto context = top;
+    for (int i = 0; i < DEPTH; i++) {
+        context = Context::createFromParent(context);
+        context->putUserWriteable("local" + std::to_string(i), i);
+    }
+
+    std::vector<SymbolTable::Atom> atoms;
+    for (const auto& name : names)
+        atoms.emplace_back(context->symbols().find(name));
+
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++)
+        for (const auto& name : names)
+            sum += context->opt(name).getDouble();
+    auto byName = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++)
+        for (const auto& atom : atoms)
+            sum += context->opt(atom).getDouble();
+    auto byAtom = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(2.0 * ITERATIONS * (NAMES * (NAMES - 1) / 2), sum);
+
+    auto lookups = ITERATIONS * NAMES;
+    std::cout << "[ BENCHMARK] depth " << DEPTH << " lookups " << lookups << " by name "
+              << std::chrono::duration_cast<std::chrono::microseconds>(byName).count() << "us"
+              << " by atom "
+              << std::chrono::duration_cast<std::chrono::microseconds>(byAtom).count() << "us"
+              << std::endl;
+}
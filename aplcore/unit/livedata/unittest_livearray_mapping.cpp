@@ -0,0 +1,278 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <functional>
+#include <random>
+
+#include "../testeventloop.h"
+#include "apl/livedata/livearraymapping.h"
+#include "apl/livedata/livearrayobject.h"
+
+namespace apl {
+
+/**
+ * The original mapping: walk the change list backwards for every index.
+ */
+static std::pair<int, bool>
+referenceNewToOld(const std::vector<LiveArrayChange>& changes, size_t index)
+{
+    bool changed = false;
+    for (auto it = changes.rbegin(); it != changes.rend(); it++) {
+        auto position = it->position();
+        auto count = it->count();
+        switch (it->command()) {
+            case LiveArrayChange::REMOVE:
+                if (index >= position)
+                    index += count;
+                break;
+            case LiveArrayChange::UPDATE:
+                if (index >= position && index < position + count)
+                    changed = true;
+                break;
+            case LiveArrayChange::INSERT:
+                if (index >= position + count)
+                    index -= count;
+                else if (index >= position)
+                    return {-1, false};
+                break;
+            default:
+                break;
+        }
+    }
+    return {static_cast<int>(index), changed};
+}
+
+/**
+ * Generate a random, valid sequence of changes against an array of the given size.
+ * @return The final size of the array.
+ */
+static size_t
+randomChanges(std::mt19937& rng, size_t size, int count, std::vector<LiveArrayChange>& changes,
+              int maxRun = 5)
+{
+    for (int i = 0; i < count; i++) {
+        auto command = rng() % 3;
+        auto run = 1 + rng() % maxRun;
+        if (command == 0 || size == 0) {
+            auto position = rng() % (size + 1);
+            changes.emplace_back(LiveArrayChange::insert(position, run));
+            size += run;
+        } else {
+            auto position = rng() % size;
+            run = std::min<size_t>(run, size - position);
+            if (command == 1) {
+                changes.emplace_back(LiveArrayChange::remove(position, run));
+                size -= run;
+            } else {
+                changes.emplace_back(LiveArrayChange::update(position, run));
+            }
+        }
+    }
+    return size;
+}
+
+::testing::AssertionResult
+MatchesReference(const std::vector<LiveArrayChange>& changes, size_t size)
+{
+    LiveArrayMapping mapping;
+    mapping.build(changes, size);
+    for (size_t i = 0; i < size; i++) {
+        auto expected = referenceNewToOld(changes, i);
+        auto actual = mapping.newToOld(i);
+        if (expected != actual)
+            return ::testing::AssertionFailure()
+                   << "Mismatch at index " << i << " expected=(" << expected.first << "," << expected.second
+                   << ") actual=(" << actual.first << "," << actual.second << ")";
+    }
+    return ::testing::AssertionSuccess();
+}
+
+TEST(LiveArrayMappingTest, Basic)
+{
+    // ['a', 'b', 'c', 'd'] -> insert 'e' at 1, remove index 3, update index 2 -> ['a', 'e', 'k', 'd']
+    std::vector<LiveArrayChange> changes = {
+        LiveArrayChange::insert(1, 1),
+        LiveArrayChange::remove(3, 1),
+        LiveArrayChange::update(2, 1),
+    };
+
+    LiveArrayMapping mapping;
+    mapping.build(changes, 4);
+    ASSERT_EQ(4, mapping.oldSize());
+    ASSERT_EQ(std::make_pair(0, false), mapping.newToOld(0));
+    ASSERT_EQ(std::make_pair(-1, false), mapping.newToOld(1));
+    ASSERT_EQ(std::make_pair(1, true), mapping.newToOld(2));
+    ASSERT_EQ(std::make_pair(3, false), mapping.newToOld(3));
+}
+
+TEST(LiveArrayMappingTest, NoChanges)
+{
+    LiveArrayMapping mapping;
+    mapping.build({}, 10);
+    ASSERT_EQ(1, mapping.runCount());
+    for (int i = 0; i < 10; i++)
+        ASSERT_EQ(std::make_pair(i, false), mapping.newToOld(i));
+
+    mapping.build({}, 0);
+    ASSERT_EQ(0, mapping.runCount());
+}
+
+TEST(LiveArrayMappingTest, FromEmpty)
+{
+    std::vector<LiveArrayChange> changes = {
+        LiveArrayChange::insert(0, 3),
+        LiveArrayChange::update(1, 1),
+        LiveArrayChange::insert(3, 2),
+    };
+
+    LiveArrayMapping mapping;
+    mapping.build(changes, 5);
+    ASSERT_EQ(0, mapping.oldSize());
+    ASSERT_EQ(1, mapping.runCount());
+    ASSERT_TRUE(MatchesReference(changes, 5));
+}
+
+TEST(LiveArrayMappingTest, RemoveEverything)
+{
+    std::vector<LiveArrayChange> changes = {
+        LiveArrayChange::remove(0, 6),
+        LiveArrayChange::insert(0, 2),
+    };
+
+    LiveArrayMapping mapping;
+    mapping.build(changes, 2);
+    ASSERT_EQ(6, mapping.oldSize());
+    ASSERT_EQ(std::make_pair(-1, false), mapping.newToOld(0));
+    ASSERT_EQ(std::make_pair(-1, false), mapping.newToOld(1));
+}
+
+TEST(LiveArrayMappingTest, AdjacentRunsMerge)
+{
+    // Appending one item at a time collapses into a single inserted run
+    std::vector<LiveArrayChange> changes;
+    for (int i = 0; i < 20; i++)
+        changes.emplace_back(LiveArrayChange::insert(10 + i, 1));
+
+    LiveArrayMapping mapping;
+    mapping.build(changes, 30);
+    ASSERT_EQ(2, mapping.runCount());
+    ASSERT_TRUE(MatchesReference(changes, 30));
+}
+
+TEST(LiveArrayMappingTest, RandomizedMatchesReference)
+{
+    std::mt19937 rng(42);
+    for (int trial = 0; trial < 500; trial++) {
+        std::vector<LiveArrayChange> changes;
+        auto size = randomChanges(rng, rng() % 40, 1 + rng() % 30, changes);
+        ASSERT_TRUE(MatchesReference(changes, size)) << "trial=" << trial;
+    }
+}
+
+TEST(LiveArrayMappingTest, LiveArrayObject)
+{
+    // The compacted mapping is rebuilt whenever the array changes again before a flush
+    auto myArray = LiveArray::create(ObjectArray{"a", "b", "c", "d"});
+    auto context = Context::createTestContext(Metrics(), RootConfig());
+    auto object = LiveDataObject::create(myArray, context, "TestArray")->asArray();
+
+    myArray->insert(1, "e");
+    ASSERT_EQ(std::make_pair(-1, false), object->newToOld(1));
+    ASSERT_EQ(std::make_pair(1, false), object->newToOld(2));
+
+    myArray->update(2, "k");
+    ASSERT_EQ(std::make_pair(1, true), object->newToOld(2));
+
+    myArray->remove(0);
+    ASSERT_EQ(std::make_pair(-1, false), object->newToOld(0));
+    ASSERT_EQ(std::make_pair(1, true), object->newToOld(1));
+    ASSERT_EQ(std::make_pair(3, false), object->newToOld(3));
+}
+
+/**
+ * Map every index of a 5000 item array after a batch of changes, with both the compacted mapping
+ * and the original per-index scan of the change list.
+ */
+TEST(LiveArrayMappingTest, Benchmark)
+{
+    const size_t SIZE = 5000;
+    const int CHANGES = 50;
+    const int REPEAT = 5;
+
+    struct Pattern {
+        const char *name;
+        std::function<size_t(std::mt19937&, std::vector<LiveArrayChange>&)> generate;
+    };
+
+    std::vector<Pattern> patterns = {
+        {"insert", [&](std::mt19937& rng, std::vector<LiveArrayChange>& changes) {
+             size_t size = SIZE;
+             for (int i = 0; i < CHANGES; i++, size++)
+                 changes.emplace_back(LiveArrayChange::insert(rng() % (size + 1), 1));
+             return size;
+         }},
+        {"remove", [&](std::mt19937& rng, std::vector<LiveArrayChange>& changes) {
+             size_t size = SIZE;
+             for (int i = 0; i < CHANGES; i++, size--)
+                 changes.emplace_back(LiveArrayChange::remove(rng() % size, 1));
+             return size;
+         }},
+        {"update", [&](std::mt19937& rng, std::vector<LiveArrayChange>& changes) {
+             for (int i = 0; i < CHANGES; i++)
+                 changes.emplace_back(LiveArrayChange::update(rng() % SIZE, 1));
+             return SIZE;
+         }},
+        {"mixed", [&](std::mt19937& rng, std::vector<LiveArrayChange>& changes) {
+             return randomChanges(rng, SIZE, CHANGES, changes, 1);
+         }},
+    };
+
+    for (const auto& pattern : patterns) {
+        std::mt19937 rng(7);
+        std::vector<LiveArrayChange> changes;
+        auto size = pattern.generate(rng, changes);
+
+        long checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEAT; r++)
+            for (size_t i = 0; i < size; i++)
+                checksum += referenceNewToOld(changes, i).first;
+        auto reference = std::chrono::steady_clock::now() - start;
+
+        long mappedChecksum = 0;
+        size_t runs = 0;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEAT; r++) {
+            LiveArrayMapping mapping;
+            mapping.build(changes, size);
+            runs = mapping.runCount();
+            for (size_t i = 0; i < size; i++)
+                mappedChecksum += mapping.newToOld(i).first;
+        }
+        auto mapped = std::chrono::steady_clock::now() - start;
+
+        ASSERT_EQ(checksum, mappedChecksum) << pattern.name;
+        ASSERT_TRUE(MatchesReference(changes, size)) << pattern.name;
+
+        std::cout << "[ BENCHMARK] " << pattern.name << " items " << size << " changes " << CHANGES
+                  << " runs " << runs
+                  << " scan " << std::chrono::duration_cast<std::chrono::microseconds>(reference).count() / REPEAT << "us"
+                  << " mapping " << std::chrono::duration_cast<std::chrono::microseconds>(mapped).count() / REPEAT << "us"
+                  << std::endl;
+    }
+}
+
+} // namespace apl
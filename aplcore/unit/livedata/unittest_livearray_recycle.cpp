@@ -0,0 +1,201 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include "../testeventloop.h"
+
+namespace apl {
+
+class LiveArrayRecycleTest : public DocumentWrapper {
+public:
+    void load(const char *document, ObjectArray&& data) {
+        array = LiveArray::create(std::move(data));
+        config->liveData("TestArray", array);
+        loadDocument(document);
+    }
+
+    LiveArrayPtr array;
+};
+
+static const char *RECYCLING_SEQUENCE = R"({
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Sequence",
+      "height": 200,
+      "-recycleItems": true,
+      "data": "${TestArray}",
+      "items": [
+        { "when": "${data % 2 == 0}", "type": "Text", "text": "even ${data} ${index}" },
+        { "type": "Container", "items": { "type": "Text", "text": "odd ${data} ${index}" } }
+      ]
+    }
+  }
+})";
+
+TEST_F(LiveArrayRecycleTest, ReusesRemovedChild)
+{
+    load(RECYCLING_SEQUENCE, ObjectArray{0, 1, 2, 3});
+    ASSERT_TRUE(component);
+    ASSERT_EQ(4, component->getChildCount());
+
+    auto first = component->getChildAt(0);
+    ASSERT_EQ("even 0 0", first->getCalculated(kPropertyText).asString());
+
+    array->remove(0);
+    root->clearPending();
+    ASSERT_EQ(3, component->getChildCount());
+    ASSERT_FALSE(first->getParent());
+
+    // An even value selects the same "item", so the removed Text is rebound instead of rebuilt
+    array->push_back(4);
+    root->clearPending();
+    ASSERT_EQ(4, component->getChildCount());
+    ASSERT_EQ(first, component->getChildAt(3));
+    ASSERT_EQ(component, first->getParent());
+    ASSERT_EQ("even 4 3", first->getCalculated(kPropertyText).asString());
+    ASSERT_FALSE(first->getCalculated(kPropertyBounds).get<Rect>().empty());
+
+    // The remaining children were re-indexed in place
+    ASSERT_EQ("odd 1 0", component->getChildAt(0)->getChildAt(0)->getCalculated(kPropertyText).asString());
+}
+
+TEST_F(LiveArrayRecycleTest, DifferentItemIsBuilt)
+{
+    load(RECYCLING_SEQUENCE, ObjectArray{0, 1, 2, 3});
+    ASSERT_TRUE(component);
+
+    auto first = component->getChildAt(0);
+    array->remove(0);
+    root->clearPending();
+
+    // An odd value selects the Container, so a new child is built
+    array->push_back(5);
+    root->clearPending();
+    ASSERT_EQ(4, component->getChildCount());
+    ASSERT_NE(first, component->getChildAt(3));
+    ASSERT_EQ(kComponentTypeContainer, component->getChildAt(3)->getType());
+    ASSERT_EQ("odd 5 0", component->getChildAt(3)->getChildAt(0)->getCalculated(kPropertyText).asString());
+}
+
+static const char *PLAIN_SEQUENCE = R"({
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Sequence",
+      "height": 200,
+      "data": "${TestArray}",
+      "items": [
+        { "when": "${data % 2 == 0}", "type": "Text", "text": "even ${data} ${index}" },
+        { "type": "Container", "items": { "type": "Text", "text": "odd ${data} ${index}" } }
+      ]
+    }
+  }
+})";
+
+TEST_F(LiveArrayRecycleTest, OffByDefault)
+{
+    load(PLAIN_SEQUENCE, ObjectArray{0, 1, 2, 3});
+    ASSERT_TRUE(component);
+
+    auto first = component->getChildAt(0);
+    array->remove(0);
+    root->clearPending();
+    array->push_back(4);
+    root->clearPending();
+
+    ASSERT_NE(first, component->getChildAt(3));
+    ASSERT_EQ("even 4 3", component->getChildAt(3)->getCalculated(kPropertyText).asString());
+}
+
+static const char *RECYCLING_PAGER = R"({
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Pager",
+      "width": 200,
+      "height": 200,
+      "-recycleItems": true,
+      "data": "${TestArray}",
+      "item": { "type": "Frame", "item": { "type": "Text", "text": "page ${data}" } }
+    }
+  }
+})";
+
+TEST_F(LiveArrayRecycleTest, Pager)
+{
+    load(RECYCLING_PAGER, ObjectArray{"A", "B", "C"});
+    ASSERT_TRUE(component);
+    ASSERT_EQ(3, component->getChildCount());
+
+    auto last = component->getChildAt(2);
+    array->remove(2);
+    root->clearPending();
+    array->insert(0, "Z");
+    root->clearPending();
+
+    ASSERT_EQ(3, component->getChildCount());
+    ASSERT_EQ(last, component->getChildAt(0));
+}
+
+/**
+ * Simulate a chat feed: drop the oldest entries and append new ones, with and without recycling.
+ */
+TEST_F(LiveArrayRecycleTest, FeedBenchmark)
+{
+    const int ITEMS = 100;
+    const int BATCH = 10;
+    const int ROUNDS = 100;
+
+    long long elapsed[2];
+    const char *documents[2] = {PLAIN_SEQUENCE, RECYCLING_SEQUENCE};
+
+    for (int recycle = 0; recycle < 2; recycle++) {
+        ObjectArray data;
+        for (int i = 0; i < ITEMS; i++)
+            data.emplace_back(i);
+
+        config = RootConfig::create();
+        config->set(RootProperty::kAgentName, "Unit tests")
+            .timeManager(loop)
+            .measure(std::make_shared<MyTestMeasurement>(10));
+        load(documents[recycle], std::move(data));
+        ASSERT_TRUE(component);
+
+        int next = ITEMS;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < ROUNDS; round++) {
+            array->remove(0, BATCH);
+            for (int i = 0; i < BATCH; i++)
+                array->push_back(next++);
+            root->clearPending();
+        }
+        elapsed[recycle] = std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now() - start).count();
+
+        ASSERT_EQ(ITEMS, component->getChildCount());
+    }
+
+    std::cout << "[ BENCHMARK] items " << ITEMS << " batch " << BATCH << " rounds " << ROUNDS
+              << " rebuild " << elapsed[0] / ROUNDS << "us"
+              << " recycle " << elapsed[1] / ROUNDS << "us"
+              << std::endl;
+}
+
+} // namespace apl
@@ -0,0 +1,196 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include "../testeventloop.h"
+
+namespace apl {
+
+class LiveArrayVirtualizationTest : public DocumentWrapper {
+public:
+    void load(int items, double window) {
+        if (!array) {
+            ObjectArray data;
+            for (int i = 0; i < items; i++)
+                data.emplace_back(i);
+            array = LiveArray::create(std::move(data));
+            config->liveData("TestArray", array);
+        }
+        config->set(RootProperty::kSequenceVirtualizationWindow, window);
+        loadDocument(VIRTUAL_SEQUENCE);
+    }
+
+    void scrollTo(float position) {
+        component->update(kUpdateScrollPosition, position);
+        advanceTime(10);
+        root->clearPending();
+    }
+
+    /**
+     * @return The number of components in the hierarchy under (and including) the given component
+     */
+    static size_t resident(const ComponentPtr& c) {
+        size_t result = 1;
+        for (size_t i = 0; i < c->getChildCount(); i++)
+            result += resident(c->getChildAt(i));
+        return result;
+    }
+
+    /**
+     * @return The number of sequence children that have their subtree inflated
+     */
+    size_t inflated() {
+        size_t result = 0;
+        for (size_t i = 0; i < component->getChildCount(); i++)
+            if (component->getChildAt(i)->getChildCount() > 0)
+                result++;
+        return result;
+    }
+
+    LiveArrayPtr array;
+
+    static const char *VIRTUAL_SEQUENCE;
+};
+
+const char *LiveArrayVirtualizationTest::VIRTUAL_SEQUENCE = R"({
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Sequence",
+      "height": 100,
+      "data": "${TestArray}",
+      "item": {
+        "type": "Container",
+        "height": 20,
+        "items": [
+          { "type": "Text", "text": "Item ${data}" },
+          { "type": "Frame", "width": 10, "height": 10 }
+        ]
+      }
+    }
+  }
+})";
+
+TEST_F(LiveArrayVirtualizationTest, DisabledByDefault)
+{
+    load(200, 0);
+    ASSERT_TRUE(component);
+    ASSERT_FALSE(CoreComponent::cast(component)->virtualizesChildren());
+
+    for (float position = 0; position <= 3000; position += 100)
+        scrollTo(position);
+
+    // Nothing seen so far has been released
+    ASSERT_EQ(2, component->getChildAt(0)->getChildCount());
+}
+
+TEST_F(LiveArrayVirtualizationTest, ReleasesChildrenOutsideWindow)
+{
+    load(200, 1);
+    ASSERT_TRUE(component);
+    ASSERT_TRUE(CoreComponent::cast(component)->virtualizesChildren());
+    ASSERT_EQ(200, component->getChildCount());
+
+    auto firstBounds = component->getChildAt(0)->getCalculated(kPropertyBounds).get<Rect>();
+    ASSERT_EQ(2, component->getChildAt(0)->getChildCount());
+
+    for (float position = 0; position <= 2000; position += 100)
+        scrollTo(position);
+
+    // The first child has been released but still holds its place
+    auto first = component->getChildAt(0);
+    ASSERT_EQ(0, first->getChildCount());
+    ASSERT_EQ(firstBounds, first->getCalculated(kPropertyBounds).get<Rect>());
+
+    // Children around the viewport (items 100-104) are inflated
+    for (int i = 100; i < 105; i++)
+        ASSERT_EQ(2, component->getChildAt(i)->getChildCount()) << i;
+
+    // The window spans one page either side of the viewport, so about 15 children stay inflated
+    ASSERT_GE(20, inflated());
+
+    // Scrolling back inflates the first child again
+    for (float position = 2000; position >= 0; position -= 100)
+        scrollTo(position);
+
+    first = component->getChildAt(0);
+    ASSERT_EQ(2, first->getChildCount());
+    ASSERT_EQ(firstBounds, first->getCalculated(kPropertyBounds).get<Rect>());
+    ASSERT_EQ("Item 0", first->getChildAt(0)->getCalculated(kPropertyText).asString());
+    ASSERT_EQ(0, component->getChildAt(100)->getChildCount());
+}
+
+TEST_F(LiveArrayVirtualizationTest, LiveArrayChangesWhileDeflated)
+{
+    load(100, 1);
+    ASSERT_TRUE(component);
+
+    for (float position = 0; position <= 1000; position += 100)
+        scrollTo(position);
+    ASSERT_EQ(0, component->getChildAt(0)->getChildCount());
+
+    // Update a released item, then bring it back into view
+    array->update(0, "changed");
+    root->clearPending();
+
+    for (float position = 1000; position >= 0; position -= 100)
+        scrollTo(position);
+
+    auto first = component->getChildAt(0);
+    ASSERT_EQ(2, first->getChildCount());
+    ASSERT_EQ("Item changed", first->getChildAt(0)->getCalculated(kPropertyText).asString());
+}
+
+/**
+ * Scroll page by page through a 5000 item list with and without a virtualization window and report
+ * the peak number of resident components and the time spent.
+ */
+TEST_F(LiveArrayVirtualizationTest, ScrollBenchmark)
+{
+    const int ITEMS = 5000;
+    const float END = 20000;  // 1000 items in
+
+    size_t peak[2] = {0, 0};
+    long long elapsed[2] = {0, 0};
+    long long inflate[2] = {0, 0};
+
+    for (int virtualized = 0; virtualized < 2; virtualized++) {
+        auto start = std::chrono::steady_clock::now();
+        load(ITEMS, virtualized ? 1 : 0);
+        ASSERT_TRUE(component);
+        inflate[virtualized] = std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (float position = 0; position <= END; position += 100) {
+            scrollTo(position);
+            peak[virtualized] = std::max(peak[virtualized], resident(component));
+        }
+        elapsed[virtualized] = std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - start).count();
+    }
+
+    ASSERT_LT(peak[1], peak[0]);
+
+    std::cout << "[ BENCHMARK] items " << ITEMS << " scrolled " << END
+              << " resident " << peak[0] << " -> " << peak[1]
+              << " inflate " << inflate[0] << "us -> " << inflate[1] << "us"
+              << " scroll " << elapsed[0] << "us -> " << elapsed[1] << "us"
+              << std::endl;
+}
+
+} // namespace apl
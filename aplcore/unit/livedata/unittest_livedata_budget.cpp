@@ -0,0 +1,171 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "../testeventloop.h"
+
+namespace apl {
+
+class LiveDataBudgetTest : public DocumentWrapper {
+public:
+    void load() {
+        config->liveData("ArrayA", arrayA);
+        config->liveData("ArrayB", arrayB);
+        config->liveData("ArrayC", arrayC);
+        loadDocument(BUDGET_DOC);
+    }
+
+    /**
+     * @return The number of lists that have picked up the pushed item.
+     */
+    int updatedLists() {
+        int result = 0;
+        for (const auto& id : {"A", "B", "C"})
+            if (root->findComponentById(id)->getChildCount() == 2)
+                result++;
+        return result;
+    }
+
+    void pushAll() {
+        arrayA->push_back("A2");
+        arrayB->push_back("B2");
+        arrayC->push_back("C2");
+    }
+
+    LiveArrayPtr arrayA = LiveArray::create(ObjectArray{"A1"});
+    LiveArrayPtr arrayB = LiveArray::create(ObjectArray{"B1"});
+    LiveArrayPtr arrayC = LiveArray::create(ObjectArray{"C1"});
+
+    static const char *BUDGET_DOC;
+};
+
+const char *LiveDataBudgetTest::BUDGET_DOC = R"({
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Container",
+      "items": [
+        { "type": "Container", "id": "A", "data": "${ArrayA}", "item": { "type": "Text", "text": "${data}" } },
+        { "type": "Container", "id": "B", "data": "${ArrayB}", "item": { "type": "Text", "text": "${data}" } },
+        { "type": "Container", "id": "C", "data": "${ArrayC}", "item": { "type": "Text", "text": "${data}" } }
+      ]
+    }
+  }
+})";
+
+TEST_F(LiveDataBudgetTest, ZeroBudgetFlushesOneObjectPerCall)
+{
+    load();
+    ASSERT_TRUE(component);
+    ASSERT_EQ(0, updatedLists());
+
+    pushAll();
+
+    ASSERT_TRUE(root->clearPending(0));
+    ASSERT_EQ(1, root->getClearPendingStats().flushed);
+    ASSERT_EQ(2, root->getClearPendingStats().deferred);
+    ASSERT_EQ(1, updatedLists());
+
+    // The implicit clearPending calls do not pick up deferred work
+    ASSERT_TRUE(root->isDirty());
+    ASSERT_FALSE(root->hasEvent());
+    ASSERT_EQ(1, updatedLists());
+
+    ASSERT_TRUE(root->clearPending(0));
+    ASSERT_EQ(1, root->getClearPendingStats().deferred);
+    ASSERT_EQ(2, updatedLists());
+
+    ASSERT_FALSE(root->clearPending(0));
+    ASSERT_EQ(1, root->getClearPendingStats().flushed);
+    ASSERT_EQ(0, root->getClearPendingStats().deferred);
+    ASSERT_EQ(3, updatedLists());
+}
+
+TEST_F(LiveDataBudgetTest, AppliedChangesAreLaidOut)
+{
+    load();
+    ASSERT_TRUE(component);
+    root->clearDirty();
+
+    arrayA->push_back("A2");
+    arrayB->push_back("B2");
+
+    ASSERT_TRUE(root->clearPending(0));
+
+    // Whichever list was updated has been laid out and reported as dirty
+    auto updated = root->findComponentById("A");
+    if (updated->getChildCount() != 2)
+        updated = root->findComponentById("B");
+    ASSERT_EQ(2, updated->getChildCount());
+    ASSERT_FALSE(updated->getChildAt(1)->getCalculated(kPropertyBounds).get<Rect>().empty());
+    ASSERT_TRUE(root->isDirty());
+    ASSERT_EQ(1, root->getDirty().count(updated));
+}
+
+TEST_F(LiveDataBudgetTest, ExplicitClearPendingAppliesDeferred)
+{
+    load();
+    ASSERT_TRUE(component);
+
+    pushAll();
+    ASSERT_TRUE(root->clearPending(0));
+    ASSERT_EQ(1, updatedLists());
+
+    root->clearPending();
+    ASSERT_EQ(3, updatedLists());
+
+    // Nothing is left for the next budgeted call
+    ASSERT_FALSE(root->clearPending(0));
+    ASSERT_EQ(0, root->getClearPendingStats().flushed);
+    ASSERT_EQ(0, root->getClearPendingStats().deferred);
+}
+
+TEST_F(LiveDataBudgetTest, LargeBudgetFlushesEverything)
+{
+    load();
+    ASSERT_TRUE(component);
+
+    pushAll();
+    ASSERT_FALSE(root->clearPending(1000000));
+    ASSERT_EQ(3, root->getClearPendingStats().flushed);
+    ASSERT_EQ(0, root->getClearPendingStats().deferred);
+    ASSERT_LE(0, root->getClearPendingStats().elapsed);
+    ASSERT_EQ(3, updatedLists());
+}
+
+TEST_F(LiveDataBudgetTest, RepeatedChangeToDeferredObject)
+{
+    load();
+    ASSERT_TRUE(component);
+
+    pushAll();
+    ASSERT_TRUE(root->clearPending(0));
+
+    // Changing a deferred array again leaves a single pending flush for it
+    arrayA->push_back("A3");
+    arrayB->push_back("B3");
+    arrayC->push_back("C3");
+
+    size_t calls = 1;
+    while (root->clearPending(0))
+        calls++;
+
+    ASSERT_LE(3, calls);
+    ASSERT_EQ(3, root->findComponentById("A")->getChildCount());
+    ASSERT_EQ(3, root->findComponentById("B")->getChildCount());
+    ASSERT_EQ(3, root->findComponentById("C")->getChildCount());
+}
+
+} // namespace apl
@@ -33,6 +33,7 @@
 #include "apl/livedata/livemapobject.h"
 #include "apl/primitives/gradient.h"
 #include "apl/primitives/object.h"
+#include "apl/primitives/radii.h"
 #include "apl/primitives/rect.h"
 #include "apl/primitives/transform.h"
 #include "apl/utils/session.h"
@@ -1087,3 +1088,44 @@ TEST(ObjectTest, Equality)
         ASSERT_EQ(m.result, m.first == m.second) << "'" << m.first << "' : " << m.second;
     }
 }
+
+TEST(ObjectTest, InlineStorage)
+{
+    auto rect = Object(Rect(1, 2, 3, 4));
+    auto radii = Object(Radii(1, 2, 3, 4));
+    auto transform = Object(Transform2D::translate(10, 20));
+
+    // Copies are independent values
+    auto copy = rect;
+    ASSERT_TRUE(copy.is<Rect>());
+    ASSERT_EQ(Rect(1, 2, 3, 4), copy.get<Rect>());
+    ASSERT_EQ(rect, copy);
+    ASSERT_NE(&rect.get<Rect>(), &copy.get<Rect>());
+
+    // Assignment across storage types
+    copy = radii;
+    ASSERT_TRUE(copy.is<Radii>());
+    ASSERT_EQ(Radii(1, 2, 3, 4), copy.get<Radii>());
+    copy = Object("a string");
+    ASSERT_TRUE(copy.isString());
+    copy = std::move(transform);
+    ASSERT_TRUE(copy.is<Transform2D>());
+    ASSERT_EQ(Transform2D::translate(10, 20), copy.get<Transform2D>());
+    copy = Object::NULL_OBJECT();
+    ASSERT_TRUE(copy.isNull());
+
+    // Object methods are forwarded to the inline value
+    ASSERT_TRUE(rect.truthy());
+    ASSERT_FALSE(Object(Radii()).truthy());
+    ASSERT_TRUE(Object(Radii()).empty());
+    ASSERT_NE(Object(Rect(1, 2, 3, 4)), Object(Rect(1, 2, 3, 5)));
+    ASSERT_NE(rect, radii);
+    ASSERT_EQ(Rect(1, 2, 3, 4).toDebugString(), rect.toDebugString());
+
+    rapidjson::Document doc;
+    ASSERT_EQ(4, rect.serialize(doc.GetAllocator()).Size());
+
+    // Construction from an lvalue
+    const Rect r(5, 6, 7, 8);
+    ASSERT_EQ(r, Object(r).get<Rect>());
+}
@@ -0,0 +1,129 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+
+#include "../testeventloop.h"
+
+#include "apl/primitives/color.h"
+#include "apl/primitives/dimension.h"
+#include "apl/primitives/object.h"
+#include "apl/primitives/radii.h"
+#include "apl/primitives/rect.h"
+#include "apl/primitives/transform2d.h"
+
+using namespace apl;
+
+namespace {
+
+const int ITERATIONS = 100000;
+
+struct ObjectSample {
+    const char *name;
+    std::function<Object()> factory;
+};
+
+/**
+ * Run an operation ITERATIONS times.
+ * @return Average nanoseconds per operation
+ */
+template<class F>
+double
+timeOperation(F&& operation)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++)
+        operation();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return static_cast<double>(elapsed.count()) / ITERATIONS;
+}
+
+} // namespace
+
+/**
+ * Micro-benchmarks for the basic Object operations over the value types that show up most
+ * often in component properties.  Values stored in place (numbers, strings that fit the small
+ * string buffer, dimensions, colors, rects, radii and transforms) should not allocate when
+ * constructed or copied; the array sample is the heap-backed reference point.
+ */
+TEST(ObjectBenchmark, Operations)
+{
+    std::vector<ObjectSample> samples = {
+        {"number", []() { return Object(42.5); }},
+        {"short string", []() { return Object("label"); }},
+        {"long string", []() { return Object("a string that is too long for the small string buffer"); }},
+        {"dimension", []() { return Object(Dimension(DimensionType::Relative, 50)); }},
+        {"color", []() { return Object(Color(0xff0000ff)); }},
+        {"rect", []() { return Object(Rect(0, 0, 100, 50)); }},
+        {"radii", []() { return Object(Radii(4)); }},
+        {"transform", []() { return Object(Transform2D::translate(4, 5)); }},
+        {"small array", []() { return Object(ObjectArray{1, 2, 3}); }},
+    };
+
+    for (const auto& sample : samples) {
+        auto value = sample.factory();
+        auto other = sample.factory();
+        ASSERT_EQ(value, other) << sample.name;
+
+        size_t sink = 0;
+        auto construct = timeOperation([&]() { sink += sample.factory().isNull(); });
+        auto copy = timeOperation([&]() { Object copy(value); sink += copy.isNull(); });
+        auto assign = timeOperation([&]() { other = value; });
+        auto compare = timeOperation([&]() { sink += (value == other); });
+        auto hash = timeOperation([&]() { sink += value.hash(); });
+        auto number = timeOperation([&]() { sink += std::isnan(value.asNumber()); });
+
+        ASSERT_NE(0, sink);  // Keep the operations from being optimized away
+        std::cout << "[ BENCHMARK] " << std::left << std::setw(13) << sample.name << std::fixed
+                  << std::setprecision(1)
+                  << " construct " << construct << "ns"
+                  << " copy " << copy << "ns"
+                  << " assign " << assign << "ns"
+                  << " compare " << compare << "ns"
+                  << " hash " << hash << "ns"
+                  << " asNumber " << number << "ns"
+                  << std::endl;
+    }
+}
+
+/**
+ * Copying a component property map is dominated by the per-value copy cost
+ */
+TEST(ObjectBenchmark, PropertyMapCopy)
+{
+    ObjectMap properties = {
+        {"bounds", Object(Rect(0, 0, 100, 50))},
+        {"innerBounds", Object(Rect(2, 2, 96, 46))},
+        {"borderRadii", Object(Radii(4))},
+        {"transform", Object(Transform2D())},
+        {"width", Object(Dimension(100))},
+        {"height", Object(Dimension(DimensionType::Relative, 50))},
+        {"color", Object(Color(0xff0000ff))},
+        {"text", Object("label")},
+        {"opacity", Object(1.0)},
+    };
+
+    size_t sink = 0;
+    auto elapsed = timeOperation([&]() {
+        ObjectMap copy(properties);
+        sink += copy.size();
+    });
+
+    ASSERT_EQ(ITERATIONS * properties.size(), sink);
+    std::cout << "[ BENCHMARK] property map of " << properties.size() << " values copy "
+              << std::fixed << std::setprecision(1) << elapsed << "ns" << std::endl;
+}
@@ -0,0 +1,259 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include "../testeventloop.h"
+
+#include "apl/scenegraph/builder.h"
+#include "apl/scenegraph/scenegraph.h"
+#include "apl/scenegraph/scenegraphupdates.h"
+
+using namespace apl;
+
+class SGPoolTest : public DocumentWrapper {
+public:
+    std::string serialize() {
+        rapidjson::Document doc;
+        auto sg = root->getSceneGraph();
+        auto value = sg->serialize(doc.GetAllocator());
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        value.Accept(writer);
+        return buffer.GetString();
+    }
+};
+
+TEST_F(SGPoolTest, Updates)
+{
+    auto a = sg::layer("a", Rect(0, 0, 10, 10), 1.0, Transform2D());
+    auto b = sg::layer("b", Rect(0, 0, 10, 10), 1.0, Transform2D());
+    auto c = sg::layer("c", Rect(0, 0, 10, 10), 1.0, Transform2D());
+
+    sg::SceneGraphUpdates updates;
+    ASSERT_TRUE(updates.empty());
+
+    // Layers without flags are not recorded
+    updates.changed(a);
+    ASSERT_TRUE(updates.empty());
+
+    a->setOpacity(0.5);
+    b->setOpacity(0.5);
+    c->setOpacity(0.5);
+    updates.changed(a);
+    updates.changed(b);
+    updates.changed(a);
+    updates.created(b);   // Created after being changed
+    updates.created(c);
+    updates.changed(c);   // Changed after being created
+    ASSERT_FALSE(updates.empty());
+
+    std::vector<sg::LayerPtr> changed;
+    updates.mapChanged([&](const sg::LayerPtr& layer) { changed.emplace_back(layer); });
+    ASSERT_EQ(std::vector<sg::LayerPtr>({a}), changed);
+
+    updates.fixCreatedFlags();
+    ASSERT_TRUE(a->anyFlagSet());
+    ASSERT_FALSE(b->anyFlagSet());
+    ASSERT_FALSE(c->anyFlagSet());
+
+    updates.clear();
+    ASSERT_TRUE(updates.empty());
+    ASSERT_FALSE(a->anyFlagSet());
+}
+
+TEST_F(SGPoolTest, BuilderScope)
+{
+    auto pool = std::make_shared<ObjectPool>();
+    auto outer = std::make_shared<ObjectPool>();
+
+    {
+        sg::BuilderPoolScope scope(outer);
+        auto path = sg::path(Rect(0, 0, 10, 10));
+        ASSERT_EQ(1, outer->getStats().allocations);
+
+        {
+            sg::BuilderPoolScope inner(pool);
+            auto node = sg::draw(sg::path(Rect(0, 0, 10, 10)), sg::fill(sg::paint(Color(Color::RED))));
+            ASSERT_EQ(4, pool->getStats().allocations);
+        }
+
+        // Back to the outer pool; everything built in the inner scope has been released
+        ASSERT_EQ(0, pool->getStats().bytesInUse);
+        auto paint = sg::paint(Color(Color::BLUE));
+        ASSERT_EQ(2, outer->getStats().allocations);
+    }
+
+    // No scope: the heap is used
+    auto layer = sg::layer("a", Rect(0, 0, 10, 10), 1.0, Transform2D());
+    ASSERT_EQ(2, outer->getStats().allocations);
+    ASSERT_EQ(0, outer->getStats().bytesInUse);
+}
+
+static const char *CHANGING = R"apl(
+{
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Container",
+      "width": 400,
+      "height": 400,
+      "items": [
+        {
+          "type": "Frame",
+          "id": "FRAME",
+          "width": 100,
+          "height": 100,
+          "backgroundColor": "red",
+          "borderWidth": 2,
+          "borderColor": "blue",
+          "shadowColor": "black",
+          "shadowRadius": 4
+        },
+        {
+          "type": "Text",
+          "text": "Hello"
+        }
+      ]
+    }
+  }
+}
+)apl";
+
+TEST_F(SGPoolTest, PooledMatchesHeap)
+{
+    loadDocument(CHANGING);
+    auto expected = serialize();
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "backgroundColor"}, {"value", "green"}}, true);
+    auto expectedChanged = serialize();
+    ASSERT_FALSE(root->getSceneGraph()->getObjectPool());
+
+    config->enableExperimentalFeature(RootConfig::kExperimentalFeatureSceneGraphPool);
+    loadDocument(CHANGING);
+    ASSERT_EQ(expected, serialize());
+
+    auto pool = root->getSceneGraph()->getObjectPool();
+    ASSERT_TRUE(pool);
+    auto initial = pool->getStats().allocations;
+    ASSERT_LT(0, initial);
+
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "backgroundColor"}, {"value", "green"}}, true);
+    ASSERT_EQ(expectedChanged, serialize());
+    ASSERT_LT(initial, pool->getStats().allocations);
+
+    // Changing it again reuses the blocks released by the first change
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "backgroundColor"}, {"value", "red"}}, true);
+    root->getSceneGraph();
+    ASSERT_LT(0, pool->getStats().reused);
+}
+
+static const char *ANIMATED = R"apl(
+{
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Container",
+      "width": 1000,
+      "height": 1000,
+      "direction": "row",
+      "wrap": "wrap",
+      "data": "${Array.range(COUNT)}",
+      "items": {
+        "type": "Frame",
+        "width": 40,
+        "height": 40,
+        "backgroundColor": "${index % 2 ? 'green' : 'blue'}",
+        "borderRadius": 4,
+        "onMount": {
+          "type": "AnimateItem",
+          "duration": 1000,
+          "repeatCount": 100,
+          "value": [
+            { "property": "opacity", "from": 0.2, "to": 1 },
+            { "property": "transform", "from": [ { "rotate": 0 } ], "to": [ { "rotate": 90 } ] }
+          ]
+        }
+      }
+    }
+  }
+}
+)apl";
+
+/**
+ * Animate opacity and transform on 500 layers and compare the frame cost with and without the
+ * scene graph pool.  With the pool, report how many scene graph objects are allocated per frame
+ * and whether the pool had to reserve new memory from the heap during the animation.
+ */
+TEST_F(SGPoolTest, AnimationBenchmark)
+{
+    const int COUNT = 500;
+    const int FRAMES = 100;
+
+    auto doc = std::string(ANIMATED);
+    doc.replace(doc.find("COUNT"), 5, std::to_string(COUNT));
+
+    for (auto pooled : {false, true}) {
+        if (pooled) {
+            // Releasing the first document terminates its time manager
+            component = nullptr;
+            context = nullptr;
+            rootDocument = nullptr;
+            root = nullptr;
+            loop = std::make_shared<TestTimeManager>();
+            config->timeManager(loop);
+            config->enableExperimentalFeature(RootConfig::kExperimentalFeatureSceneGraphPool);
+        }
+        loadDocument(doc.c_str());
+        ASSERT_TRUE(component);
+        auto sg = root->getSceneGraph();
+        ASSERT_EQ(pooled, sg->getObjectPool() != nullptr);
+
+        // Warm up so the update lists and pool reach their steady state
+        for (int i = 0; i < 10; i++) {
+            advanceTime(16);
+            root->getSceneGraph();
+        }
+
+        ObjectPool::Stats start;
+        if (pooled)
+            start = sg->getObjectPool()->getStats();
+
+        size_t changed = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < FRAMES; frame++) {
+            advanceTime(16);
+            root->getSceneGraph()->updates().mapChanged([&](const sg::LayerPtr&) { changed++; });
+        }
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin).count() / FRAMES;
+
+        ASSERT_LE(COUNT, changed / FRAMES);
+
+        std::cout << "[ BENCHMARK] " << COUNT << " animated layers" << (pooled ? " pooled" : " heap")
+                  << ": " << us << "us/frame, " << changed / FRAMES << " changed layers/frame";
+        if (pooled) {
+            auto& end = sg->getObjectPool()->getStats();
+            std::cout << ", " << (end.allocations - start.allocations) / FRAMES
+                      << " scene graph allocations/frame, "
+                      << end.reservedBytes - start.reservedBytes << " bytes reserved from the heap";
+        }
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,303 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include "../testeventloop.h"
+#include "test_sg.h"
+
+#include "apl/scenegraph/scenegraphstream.h"
+
+using namespace apl;
+
+class SGStreamTest : public DocumentWrapper {
+public:
+    /**
+     * Fetch the scene graph, encode it, decode it and check that the decoded tree matches.
+     */
+    ::testing::AssertionResult step() {
+        auto sg = root->getSceneGraph();
+        encoder.encode(*sg, buffer);
+        if (!decoder.decode(buffer.data(), buffer.size()))
+            return ::testing::AssertionFailure() << "Decode failed: " << decoder.error();
+
+        if (decoder.getLayerCount() != encoder.getLayerCount())
+            return ::testing::AssertionFailure() << "Layer count " << decoder.getLayerCount()
+                                                 << " expected " << encoder.getLayerCount();
+
+        if (!(decoder.getViewportSize() == sg->getViewportSize()))
+            return ::testing::AssertionFailure() << "Viewport size mismatch";
+
+        rapidjson::Document doc;
+        auto expected = sg->serialize(doc.GetAllocator());
+        auto actual = decoder.serialize(doc.GetAllocator());
+        if (expected != actual)
+            return ::testing::AssertionFailure() << "Expected " << toString(expected) << std::endl
+                                                 << "Actual   " << toString(actual);
+
+        return ::testing::AssertionSuccess();
+    }
+
+    static std::string toString(const rapidjson::Value& value) {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        value.Accept(writer);
+        return buffer.GetString();
+    }
+
+    sg::SceneGraphEncoder encoder;
+    sg::SceneGraphDecoder decoder;
+    std::string buffer;
+};
+
+static const char *ROUND_TRIP = R"apl(
+{
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Container",
+      "width": 400,
+      "height": 600,
+      "items": [
+        {
+          "type": "Frame",
+          "id": "FRAME",
+          "width": 100,
+          "height": 100,
+          "backgroundColor": "red",
+          "borderRadius": 10,
+          "borderWidth": 2,
+          "borderColor": "blue",
+          "shadowColor": "black",
+          "shadowRadius": 4,
+          "accessibilityLabel": "A frame"
+        },
+        {
+          "type": "Text",
+          "id": "TEXT",
+          "text": "Hello",
+          "width": 200,
+          "height": 50
+        },
+        {
+          "type": "Sequence",
+          "id": "SEQUENCE",
+          "width": 200,
+          "height": 200,
+          "data": "${Array.range(20)}",
+          "items": {
+            "type": "Frame",
+            "width": 200,
+            "height": 50,
+            "backgroundColor": "${index % 2 ? 'green' : 'yellow'}"
+          }
+        }
+      ]
+    }
+  }
+}
+)apl";
+
+TEST_F(SGStreamTest, RoundTrip)
+{
+    loadDocument(ROUND_TRIP);
+    ASSERT_TRUE(component);
+
+    ASSERT_TRUE(step());
+    auto layers = decoder.getLayerCount();
+    ASSERT_LT(5, layers);
+
+    // Nothing changed
+    ASSERT_TRUE(step());
+    ASSERT_EQ(28, buffer.size());
+
+    // Layer properties
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "opacity"}, {"value", 0.5}}, true);
+    ASSERT_TRUE(step());
+    ASSERT_LT(buffer.size(), 64);
+
+    executeCommand("SetValue", {{"componentId", "FRAME"},
+                                {"property", "transform"},
+                                {"value", JsonData(R"([{"rotate": 45}])").get()}}, true);
+    ASSERT_TRUE(step());
+
+    // Content
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "backgroundColor"}, {"value", "purple"}}, true);
+    ASSERT_TRUE(step());
+    executeCommand("SetValue", {{"componentId", "TEXT"}, {"property", "text"}, {"value", "Goodbye"}}, true);
+    ASSERT_TRUE(step());
+
+    // Accessibility
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "accessibilityLabel"}, {"value", "Changed"}}, true);
+    ASSERT_TRUE(step());
+
+    // Scrolling changes the child offset and brings new children into view
+    auto sequence = root->findComponentById("SEQUENCE");
+    sequence->update(kUpdateScrollPosition, 300);
+    root->clearPending();
+    ASSERT_TRUE(step());
+    ASSERT_LT(28, buffer.size());
+
+    // Removing a component from the display removes its layer
+    layers = decoder.getLayerCount();
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "display"}, {"value", "none"}}, true);
+    ASSERT_TRUE(step());
+    ASSERT_EQ(layers - 1, decoder.getLayerCount());
+
+    // ...and showing it again sends it in full
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "display"}, {"value", "normal"}}, true);
+    ASSERT_TRUE(step());
+    ASSERT_EQ(layers, decoder.getLayerCount());
+
+    // A reset resends everything
+    encoder.reset();
+    ASSERT_TRUE(step());
+    ASSERT_LT(64, buffer.size());
+    ASSERT_EQ(layers, decoder.getLayerCount());
+}
+
+TEST_F(SGStreamTest, NewDecoderNeedsReset)
+{
+    loadDocument(ROUND_TRIP);
+    ASSERT_TRUE(step());
+
+    executeCommand("SetValue", {{"componentId", "FRAME"}, {"property", "opacity"}, {"value", 0.5}}, true);
+    auto sg = root->getSceneGraph();
+    encoder.encode(*sg, buffer);
+
+    // A decoder that missed the first frame cannot apply a delta
+    sg::SceneGraphDecoder late;
+    ASSERT_FALSE(late.decode(buffer.data(), buffer.size()));
+    ASSERT_FALSE(late.error().empty());
+
+    late.reset();
+    encoder.reset();
+    encoder.encode(*sg, buffer);
+    ASSERT_TRUE(late.decode(buffer.data(), buffer.size()));
+    ASSERT_EQ(encoder.getLayerCount(), late.getLayerCount());
+}
+
+TEST_F(SGStreamTest, Malformed)
+{
+    loadDocument(ROUND_TRIP);
+    auto sg = root->getSceneGraph();
+    encoder.encode(*sg, buffer);
+
+    for (size_t length = 0; length < buffer.size(); length++) {
+        sg::SceneGraphDecoder truncated;
+        ASSERT_FALSE(truncated.decode(buffer.data(), length)) << length;
+        ASSERT_FALSE(truncated.error().empty());
+    }
+
+    auto version = buffer;
+    version[4] = 99;
+    ASSERT_FALSE(decoder.decode(version.data(), version.size()));
+
+    auto extended = buffer + "x";
+    ASSERT_FALSE(decoder.decode(extended.data(), extended.size()));
+
+    ASSERT_FALSE(decoder.decode("hello", 5));
+
+    decoder.reset();
+    ASSERT_TRUE(decoder.decode(buffer.data(), buffer.size()));
+}
+
+static const char *ANIMATED = R"apl(
+{
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "item": {
+      "type": "Container",
+      "width": 1000,
+      "height": 1000,
+      "direction": "row",
+      "wrap": "wrap",
+      "data": "${Array.range(COUNT)}",
+      "items": {
+        "type": "Frame",
+        "width": 40,
+        "height": 40,
+        "backgroundColor": "${index % 2 ? 'green' : 'blue'}",
+        "onMount": {
+          "type": "AnimateItem",
+          "duration": 1000,
+          "repeatCount": 100,
+          "value": [
+            { "property": "opacity", "from": 0.2, "to": 1 },
+            { "property": "transform", "from": [ { "translateX": 0 } ], "to": [ { "translateX": 100 } ] }
+          ]
+        },
+        "item": { "type": "Text", "text": "${index}" }
+      }
+    }
+  }
+}
+)apl";
+
+/**
+ * Animate a large tree and compare the per-frame cost and size of the binary delta stream against
+ * serializing the complete scene graph as JSON.
+ */
+TEST_F(SGStreamTest, RoundTripBenchmark)
+{
+    const int COUNT = 300;
+    const int FRAMES = 60;
+
+    auto doc = std::string(ANIMATED);
+    doc.replace(doc.find("COUNT"), 5, std::to_string(COUNT));
+    loadDocument(doc.c_str());
+    ASSERT_TRUE(component);
+    ASSERT_TRUE(step());
+    auto fullSize = buffer.size();
+
+    size_t deltaBytes = 0;
+    size_t jsonBytes = 0;
+    std::chrono::steady_clock::duration streamTime{};
+    std::chrono::steady_clock::duration jsonTime{};
+
+    for (int frame = 0; frame < FRAMES; frame++) {
+        advanceTime(16);
+        auto sg = root->getSceneGraph();
+
+        auto start = std::chrono::steady_clock::now();
+        encoder.encode(*sg, buffer);
+        ASSERT_TRUE(decoder.decode(buffer.data(), buffer.size())) << decoder.error();
+        streamTime += std::chrono::steady_clock::now() - start;
+        deltaBytes += buffer.size();
+
+        start = std::chrono::steady_clock::now();
+        rapidjson::Document json;
+        auto value = sg->serialize(json.GetAllocator());
+        jsonBytes += toString(value).size();
+        jsonTime += std::chrono::steady_clock::now() - start;
+    }
+
+    // The decoded tree still matches after the whole animation
+    ASSERT_TRUE(step());
+
+    auto us = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d).count() / FRAMES;
+    };
+
+    std::cout << "[ BENCHMARK] " << decoder.getLayerCount() << " layers, full frame " << fullSize
+              << " bytes; per frame: delta encode+decode " << us(streamTime) << "us " << deltaBytes / FRAMES
+              << " bytes, JSON serialize " << us(jsonTime) << "us " << jsonBytes / FRAMES << " bytes"
+              << std::endl;
+}
@@ -13,6 +13,8 @@
  * permissions and limitations under the License.
  */
 
+#include <thread>
+
 #include "test_sg_textmeasure.h"
 #include "apl/scenegraph/textchunk.h"
 #include "apl/scenegraph/textproperties.h"
@@ -140,4 +142,44 @@ MyTestMeasurement::box(int size,
     return std::make_shared<MyTestBox>(Size(fixMeasuredDimension(cw * size, width, widthMode),
                                             fixMeasuredDimension(ch, height, heightMode)),
                                        ch * 0.8);
-}
\ No newline at end of file
+}
+
+sg::TextLayoutPtr
+SlowTestMeasurement::layout(const sg::TextChunkPtr& textChunk,
+                            const sg::TextPropertiesPtr& textProperties,
+                            float width,
+                            MeasureMode widthMode,
+                            float height,
+                            MeasureMode heightMode)
+{
+    // Simulate shaping work.  Spin rather than sleep so that the cost is CPU-bound.
+    auto end = std::chrono::steady_clock::now() + mCost;
+    while (std::chrono::steady_clock::now() < end)
+        ;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    return MyTestMeasurement::layout(textChunk, textProperties, width, widthMode, height, heightMode);
+}
+
+void
+SlowTestMeasurement::layoutBatch(std::vector<TextLayoutBatchEntry>& batch)
+{
+    mBatchedCounter += batch.size();
+
+    auto work = [&](size_t start) {
+        for (auto i = start; i < batch.size(); i += mThreads) {
+            auto& entry = batch.at(i);
+            const auto& request = entry.request;
+            entry.layout = layout(entry.chunk, entry.textProperties,
+                                  request.width(), request.widthMode(),
+                                  request.height(), request.heightMode());
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 1; i < mThreads; i++)
+        workers.emplace_back(work, i);
+    work(0);
+    for (auto& m : workers)
+        m.join();
+}
@@ -16,6 +16,9 @@
 #ifndef _APL_TEST_SG_TEXTMEASURE_H
 #define _APL_TEST_SG_TEXTMEASURE_H
 
+#include <chrono>
+#include <mutex>
+
 #include "gtest/gtest.h"
 #include "apl/component/component.h"
 #include "apl/component/componentproperties.h"
@@ -239,6 +242,36 @@ private:
     int mFontSizeOverride = 0;
 };
 
+/**
+ * Fake text measurement with an artificial cost per layout.  Batches are spread across a fixed number
+ * of worker threads so that the speedup of the text measurement pre-pass can be measured on a
+ * multi-core machine.
+ */
+class SlowTestMeasurement : public MyTestMeasurement {
+public:
+    SlowTestMeasurement(int fontSizeOverride, std::chrono::microseconds cost, unsigned int threads)
+        : MyTestMeasurement(fontSizeOverride), mCost(cost), mThreads(threads) {}
+
+    using MyTestMeasurement::layout;
+
+    sg::TextLayoutPtr layout(const sg::TextChunkPtr& textChunk,
+                             const sg::TextPropertiesPtr& textProperties, float width,
+                             MeasureMode widthMode, float height, MeasureMode heightMode) override;
+
+    void layoutBatch(std::vector<TextLayoutBatchEntry>& batch) override;
+
+    /**
+     * @return Number of layouts that were requested through a batch
+     */
+    int getBatchedCount() const { return mBatchedCounter; }
+
+private:
+    std::chrono::microseconds mCost;
+    unsigned int mThreads;
+    std::mutex mMutex;
+    int mBatchedCounter = 0;
+};
+
 /**
  * Mimics a viewhost that wants to store Layout objects in the Component UserData. This is a
  * demonstration of how viewhosts may want to behave while this API is available but scenegraph
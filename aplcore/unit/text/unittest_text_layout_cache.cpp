@@ -0,0 +1,146 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "../testeventloop.h"
+
+#include "apl/scenegraph/textlayoutcache.h"
+
+using namespace apl;
+
+class TextLayoutCacheTest : public DocumentWrapper {
+public:
+    static TextMeasureRequest request(float width) {
+        return {width, MeasureMode::Exactly, 100, MeasureMode::AtMost, 12345};
+    }
+
+    static sg::TextLayoutPtr layout() {
+        return std::make_shared<FixedTestTextLayout>(Size(100, 20), 16);
+    }
+};
+
+TEST_F(TextLayoutCacheTest, WeakOnly)
+{
+    sg::TextLayoutCache cache;
+    ASSERT_EQ(0, cache.getByteBudget());
+
+    auto a = layout();
+    cache.insert(request(10), a);
+    ASSERT_EQ(a, cache.find(request(10)));
+    ASSERT_EQ(0, cache.getStrongSize());
+
+    // Once the last reference is dropped the layout is gone
+    a.reset();
+    ASSERT_FALSE(cache.find(request(10)));
+    ASSERT_EQ(1, cache.getStats().hits);
+    ASSERT_EQ(1, cache.getStats().misses);
+}
+
+TEST_F(TextLayoutCacheTest, StrongTier)
+{
+    auto bytes = sg::TextLayoutCache::estimateBytes(*layout());
+    sg::TextLayoutCache cache(3 * bytes);
+
+    for (int i = 0; i < 3; i++)
+        cache.insert(request(i), layout());
+    ASSERT_EQ(3, cache.getStrongSize());
+    ASSERT_EQ(3 * bytes, cache.getBytes());
+
+    // The layouts survive without any outside references
+    ASSERT_TRUE(cache.find(request(0)));
+    ASSERT_EQ(1, cache.getStats().strongHits);
+
+    // Request 1 is now the least recently used and is evicted first
+    cache.insert(request(3), layout());
+    ASSERT_EQ(3, cache.getStrongSize());
+    ASSERT_EQ(1, cache.getStats().evictions);
+    ASSERT_EQ(bytes, cache.getStats().evictedBytes);
+    ASSERT_FALSE(cache.find(request(1)));
+    ASSERT_TRUE(cache.find(request(0)));
+    ASSERT_TRUE(cache.find(request(2)));
+
+    // Re-inserting a key does not double count it
+    cache.insert(request(2), layout());
+    ASSERT_EQ(3 * bytes, cache.getBytes());
+
+    cache.setByteBudget(bytes);
+    ASSERT_EQ(1, cache.getStrongSize());
+    ASSERT_EQ(bytes, cache.getBytes());
+    ASSERT_TRUE(cache.find(request(2)));
+
+    cache.setByteBudget(0);
+    ASSERT_EQ(0, cache.getStrongSize());
+    ASSERT_EQ(0, cache.getBytes());
+}
+
+static const char *SINGLE_TEXT = R"apl(
+{
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "items": {
+      "type": "Container",
+      "items": {
+        "type": "Text",
+        "id": "label",
+        "text": "First text"
+      }
+    }
+  }
+}
+)apl";
+
+TEST_F(TextLayoutCacheTest, RootConfigBudget)
+{
+    auto measure = std::make_shared<MyTestMeasurement>();
+    config->measure(measure);
+    config->set(RootProperty::kTextLayoutCacheBudget, 100000);
+    loadDocument(SINGLE_TEXT);
+    auto text = CoreComponent::cast(root->findComponentById("label"));
+    ASSERT_TRUE(text);
+
+    auto& cache = component->getContext()->textLayoutCache();
+    ASSERT_EQ(100000, cache.getByteBudget());
+    auto count = measure->getLayoutCount();
+    ASSERT_GT(count, 0);
+
+    text->setProperty(kPropertyText, "Second text");
+    root->clearPending();
+    ASSERT_GT(measure->getLayoutCount(), count);
+    count = measure->getLayoutCount();
+
+    // Switching back finds the first layout in the strong tier, even though the component released it
+    text->setProperty(kPropertyText, "First text");
+    root->clearPending();
+    ASSERT_EQ(count, measure->getLayoutCount());
+    ASSERT_GT(cache.getStats().strongHits, 0);
+}
+
+TEST_F(TextLayoutCacheTest, DefaultIsWeakOnly)
+{
+    auto measure = std::make_shared<MyTestMeasurement>();
+    config->measure(measure);
+    loadDocument(SINGLE_TEXT);
+    auto text = CoreComponent::cast(root->findComponentById("label"));
+    ASSERT_TRUE(text);
+    ASSERT_EQ(0, component->getContext()->textLayoutCache().getByteBudget());
+
+    text->setProperty(kPropertyText, "Second text");
+    root->clearPending();
+    auto count = measure->getLayoutCount();
+
+    text->setProperty(kPropertyText, "First text");
+    root->clearPending();
+    ASSERT_GT(measure->getLayoutCount(), count);
+}
@@ -0,0 +1,232 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <map>
+
+#include "../testeventloop.h"
+
+#include "apl/datagrammar/bytecode.h"
+#include "apl/engine/evaluate.h"
+#include "apl/utils/flatmap.h"
+
+using namespace apl;
+
+TEST(FlatMapTest, Basic)
+{
+    FlatMap<std::string, int> map;
+    ASSERT_TRUE(map.empty());
+
+    ASSERT_TRUE(map.emplace("b", 2).second);
+    ASSERT_TRUE(map.insert({"a", 1}).second);
+    ASSERT_TRUE(map.emplace("c", 3).second);
+    ASSERT_FALSE(map.emplace("b", 20).second);  // Existing keys are not replaced
+    ASSERT_EQ(3, map.size());
+    ASSERT_EQ(2, map.at("b"));
+
+    // Iteration is in key order
+    std::string keys;
+    for (const auto& m : map)
+        keys += m.first;
+    ASSERT_EQ("abc", keys);
+
+    ASSERT_EQ(1, map.count("a"));
+    ASSERT_EQ(0, map.count("z"));
+    ASSERT_EQ(map.end(), map.find("z"));
+    ASSERT_EQ(3, map.find("c")->second);
+
+    map["d"] = 4;
+    map["a"] = 10;
+    ASSERT_EQ(4, map.size());
+    ASSERT_EQ(10, map.at("a"));
+
+    ASSERT_EQ(1, map.erase("b"));
+    ASSERT_EQ(0, map.erase("b"));
+    auto it = map.erase(map.find("a"));
+    ASSERT_EQ("c", it->first);
+    ASSERT_EQ(2, map.size());
+
+    map.clear();
+    ASSERT_TRUE(map.empty());
+}
+
+TEST(FlatMapTest, RangeInsertKeepsFirst)
+{
+    FlatMap<std::string, int> map{{"m", 1}};
+
+    std::vector<std::pair<std::string, int>> items = {{"z", 1}, {"a", 1}, {"m", 2}, {"a", 2}, {"k", 1}};
+    map.insert(items.begin(), items.end());
+
+    ASSERT_EQ(4, map.size());
+    ASSERT_EQ(1, map.at("a"));  // First occurrence within the range wins
+    ASSERT_EQ(1, map.at("m"));  // Existing entries win
+    ASSERT_EQ("a", map.begin()->first);
+    ASSERT_EQ("z", map.rbegin()->first);
+}
+
+TEST(FlatMapTest, MatchesStdMap)
+{
+    std::map<std::string, int> reference;
+    FlatMap<std::string, int> map;
+
+    auto seed = 17u;
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        auto key = "key" + std::to_string((seed >> 8) % 500);
+        switch ((seed >> 4) % 4) {
+            case 0:
+                ASSERT_EQ(reference.emplace(key, i).second, map.emplace(key, i).second);
+                break;
+            case 1:
+                reference[key] = i;
+                map[key] = i;
+                break;
+            case 2:
+                ASSERT_EQ(reference.erase(key), map.erase(key));
+                break;
+            default:
+                ASSERT_EQ(reference.count(key), map.count(key));
+                break;
+        }
+    }
+
+    ASSERT_EQ(reference.size(), map.size());
+    ASSERT_TRUE(std::equal(reference.begin(), reference.end(), map.begin(),
+                           [](const std::pair<const std::string, int>& lhs, const std::pair<std::string, int>& rhs) {
+                               return lhs.first == rhs.first && lhs.second == rhs.second;
+                           }));
+}
+
+namespace {
+
+/**
+ * Build a JSON datasource of roughly one megabyte: a single object with many keyed records.
+ */
+std::string
+makeDatasource(int count)
+{
+    std::string result = "{";
+    for (int i = 0; i < count; i++) {
+        if (i)
+            result += ",";
+        result += "\"record" + std::to_string(i * 7919 % count) + "\": {\"id\": " + std::to_string(i) +
+                  ", \"title\": \"Record title number " + std::to_string(i) +
+                  "\", \"subtitle\": \"Some longer descriptive text for the record\", \"score\": " +
+                  std::to_string(i % 100) + "}";
+    }
+    return result + "}";
+}
+
+template<class Map>
+long long
+timeConversion(const rapidjson::Value& value, size_t& size)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::pair<std::string, Object>> members;
+    members.reserve(value.MemberCount());
+    for (const auto& v : value.GetObject())
+        members.emplace_back(v.name.GetString(), v.value);
+    Map map(std::make_move_iterator(members.begin()), std::make_move_iterator(members.end()));
+    size = map.size();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<class Map>
+long long
+timeLookup(const Map& map, const std::vector<std::string>& keys, int rounds, size_t& found)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++)
+        for (const auto& key : keys)
+            found += map.count(key);
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+TEST(FlatMapTest, ConversionBenchmark)
+{
+    const int RECORDS = 7000;
+    auto json = makeDatasource(RECORDS);
+    rapidjson::Document doc;
+    doc.Parse(json.c_str());
+    ASSERT_TRUE(doc.IsObject());
+
+    size_t treeSize = 0, flatSize = 0;
+    auto tree = timeConversion<std::map<std::string, Object>>(doc, treeSize);
+    auto flat = timeConversion<FlatMap<std::string, Object>>(doc, flatSize);
+    ASSERT_EQ(RECORDS, treeSize);
+    ASSERT_EQ(RECORDS, flatSize);
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < RECORDS; i += 7)
+        keys.emplace_back("record" + std::to_string(i));
+
+    std::map<std::string, Object> treeMap;
+    FlatMap<std::string, Object> flatMap;
+    for (const auto& v : doc.GetObject()) {
+        treeMap.emplace(v.name.GetString(), v.value);
+        flatMap.emplace(v.name.GetString(), v.value);
+    }
+
+    size_t treeFound = 0, flatFound = 0;
+    auto treeLookup = timeLookup(treeMap, keys, 20, treeFound);
+    auto flatLookup = timeLookup(flatMap, keys, 20, flatFound);
+    ASSERT_EQ(treeFound, flatFound);
+
+    std::cout << "[ BENCHMARK] " << json.size() / 1024 << "kB datasource, " << RECORDS << " keys"
+              << " convert std::map " << tree << "us flat " << flat << "us"
+              << " lookup std::map " << treeLookup << "us flat " << flatLookup << "us"
+              << std::endl;
+}
+
+class FlatMapDocumentTest : public DocumentWrapper {};
+
+TEST_F(FlatMapDocumentTest, AttributeAccessBenchmark)
+{
+    const int RECORDS = 7000;
+    const int ITERATIONS = 20000;
+    auto json = makeDatasource(RECORDS);
+    rapidjson::Document doc;
+    doc.Parse(json.c_str());
+
+    // Data-bound maps (bind values, LiveMaps, evaluated nested properties) are held as ObjectMaps
+    auto payload = std::make_shared<ObjectMap>();
+    for (const auto& v : doc.GetObject())
+        payload->emplace(v.name.GetString(), v.value);
+
+    context = Context::createTestContext(metrics, *config);
+    context->putConstant("payload", Object(payload));
+
+    auto start = std::chrono::steady_clock::now();
+    // Skip optimization so the constant payload lookups are not folded away
+    auto parsed = parseAndEvaluate(*context, "${payload.record3500.score + payload.record12.id + payload.record6999.score}", false);
+    auto byteCode = parsed.expression;
+    ASSERT_TRUE(byteCode.is<datagrammar::ByteCode>());
+
+    double sum = 0;
+    for (int i = 0; i < ITERATIONS; i++)
+        sum += byteCode.eval().asNumber();
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    ASSERT_LT(0, sum);
+#ifdef FLAT_OBJECT_MAP
+    const char *representation = "flat";
+#else
+    const char *representation = "std::map";
+#endif
+    std::cout << "[ BENCHMARK] attribute access (" << representation << " ObjectMap) "
+              << ITERATIONS << " evaluations " << elapsed << "us" << std::endl;
+}
@@ -58,4 +58,25 @@ TEST_F(LruCacheTest, KickOutAfterAccess)
     ASSERT_TRUE(cache.has(0));
     ASSERT_FALSE(cache.has(1));
     ASSERT_TRUE(cache.has(2));
-}
\ No newline at end of file
+}
+TEST_F(LruCacheTest, PutExisting)
+{
+    auto cache = LruCache<int, int>(2);
+    cache.put(0, 0);
+    cache.put(1, 1);
+    cache.put(0, 10);
+
+    ASSERT_EQ(2, cache.size());
+    ASSERT_EQ(10, cache.get(0));
+
+    // Key 1 is now the least recently used
+    auto removed = cache.popLeastRecent();
+    ASSERT_EQ(1, removed.first);
+    ASSERT_EQ(1, removed.second);
+    ASSERT_EQ(1, cache.size());
+    ASSERT_FALSE(cache.has(1));
+
+    cache.clear();
+    ASSERT_TRUE(cache.empty());
+    ASSERT_FALSE(cache.has(0));
+}
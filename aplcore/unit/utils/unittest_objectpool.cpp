@@ -0,0 +1,238 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <chrono>
+#include <fstream>
+
+#include "../testeventloop.h"
+
+#include "apl/utils/objectpool.h"
+
+using namespace apl;
+
+TEST(ObjectPoolTest, ReusesFreedBlocks)
+{
+    ObjectPool pool;
+
+    auto a = pool.allocate(24);
+    auto b = pool.allocate(24);
+    ASSERT_NE(a, b);
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(a) % ObjectPool::GRANULARITY);
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(b) % ObjectPool::GRANULARITY);
+
+    pool.deallocate(a, 24);
+    auto c = pool.allocate(20);  // Same size class
+    ASSERT_EQ(a, c);
+
+    auto& stats = pool.getStats();
+    ASSERT_EQ(3, stats.allocations);
+    ASSERT_EQ(1, stats.deallocations);
+    ASSERT_EQ(1, stats.reused);
+    ASSERT_EQ(2 * 32, stats.bytesInUse);
+    ASSERT_EQ(2 * 32, stats.peakBytesInUse);
+    ASSERT_EQ(ObjectPool::CHUNK_SIZE, stats.reservedBytes);
+
+    pool.deallocate(b, 24);
+    pool.deallocate(c, 20);
+    ASSERT_EQ(0, stats.bytesInUse);
+    ASSERT_EQ(2 * 32, stats.peakBytesInUse);
+}
+
+TEST(ObjectPoolTest, OversizedFallsBackToHeap)
+{
+    ObjectPool pool;
+
+    auto big = pool.allocate(ObjectPool::MAX_POOLED_SIZE + 1);
+    ASSERT_TRUE(big);
+    ASSERT_EQ(1, pool.getStats().oversized);
+    ASSERT_EQ(0, pool.getStats().allocations);
+    ASSERT_EQ(0, pool.getStats().reservedBytes);
+    pool.deallocate(big, ObjectPool::MAX_POOLED_SIZE + 1);
+}
+
+TEST(ObjectPoolTest, SpansChunks)
+{
+    ObjectPool pool;
+
+    std::vector<void *> blocks;
+    for (size_t i = 0; i < 3 * ObjectPool::CHUNK_SIZE / 200; i++)
+        blocks.push_back(pool.allocate(200));
+
+    ASSERT_LE(3 * ObjectPool::CHUNK_SIZE, pool.getStats().reservedBytes);
+    for (auto block : blocks)
+        pool.deallocate(block, 200);
+    ASSERT_EQ(0, pool.getStats().bytesInUse);
+}
+
+TEST(ObjectPoolTest, SharedObjectsOutliveOwner)
+{
+    auto pool = std::make_shared<ObjectPool>();
+    std::weak_ptr<ObjectPool> weak = pool;
+
+    auto value = makePooled<std::string>(pool, "a pooled string");
+    auto array = makePooled<ObjectArray>(pool, ObjectArray{1, 2, 3});
+    ASSERT_EQ(2, pool->getStats().allocations);
+
+    pool.reset();
+    ASSERT_FALSE(weak.expired());
+    ASSERT_EQ("a pooled string", *value);
+    ASSERT_EQ(3, array->size());
+
+    value.reset();
+    array.reset();
+    ASSERT_TRUE(weak.expired());
+}
+
+TEST(ObjectPoolTest, NoPoolUsesHeap)
+{
+    auto value = makePooled<std::string>(nullptr, "heap");
+    ASSERT_EQ("heap", *value);
+}
+
+class ObjectPoolDocumentTest : public DocumentWrapper {
+public:
+    /**
+     * @return The current and peak resident set size of the process in kB, or zero if unavailable
+     */
+    static std::pair<long, long> residentSetSize() {
+        long current = 0, peak = 0;
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmRSS:") == 0)
+                current = std::stol(line.substr(6));
+            else if (line.compare(0, 6, "VmHWM:") == 0)
+                peak = std::stol(line.substr(6));
+        }
+        return {current, peak};
+    }
+};
+
+static const char *DATA_BOUND_SEQUENCE = R"({
+  "type": "APL",
+  "version": "2023.2",
+  "mainTemplate": {
+    "parameters": [ "payload" ],
+    "item": {
+      "type": "Sequence",
+      "height": 400,
+      "data": "${payload.items}",
+      "items": {
+        "type": "Container",
+        "bind": [ { "name": "Label", "value": "Item ${data.id} of ${length}" } ],
+        "items": [
+          { "type": "Text", "text": "${Label}" },
+          { "type": "Text", "text": "${data.title}", "color": "${index % 2 ? 'red' : 'blue'}" }
+        ]
+      }
+    }
+  }
+})";
+
+static std::string
+makeItemsPayload(int count)
+{
+    std::string result = R"({"payload": {"items": [)";
+    for (int i = 0; i < count; i++) {
+        if (i)
+            result += ",";
+        result += R"({"id": )" + std::to_string(i) + R"(, "title": "Title )" + std::to_string(i) + R"("})";
+    }
+    return result + "]}}";
+}
+
+TEST_F(ObjectPoolDocumentTest, DisabledByDefault)
+{
+    auto payload = makeItemsPayload(10);
+    loadDocument(DATA_BOUND_SEQUENCE, payload.c_str());
+    ASSERT_TRUE(component);
+    ASSERT_FALSE(component->getContext()->objectPool());
+}
+
+TEST_F(ObjectPoolDocumentTest, InflationUsesPool)
+{
+    config->enableExperimentalFeature(RootConfig::kExperimentalFeaturePooledAllocation);
+    auto payload = makeItemsPayload(10);
+    loadDocument(DATA_BOUND_SEQUENCE, payload.c_str());
+    ASSERT_TRUE(component);
+    ASSERT_EQ(10, component->getChildCount());
+
+    auto pool = component->getContext()->objectPool();
+    ASSERT_TRUE(pool);
+    ASSERT_EQ(pool, component->getCoreChildAt(3)->getContext()->objectPool());
+
+    // Every child context and every data-bound property dependant comes from the pool
+    auto& stats = pool->getStats();
+    ASSERT_LT(40, stats.allocations);
+    ASSERT_LT(0, stats.bytesInUse);
+
+    // Data binding still works through pooled dependants
+    auto text = component->getCoreChildAt(3)->getCoreChildAt(0);
+    ASSERT_EQ("Item 3 of 10", text->getCalculated(kPropertyText).asString());
+
+    // Releasing the document returns everything to the pool
+    std::weak_ptr<ObjectPool> weak = pool;
+    pool.reset();
+    text = nullptr;
+    component = nullptr;
+    rootDocument = nullptr;
+    context = nullptr;
+    root = nullptr;
+    ASSERT_TRUE(weak.expired());
+}
+
+TEST_F(ObjectPoolDocumentTest, Benchmark)
+{
+    const int ITEMS = 2000;
+    auto payload = makeItemsPayload(ITEMS);
+
+    for (int pooled = 0; pooled < 2; pooled++) {
+        config = RootConfig::create();
+        config->set(RootProperty::kAgentName, "Unit tests")
+            .timeManager(loop)
+            .measure(std::make_shared<MyTestMeasurement>(10));
+        if (pooled)
+            config->enableExperimentalFeature(RootConfig::kExperimentalFeaturePooledAllocation);
+
+        auto before = residentSetSize();
+        auto start = std::chrono::steady_clock::now();
+        loadDocument(DATA_BOUND_SEQUENCE, payload.c_str());
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start).count();
+        auto after = residentSetSize();
+
+        ASSERT_TRUE(component);
+        ASSERT_EQ(ITEMS, component->getChildCount());
+
+        std::cout << "[ BENCHMARK] items " << ITEMS << (pooled ? " pooled" : " heap")
+                  << " inflate " << elapsed << "us"
+                  << " rss " << before.first << "kB -> " << after.first << "kB"
+                  << " peak " << before.second << "kB -> " << after.second << "kB";
+        if (pooled) {
+            auto& stats = component->getContext()->objectPool()->getStats();
+            std::cout << " allocations " << stats.allocations
+                      << " reused " << stats.reused
+                      << " oversized " << stats.oversized
+                      << " in use " << stats.bytesInUse
+                      << " peak " << stats.peakBytesInUse
+                      << " reserved " << stats.reservedBytes;
+        }
+        std::cout << std::endl;
+
+        component = nullptr;
+        rootDocument = nullptr;
+        root = nullptr;
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "apl/utils/spatialindex.h"
+
+using namespace apl;
+
+static std::vector<size_t>
+findAt(const SpatialIndex& index, const Point& point)
+{
+    std::vector<size_t> result;
+    index.reverseFindAt(point, [&](size_t i) {
+        result.push_back(i);
+        return true;
+    });
+    return result;
+}
+
+TEST(SpatialIndexTest, Empty)
+{
+    SpatialIndex index;
+    ASSERT_EQ(0, index.size());
+    ASSERT_TRUE(findAt(index, Point(0, 0)).empty());
+
+    std::vector<size_t> result = {1, 2, 3};
+    index.findIntersecting(Rect(0, 0, 100, 100), result);
+    ASSERT_TRUE(result.empty());
+
+    // Only empty rectangles
+    index.build({Rect(), Rect(10, 10, 0, 0)});
+    ASSERT_EQ(2, index.size());
+    ASSERT_TRUE(findAt(index, Point(10, 10)).empty());
+    index.findIntersecting(Rect(0, 0, 100, 100), result);
+    ASSERT_TRUE(result.empty());
+}
+
+TEST(SpatialIndexTest, Basic)
+{
+    SpatialIndex index;
+    index.build({
+        Rect(0, 0, 100, 100),     // 0
+        Rect(50, 50, 100, 100),   // 1
+        Rect(200, 0, 50, 50),     // 2
+        Rect(0, 0, 0, 0),         // 3: empty
+        Rect(60, 60, 10, 10),     // 4
+    });
+
+    ASSERT_EQ(std::vector<size_t>({4, 1, 0}), findAt(index, Point(65, 65)));
+    ASSERT_EQ(std::vector<size_t>({0}), findAt(index, Point(10, 10)));
+    ASSERT_EQ(std::vector<size_t>({2}), findAt(index, Point(250, 50)));  // Edges are inclusive
+    ASSERT_TRUE(findAt(index, Point(175, 25)).empty());
+    ASSERT_TRUE(findAt(index, Point(-1, 0)).empty());
+
+    // Stop early
+    std::vector<size_t> result;
+    index.reverseFindAt(Point(65, 65), [&](size_t i) {
+        result.push_back(i);
+        return false;
+    });
+    ASSERT_EQ(std::vector<size_t>({4}), result);
+
+    index.findIntersecting(Rect(90, 0, 120, 55), result);
+    ASSERT_EQ(std::vector<size_t>({0, 1, 2}), result);
+
+    index.findIntersecting(Rect(100, 0, 100, 40), result);  // Touching edges do not intersect
+    ASSERT_TRUE(result.empty());
+
+    index.clear();
+    ASSERT_EQ(0, index.size());
+    ASSERT_TRUE(findAt(index, Point(65, 65)).empty());
+}
+
+/**
+ * Compare against a brute-force search using a mix of small and large rectangles.
+ */
+TEST(SpatialIndexTest, MatchesBruteForce)
+{
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> position(-100, 1000);
+    std::uniform_real_distribution<float> smallSize(0, 40);
+    std::uniform_real_distribution<float> largeSize(0, 800);
+
+    std::vector<Rect> boxes;
+    for (int i = 0; i < 500; i++) {
+        auto& size = (i % 10 == 0) ? largeSize : smallSize;
+        boxes.emplace_back(position(gen), position(gen), size(gen), size(gen));
+    }
+
+    SpatialIndex index;
+    index.build(std::vector<Rect>(boxes));
+
+    for (int i = 0; i < 500; i++) {
+        auto point = Point(position(gen), position(gen));
+        std::vector<size_t> expected;
+        for (size_t j = boxes.size(); j-- > 0;)
+            if (boxes[j].contains(point))
+                expected.push_back(j);
+        ASSERT_EQ(expected, findAt(index, point)) << i;
+
+        auto region = Rect(position(gen), position(gen), largeSize(gen), smallSize(gen));
+        expected.clear();
+        for (size_t j = 0; j < boxes.size(); j++)
+            if (!region.intersect(boxes[j]).empty())
+                expected.push_back(j);
+
+        std::vector<size_t> actual;
+        index.findIntersecting(region, actual);
+        ASSERT_EQ(expected, actual) << i;
+    }
+}
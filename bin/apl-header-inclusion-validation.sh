@@ -34,6 +34,7 @@ public_apl_headers=(
     "apl/content/aplversion.h"
     "apl/content/configurationchange.h"
     "apl/content/content.h"
+    "apl/content/contentstream.h"
     "apl/content/documentconfig.h"
     "apl/content/extensioncommanddefinition.h"
     "apl/content/extensioncomponentdefinition.h"
@@ -46,7 +47,9 @@ public_apl_headers=(
     "apl/content/jsondata.h"
     "apl/content/metrics.h"
     "apl/content/package.h"
+    "apl/content/packagecache.h"
     "apl/content/packagemanager.h"
+    "apl/content/packedjson.h"
     "apl/content/rootconfig.h"
     "apl/content/rootproperties.h"
     "apl/content/settings.h"
@@ -61,11 +64,13 @@ public_apl_headers=(
     "apl/document/displaystate.h"
     "apl/document/documentcontext.h"
     "apl/document/documentproperties.h"
+    "apl/document/visualcontextdelta.h"
     "apl/dynamicdata.h"
     "apl/embed/documentmanager.h"
     "apl/embed/embedrequest.h"
     "apl/engine/binding.h"
     "apl/engine/dependant.h"
+    "apl/engine/dirtypropertybuffer.h"
     "apl/engine/event.h"
     "apl/engine/info.h"
     "apl/engine/jsonresource.h"
@@ -78,6 +83,7 @@ public_apl_headers=(
     "apl/engine/styledefinition.h"
     "apl/engine/styleinstance.h"
     "apl/engine/styles.h"
+    "apl/engine/symboltable.h"
     "apl/engine/uid.h"
     "apl/engine/uidobject.h"
     "apl/extension/extensionclient.h"
@@ -137,6 +143,7 @@ public_apl_headers=(
     "apl/scenegraph/path.h"
     "apl/scenegraph/pathop.h"
     "apl/scenegraph/scenegraph.h"
+    "apl/scenegraph/scenegraphstream.h"
     "apl/scenegraph/scenegraphupdates.h"
     "apl/scenegraph/shadow.h"
     "apl/scenegraph/textchunk.h"
@@ -150,11 +157,13 @@ public_apl_headers=(
     "apl/utils/dataurl.h"
     "apl/utils/deprecated.h"
     "apl/utils/flags.h"
+    "apl/utils/flatmap.h"
     "apl/utils/localemethods.h"
     "apl/utils/log.h"
     "apl/utils/noncopyable.h"
     "apl/utils/path.h"
     "apl/utils/session.h"
+    "apl/utils/spatialindex.h"
     "apl/utils/streamer.h"
     "apl/utils/stringfunctions.h"
     "apl/utils/throw.h"
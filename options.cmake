@@ -34,6 +34,8 @@ option(BUILD_ALEXAEXTENSIONS "Build Alexa Extensions library as part of the proj
 
 option(ENABLE_SCENEGRAPH "Build and enable Scene Graph support" OFF)
 
+option(FLAT_OBJECT_MAP "Store ObjectMap as a sorted vector instead of a std::map" OFF)
+
 
 # Enumgen is only built by default for certain platforms
 if (NOT APPLE)
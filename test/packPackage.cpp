@@ -0,0 +1,72 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+/*
+ * Convert a JSON APL package to the pre-compiled binary package format
+ */
+
+#include "apl/content/packedjson.h"
+#include "apl/content/sharedjsondata.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+const char usage_string[] = "packPackage [-h|--help] INPUT.json OUTPUT";
+
+int
+main(int argc, char *argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    if (args.size() != 2 || args[0] == "-h" || args[0] == "--help") {
+        std::cout << usage_string << std::endl;
+        exit(1);
+    }
+
+    std::ifstream input(args[0], std::ios::binary);
+    if (!input.is_open()) {
+        std::cerr << "Unable to open " << args[0] << std::endl;
+        exit(1);
+    }
+
+    std::stringstream buffer;
+    buffer << input.rdbuf();
+    auto json = apl::SharedJsonData(buffer.str());
+    if (!json) {
+        std::cerr << args[0] << ": parse error offset=" << json.offset() << ": " << json.error() << std::endl;
+        exit(1);
+    }
+
+    auto packed = apl::PackedJson::pack(json.get());
+
+    // Check that the output reads back as the same document before writing it
+    auto copy = packed;
+    auto check = apl::PackedJson::unpack(std::move(copy));
+    if (!check || check.get() != json.get()) {
+        std::cerr << "Packed package does not match the input: " << check.error() << std::endl;
+        exit(1);
+    }
+
+    std::ofstream output(args[1], std::ios::binary | std::ios::trunc);
+    output.write(packed.data(), static_cast<std::streamsize>(packed.size()));
+    if (!output) {
+        std::cerr << "Unable to write " << args[1] << std::endl;
+        exit(1);
+    }
+
+    std::cout << args[0] << " (" << buffer.str().size() << " bytes) -> "
+              << args[1] << " (" << packed.size() << " bytes)" << std::endl;
+}